@@ -11,10 +11,19 @@
 #include "aroma_font.h"
 #include "aroma_logger.h"
 #include "aroma_node.h"
+#include "aroma_alloc_profile.h"
 #include "aroma_slab_alloc.h"
 #include "aroma_style.h"
 #include "aroma_time.h"
 #include "aroma_timer.h"
+#include "aroma_animation.h"
+#include "aroma_idle.h"
+#include "aroma_asset.h"
+#include "aroma_task.h"
+#include "aroma_post.h"
+#include "aroma_frame_arena.h"
+#include "aroma_string.h"
+#include "aroma_memory.h"
 #include "aroma_drawlist.h"
 #include "aroma_ui.h"
 #include "aroma_widgets.h"
@@ -0,0 +1,96 @@
+#ifndef AROMA_ALLOC_PROFILE_H
+#define AROMA_ALLOC_PROFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Opt-in allocation profiler. Build with AROMA_ALLOC_PROFILE defined (the
+ * CMake option of the same name) and aroma_widget_alloc / __slab_pool_alloc
+ * record their caller's file and line plus the node type the memory ends up
+ * in. Without the define none of this exists and the tag macro is empty.
+ */
+#ifdef AROMA_ALLOC_PROFILE
+
+#ifndef AROMA_ALLOC_PROFILE_MAX_SITES
+#define AROMA_ALLOC_PROFILE_MAX_SITES 128
+#endif
+/* Live allocations tracked at once; must be a power of two. */
+#ifndef AROMA_ALLOC_PROFILE_MAX_LIVE
+#define AROMA_ALLOC_PROFILE_MAX_LIVE 4096
+#endif
+/* Node types plus one slot for memory never attached to a node. */
+#define AROMA_ALLOC_PROFILE_TYPE_COUNT 4
+#define AROMA_ALLOC_PROFILE_UNTAGGED (AROMA_ALLOC_PROFILE_TYPE_COUNT - 1)
+
+typedef struct AromaAllocSiteStats {
+    const char* file;
+    int line;
+    size_t allocs;
+    size_t frees;
+    size_t live_count;
+    size_t live_bytes;
+    size_t peak_live_bytes;
+    size_t total_bytes;
+} AromaAllocSiteStats;
+
+typedef struct AromaAllocTypeStats {
+    size_t live_count;
+    size_t live_bytes;
+    size_t peak_live_bytes;
+} AromaAllocTypeStats;
+
+typedef enum AromaAllocProfileSort {
+    AROMA_ALLOC_SORT_LIVE_BYTES,
+    AROMA_ALLOC_SORT_TOTAL_BYTES,
+    AROMA_ALLOC_SORT_ALLOCS
+} AromaAllocProfileSort;
+
+typedef struct AromaAllocSnapshot {
+    size_t site_count;
+    AromaAllocSiteStats sites[AROMA_ALLOC_PROFILE_MAX_SITES];
+    AromaAllocTypeStats types[AROMA_ALLOC_PROFILE_TYPE_COUNT];
+} AromaAllocSnapshot;
+
+typedef struct AromaAllocSiteDelta {
+    const char* file;
+    int line;
+    long long live_count;
+    long long live_bytes;
+    size_t allocs;
+    size_t frees;
+} AromaAllocSiteDelta;
+
+void aroma_alloc_profile_record_alloc(void* ptr, size_t size, const char* file, int line);
+void aroma_alloc_profile_record_free(void* ptr);
+/* Moves a live allocation's bytes from "untagged" to an AromaNodeType. */
+void aroma_alloc_profile_tag(void* ptr, int node_type);
+void aroma_alloc_profile_reset(void);
+
+/* Copies up to `max` sites sorted by `sort`, largest first. */
+size_t aroma_alloc_profile_get_sites(AromaAllocSiteStats* out, size_t max, AromaAllocProfileSort sort);
+AromaAllocTypeStats aroma_alloc_profile_get_type(int node_type);
+/* Allocations that could not be tracked because the live table was full. */
+size_t aroma_alloc_profile_untracked(void);
+void aroma_alloc_profile_report(AromaAllocProfileSort sort, size_t max_sites);
+
+void aroma_alloc_profile_snapshot(AromaAllocSnapshot* snapshot);
+/* Sites whose live memory changed between two snapshots, biggest change first. */
+size_t aroma_alloc_profile_diff(const AromaAllocSnapshot* before, const AromaAllocSnapshot* after,
+                                AromaAllocSiteDelta* out, size_t max);
+void aroma_alloc_profile_report_diff(const AromaAllocSnapshot* before, const AromaAllocSnapshot* after);
+
+#define AROMA_ALLOC_PROFILE_TAG(ptr, node_type) aroma_alloc_profile_tag((ptr), (int)(node_type))
+
+#else
+
+#define AROMA_ALLOC_PROFILE_TAG(ptr, node_type) ((void)0)
+
+#endif
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,59 @@
+#ifndef AROMA_ANIMATION_H
+#define AROMA_ANIMATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "aroma_common.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_MAX_ANIMATIONS 32
+
+typedef struct AromaNode AromaNode;
+typedef struct AromaAnimation AromaAnimation;
+typedef struct AromaSceneArena AromaSceneArena;
+
+typedef enum AromaEasing {
+    AROMA_EASE_LINEAR,
+    AROMA_EASE_IN_QUAD,
+    AROMA_EASE_OUT_QUAD,
+    AROMA_EASE_IN_OUT_QUAD,
+    AROMA_EASE_OUT_CUBIC,
+    AROMA_EASE_IN_OUT_CUBIC
+} AromaEasing;
+
+typedef void (*AromaAnimationDoneCallback)(AromaNode* node, void* user_data);
+
+void aroma_animation_init(void);
+void aroma_animation_shutdown(void);
+
+/*
+ * Tween a widget property towards `to`. `damage` is the area repainted on
+ * every step; pass a zero-sized rect to invalidate the whole node instead.
+ * Starting a new animation on the same property retargets it from its
+ * current value. A zero duration applies the value immediately.
+ */
+AromaAnimation* aroma_animate_int(AromaNode* node, AromaRect damage, int* value, int to,
+                                  uint32_t duration_ms, AromaEasing easing);
+AromaAnimation* aroma_animate_float(AromaNode* node, AromaRect damage, float* value, float to,
+                                    uint32_t duration_ms, AromaEasing easing);
+AromaAnimation* aroma_animate_color(AromaNode* node, AromaRect damage, uint32_t* value, uint32_t to,
+                                    uint32_t duration_ms, AromaEasing easing);
+
+void aroma_animation_set_on_done(AromaAnimation* anim, AromaAnimationDoneCallback cb, void* user_data);
+void aroma_animation_cancel(AromaAnimation* anim);
+void aroma_animation_cancel_node(AromaNode* node);
+/* Cancels the animations of every node carved from `arena`. */
+void aroma_animation_cancel_scene(const AromaSceneArena* arena);
+
+/* Advances every running animation to the frame clock `now_ms`.
+   Returns true while at least one animation still needs frames. */
+bool aroma_animation_tick(uint64_t now_ms);
+bool aroma_animation_is_running(void);
+uint32_t aroma_animation_active_count(void);
+
+float aroma_easing_apply(AromaEasing easing, float t);
+#ifdef __cplusplus
+}
+#endif
+#endif
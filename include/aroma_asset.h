@@ -0,0 +1,50 @@
+#ifndef AROMA_ASSET_H
+#define AROMA_ASSET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_MAX_ASSETS 16
+#define AROMA_ASSET_CHUNK_SIZE 4096
+
+typedef enum AromaAssetState {
+    AROMA_ASSET_FREE,
+    AROMA_ASSET_PENDING,
+    AROMA_ASSET_READY,
+    AROMA_ASSET_FAILED
+} AromaAssetState;
+
+typedef struct AromaAsset AromaAsset;
+
+void aroma_asset_init(void);
+void aroma_asset_shutdown(void);
+
+/*
+ * Reads a file into memory in AROMA_ASSET_CHUNK_SIZE slices from idle time,
+ * so large assets never stall a frame. Returns NULL if no handle is free.
+ */
+AromaAsset* aroma_asset_load_async(const char* path);
+
+/*
+ * Handles for work finished elsewhere (decoders, network replies). Complete
+ * them on the UI thread; `data` must come from malloc and is owned by the
+ * handle afterwards.
+ */
+AromaAsset* aroma_asset_create_pending(void);
+void aroma_asset_complete(AromaAsset* asset, void* data, size_t size);
+void aroma_asset_fail(AromaAsset* asset);
+
+AromaAssetState aroma_asset_state(const AromaAsset* asset);
+bool aroma_asset_is_pending(const AromaAsset* asset);
+/* Loaded file contents are NUL-terminated for convenience; size excludes it. */
+const void* aroma_asset_data(const AromaAsset* asset, size_t* out_size);
+
+/* Frees the data; an in-flight load is abandoned. */
+void aroma_asset_release(AromaAsset* asset);
+#ifdef __cplusplus
+}
+#endif
+#endif
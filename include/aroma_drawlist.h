@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include "aroma_string.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -11,6 +12,8 @@ typedef struct AromaFont AromaFont;
 typedef struct AromaNode AromaNode;
 
 typedef struct AromaDrawList AromaDrawList;
+typedef struct AromaFrameArena AromaFrameArena;
+typedef struct AromaGraphicsInterface AromaGraphicsInterface;
 
 typedef struct AromaDrawTask {
     AromaNode* node;
@@ -24,15 +27,55 @@ typedef enum AromaDrawCmdType {
     AROMA_DRAW_CMD_HOLLOW_RECT,
     AROMA_DRAW_CMD_ARC,
     AROMA_DRAW_CMD_TEXT,
-    AROMA_DRAW_CMD_IMAGE
+    AROMA_DRAW_CMD_IMAGE,
+    AROMA_DRAW_CMD_CLIP
 } AromaDrawCmdType;
 
+typedef struct AromaDrawListStats {
+    size_t count;
+    size_t peak_count;
+    size_t bytes;        /* packed command stream in use */
+    size_t peak_bytes;
+    size_t capacity;     /* bytes reserved for the command stream */
+    size_t heap_allocs;  /* command stream growths plus text arena chunks */
+    size_t flush_calls;  /* backend calls issued by the last replay */
+    size_t occluded;         /* commands dropped by the last occlusion pass */
+    size_t occluded_pixels;  /* their area on the surface: the overdraw saved */
+    size_t painted_pixels;   /* area of the commands that pass kept */
+    size_t clipped;          /* commands dropped while recording for missing the clip */
+} AromaDrawListStats;
+
 AromaDrawList* aroma_drawlist_create(void);
 void aroma_drawlist_destroy(AromaDrawList* list);
 void aroma_drawlist_reset(AromaDrawList* list);
 
+/* Text longer than an inline AromaStr is copied into this arena, or into one
+   the list owns when none is set; a shared arena must outlive the commands,
+   i.e. be reset after the list. */
+void aroma_drawlist_set_arena(AromaDrawList* list, AromaFrameArena* arena);
+AromaFrameArena* aroma_drawlist_get_arena(const AromaDrawList* list);
+AromaDrawListStats aroma_drawlist_get_stats(const AromaDrawList* list);
+/* Running hash of everything recorded since the last reset; equal hashes
+   mean the same commands with the same text. Image pixels are not hashed. */
+uint64_t aroma_drawlist_get_hash(const AromaDrawList* list);
+
+/* When enabled, replay groups commands that bind the same state, moving them
+   only past commands they do not overlap, and hands runs of rectangles to the
+   backend's draw_rectangles in one call. Off by default: the sorting pass
+   costs more per command than it saves unless the backend's per-call state
+   changes dominate. */
+void aroma_drawlist_set_batching(AromaDrawList* list, bool enabled);
+bool aroma_drawlist_get_batching(const AromaDrawList* list);
+/* Backend and window that measure text bounds as it is recorded; a NULL
+   `gfx` uses the active graphics backend. */
+void aroma_drawlist_set_text_measure(AromaDrawList* list, AromaGraphicsInterface* gfx, size_t window_id);
+
 void aroma_drawlist_begin(AromaDrawList* list);
 void aroma_drawlist_end(void);
+/* Like begin, for recording off the render thread: the graphics proxy then
+   refuses calls that would touch backend state instead of recording. */
+void aroma_drawlist_begin_worker(AromaDrawList* list);
+bool aroma_drawlist_is_worker(void);
 bool aroma_drawlist_is_active(void);
 AromaDrawList* aroma_drawlist_get_active(void);
 
@@ -45,10 +88,129 @@ void aroma_drawlist_cmd_arc(AromaDrawList* list, int cx, int cy, int radius,
                             float start_angle, float end_angle, uint32_t color, int thickness);
 void aroma_drawlist_cmd_text(AromaDrawList* list, AromaFont* font, const char* text,
                              int x, int y, uint32_t color, float scale);
+/* Records widget-owned text without copying: interned strings are pinned
+   until the list resets, so later edits to the widget cannot dangle. */
+void aroma_drawlist_cmd_text_str(AromaDrawList* list, AromaFont* font, const AromaStr* text,
+                                 int x, int y, uint32_t color, float scale);
 void aroma_drawlist_cmd_image(AromaDrawList* list, int x, int y, int width, int height, unsigned int texture_id);
+/*
+ * Clipping. A push intersects the rectangle with the clip in effect and a
+ * pop restores the one before; commands recorded entirely outside the clip
+ * are dropped on the spot. A clip command is only recorded ahead of the next
+ * command that is kept, so a push whose contents all miss costs nothing.
+ */
+#define AROMA_DRAWLIST_MAX_CLIP_DEPTH 16
+void aroma_drawlist_cmd_push_clip(AromaDrawList* list, int x, int y, int width, int height);
+void aroma_drawlist_cmd_pop_clip(AromaDrawList* list);
+/* Replaces the clip in effect without touching the stack, as backend-level
+   clip calls and captures, which carry absolute clips, need. */
+void aroma_drawlist_cmd_set_clip(AromaDrawList* list, bool enabled, int x, int y, int width, int height);
+/* The clip in effect; false when recording is unclipped. */
+bool aroma_drawlist_get_clip(const AromaDrawList* list, int* x, int* y, int* width, int* height);
+/* Clip an empty list starts under when its commands will be appended where
+   that clip is in effect, e.g. a worker chunk; records nothing itself. */
+void aroma_drawlist_set_base_clip(AromaDrawList* list, bool enabled, int x, int y, int width, int height);
+
+/* Copies every command of `other` onto the end of `list`; text is re-owned
+   by `list`, so `other` may be reset right away. */
+void aroma_drawlist_append(AromaDrawList* list, const AromaDrawList* other);
+
+/*
+ * Parallel recording. `record` runs once per chunk, with at most one chunk
+ * per recording thread: chunk 0 on the calling thread straight into `list`,
+ * the others on workers into lists of their own that are appended to `list`
+ * in chunk order, so later chunks draw on top. Every chunk starts under the
+ * clip in effect in `list`. Callbacks run concurrently and must only read
+ * shared state. With one thread this records inline.
+ */
+#define AROMA_DRAWLIST_MAX_RECORD_THREADS 16
+typedef void (*AromaDrawRecordFn)(uint32_t chunk, uint32_t chunk_count, void* user_data);
+/* Threads recording a frame, the caller included; 1 turns workers off. */
+bool aroma_drawlist_set_record_threads(uint32_t threads);
+uint32_t aroma_drawlist_get_record_threads(void);
+void aroma_drawlist_record_parallel(AromaDrawList* list, size_t window_id, uint32_t max_chunks,
+                                    AromaDrawRecordFn record, void* user_data);
+/*
+ * Drops, in place, every command hidden under opaque fills recorded after
+ * it, and clears made redundant by a later clear or by a fill covering the
+ * whole surface. Non-positive sizes leave only clear-over-clear culling.
+ * Returns the number of commands dropped; see the stats for their area.
+ */
+size_t aroma_drawlist_cull_occluded(AromaDrawList* list, int surface_width, int surface_height);
+/* Issues every command to `gfx` in order without consuming the list. */
+void aroma_drawlist_replay(AromaDrawList* list, size_t window_id, AromaGraphicsInterface* gfx);
 void aroma_drawlist_flush(AromaDrawList* list, size_t window_id);
 
+/*
+ * Buckets commands into horizontal tiles of `tile_height` covering
+ * `surface_height`, so region replays that fit in one tile visit only the
+ * commands touching it. Recording or resetting drops the bins.
+ */
+bool aroma_drawlist_bin_tiles(AromaDrawList* list, int tile_height, int surface_height);
+/* Issues, in order, the commands intersecting the region; clears are skipped. */
+void aroma_drawlist_replay_region(AromaDrawList* list, size_t window_id, AromaGraphicsInterface* gfx,
+                                  int x, int y, int width, int height);
 void aroma_drawlist_smart_flush(AromaDrawList* list, size_t window_id, int x, int y, int width, int height);
+
+/*
+ * Captures: a versioned, little-endian serialization of a recorded list for
+ * replaying real frames offline. Fonts and textures cannot travel as
+ * handles, so a capture carries a table of each with their metrics, and the
+ * loader maps every entry back to a handle of the replaying process.
+ */
+#define AROMA_DRAWLIST_CAPTURE_VERSION 1
+
+typedef struct AromaDrawCaptureFont {
+    uint32_t index;
+    int line_height;
+    int ascender;
+    int descender;
+} AromaDrawCaptureFont;
+
+typedef struct AromaDrawCaptureTexture {
+    unsigned int texture_id;     /* id in the capturing process */
+    int width;                   /* largest size it was drawn at */
+    int height;
+    uint32_t uses;
+} AromaDrawCaptureTexture;
+
+typedef struct AromaDrawCaptureInfo {
+    uint16_t version;
+    int surface_width;
+    int surface_height;
+    uint32_t command_count;
+    uint32_t font_count;
+    uint32_t texture_count;
+} AromaDrawCaptureInfo;
+
+typedef struct AromaDrawCaptureOptions {
+    /* NULL callbacks load text with no font and keep texture ids as captured. */
+    AromaFont* (*map_font)(const AromaDrawCaptureFont* font, void* user_data);
+    unsigned int (*map_texture)(const AromaDrawCaptureTexture* texture, void* user_data);
+    void* user_data;
+    /* Measures text as it is re-recorded; NULL uses the active backend. */
+    AromaGraphicsInterface* measure_gfx;
+    size_t measure_window;
+} AromaDrawCaptureOptions;
+
+/* Returns the capture size in bytes; `out` is written only if it fits. */
+size_t aroma_drawlist_serialize(const AromaDrawList* list, int surface_width, int surface_height,
+                                void* out, size_t capacity);
+/* Records a capture into a new list; NULL if it is malformed or newer than
+   this build understands. Command types it does not know are skipped. */
+AromaDrawList* aroma_drawlist_deserialize(const void* data, size_t size, const AromaDrawCaptureOptions* options,
+                                          AromaDrawCaptureInfo* info);
+bool aroma_drawlist_save(const AromaDrawList* list, int surface_width, int surface_height, const char* path);
+AromaDrawList* aroma_drawlist_load(const char* path, const AromaDrawCaptureOptions* options,
+                                   AromaDrawCaptureInfo* info);
+
+/* Draws `text` through the active drawlist by reference, or immediately. */
+void aroma_draw_text_str(size_t window_id, AromaFont* font, const AromaStr* text,
+                         int x, int y, uint32_t color, float scale);
+/* Clips what a widget draws next through the active drawlist, or with the
+   backend's clip when drawing immediately. Pushes and pops must pair up. */
+void aroma_draw_push_clip(size_t window_id, int x, int y, int width, int height);
+void aroma_draw_pop_clip(size_t window_id);
 #ifdef __cplusplus
 }
 #endif
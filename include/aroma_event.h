@@ -65,6 +65,8 @@ struct AromaEvent {
 };
 
 typedef bool (*AromaEventHandler)(AromaEvent* event, void* user_data);
+/* Sees every dispatched event before its listeners run. */
+typedef void (*AromaEventObserver)(const AromaEvent* event);
 
 typedef struct {
     AromaEventType event_type;
@@ -85,6 +87,11 @@ AromaEvent* aroma_event_create(AromaEventType event_type, uint64_t target_node_i
 
 bool aroma_event_dispatch(AromaEvent* event);
 
+void aroma_event_set_dispatch_observer(AromaEventObserver observer);
+
+/* Task scheduler's own slot, run before the app observer so neither replaces the other. */
+void __event_set_task_hook(AromaEventObserver hook);
+
 bool aroma_event_queue(AromaEvent* event);
 
 void aroma_event_process_queue(void);
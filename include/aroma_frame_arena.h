@@ -0,0 +1,48 @@
+#ifndef AROMA_FRAME_ARENA_H
+#define AROMA_FRAME_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_FRAME_ARENA_CHUNK_SIZE 16384
+#define AROMA_FRAME_ARENA_ALIGNMENT 16
+
+typedef struct AromaFrameArena AromaFrameArena;
+
+/* Position inside an arena, used to release scratch allocations early. */
+typedef struct AromaFrameArenaMark {
+    void* chunk;
+    size_t used;
+} AromaFrameArenaMark;
+
+typedef struct AromaFrameArenaStats {
+    size_t used;          /* bytes handed out since the last reset */
+    size_t capacity;      /* bytes held across all chunks */
+    size_t peak_used;
+    size_t chunk_allocs;  /* chunks ever malloc'd; flat in a steady state */
+    uint64_t resets;
+} AromaFrameArenaStats;
+
+AromaFrameArena* aroma_frame_arena_create(void);
+void aroma_frame_arena_destroy(AromaFrameArena* arena);
+
+/*
+ * Bump allocations live until the next reset. Reset keeps every chunk, so
+ * once the arena has seen its busiest frame it never calls malloc again.
+ */
+void* aroma_frame_arena_alloc(AromaFrameArena* arena, size_t size);
+char* aroma_frame_arena_strdup(AromaFrameArena* arena, const char* text);
+char* aroma_frame_arena_strndup(AromaFrameArena* arena, const char* text, size_t length);
+void aroma_frame_arena_reset(AromaFrameArena* arena);
+
+AromaFrameArenaMark aroma_frame_arena_mark(const AromaFrameArena* arena);
+void aroma_frame_arena_rewind(AromaFrameArena* arena, AromaFrameArenaMark mark);
+
+AromaFrameArenaStats aroma_frame_arena_get_stats(const AromaFrameArena* arena);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,57 @@
+#ifndef AROMA_IDLE_H
+#define AROMA_IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_MAX_IDLE_TASKS 64
+#define AROMA_IDLE_FRAME_INTERVAL_MS 16
+/* A task deferred this many runs in a row is run even without slack. */
+#define AROMA_IDLE_STARVATION_RUNS 8
+
+typedef struct AromaIdleDeadline {
+    uint64_t deadline_ms;
+    bool forced;
+} AromaIdleDeadline;
+
+typedef enum AromaIdleResult {
+    AROMA_IDLE_DONE,
+    AROMA_IDLE_YIELD
+} AromaIdleResult;
+
+/* Return AROMA_IDLE_YIELD to be resumed in a later slack period. */
+typedef AromaIdleResult (*AromaIdleFn)(void* ctx, const AromaIdleDeadline* deadline);
+
+typedef struct AromaIdleStats {
+    uint64_t posted;
+    uint64_t executed;
+    uint64_t completed;
+    uint64_t yielded;
+    uint64_t deferred;
+    uint64_t starved;
+    uint64_t dropped;
+    size_t pending;
+} AromaIdleStats;
+
+void aroma_idle_init(void);
+void aroma_idle_shutdown(void);
+
+bool aroma_idle_post(AromaIdleFn fn, void* ctx);
+size_t aroma_idle_pending(void);
+
+/* Runs queued tasks until deadline_ms on the idle clock. Returns how many ran. */
+size_t aroma_idle_run(uint64_t deadline_ms);
+uint32_t aroma_idle_time_remaining(const AromaIdleDeadline* deadline);
+
+AromaIdleStats aroma_idle_get_stats(void);
+void aroma_idle_reset_stats(void);
+
+/* Overrides the clock used for budgets; NULL restores aroma_time_now_ms. */
+void aroma_idle_set_clock(uint64_t (*now_fn)(void));
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,68 @@
+#ifndef AROMA_MEMORY_H
+#define AROMA_MEMORY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+typedef enum AromaMemorySubsystem {
+    AROMA_MEMORY_SLAB,          /* node and widget pages, large objects, scene arenas */
+    AROMA_MEMORY_DRAWLIST,      /* command buffers and heap-copied text */
+    AROMA_MEMORY_FRAME_ARENA,   /* per-window frame arena chunks */
+    AROMA_MEMORY_STRINGS,       /* interned string entries */
+    AROMA_MEMORY_TEXTURES,      /* images uploaded through load_image* */
+    AROMA_MEMORY_GLYPHS,        /* backend glyph caches */
+    AROMA_MEMORY_LOGGER,        /* retained log entries */
+    AROMA_MEMORY_SUBSYSTEM_COUNT
+} AromaMemorySubsystem;
+
+/* Budget target covering every subsystem together. */
+#define AROMA_MEMORY_TOTAL AROMA_MEMORY_SUBSYSTEM_COUNT
+
+typedef enum AromaMemoryDomain {
+    AROMA_MEMORY_DOMAIN_CPU,
+    AROMA_MEMORY_DOMAIN_GPU
+} AromaMemoryDomain;
+
+typedef struct AromaMemoryUsage {
+    size_t cpu_bytes;
+    size_t gpu_bytes;
+    size_t peak_cpu_bytes;
+    size_t peak_gpu_bytes;
+} AromaMemoryUsage;
+
+typedef struct AromaMemoryReport {
+    AromaMemoryUsage subsystems[AROMA_MEMORY_SUBSYSTEM_COUNT];
+    size_t total_cpu_bytes;
+    size_t total_gpu_bytes;
+} AromaMemoryReport;
+
+/* Runs once each time a subsystem (or AROMA_MEMORY_TOTAL) rises above its
+   budget; it is re-armed when usage drops back under. */
+typedef void (*AromaMemoryBudgetCallback)(AromaMemorySubsystem subsystem, AromaMemoryDomain domain,
+                                          size_t usage, size_t budget, void* user_data);
+
+/*
+ * Subsystems report their own growth through aroma_memory_track, so budgets
+ * on them are checked the moment they are crossed. The slab allocator keeps
+ * its own counters and is sampled by aroma_memory_report and
+ * aroma_memory_check_budgets, which the UI loop calls once per idle pass.
+ * GPU figures are estimates from texture dimensions and formats.
+ */
+AromaMemoryReport aroma_memory_report(void);
+void aroma_memory_report_print(void);
+const char* aroma_memory_subsystem_name(AromaMemorySubsystem subsystem);
+
+void aroma_memory_track(AromaMemorySubsystem subsystem, ptrdiff_t cpu_delta, ptrdiff_t gpu_delta);
+
+/* A zero budget disables the check. */
+void aroma_memory_set_budget(AromaMemorySubsystem subsystem, AromaMemoryDomain domain, size_t bytes);
+size_t aroma_memory_get_budget(AromaMemorySubsystem subsystem, AromaMemoryDomain domain);
+void aroma_memory_set_budget_callback(AromaMemoryBudgetCallback callback, void* user_data);
+/* Returns how many budgets are currently exceeded. */
+size_t aroma_memory_check_budgets(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "aroma_common.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -11,8 +12,11 @@ extern "C" {
 #define AROMA_MAX_DIRTY_NODES 256
 
 typedef struct AromaNode AromaNode;
+typedef struct AromaSceneArena AromaSceneArena;
 
 typedef void (*AromaNodeDrawFn)(AromaNode* node, size_t window_id);
+/* Releases what a widget owns beyond its own slab block (strings, arrays). */
+typedef void (*AromaNodeDestroyFn)(AromaNode* node);
 
 typedef enum AromaNodeType {
     NODE_TYPE_ROOT,
@@ -29,6 +33,8 @@ typedef struct AromaNode
     AromaNode* child_nodes[AROMA_MAX_CHILD_NODES];
     void *node_widget_ptr;
     AromaNodeDrawFn draw_cb;
+    AromaNodeDestroyFn destroy_cb;
+    AromaSceneArena* scene_arena;   /* the arena this node was carved from, or NULL */
     uint64_t child_count;
     bool is_dirty;
     bool is_hidden;
@@ -44,6 +50,18 @@ AromaNode* __add_child_node(AromaNodeType node_type, AromaNode* parent_node, voi
 AromaNode* __remove_child_node(AromaNode* parent_node, uint64_t node_id);
 void __destroy_node(AromaNode* node);
 void __destroy_node_tree(AromaNode* root_node);
+/* Detaches a screen built inside `arena`, runs its widgets' destroy hooks and
+   releases the arena's chunks in one go. */
+void aroma_node_destroy_scene(AromaNode* scene_root, AromaSceneArena* arena);
+/* Allocates the widget of a new child of `parent`. While a scene arena is
+   active on the thread, the first node created becomes its root and from
+   then on only widgets and nodes under that root are carved from it;
+   everything else, overlays included, comes from the pools. */
+void* aroma_widget_alloc_under(AromaNode* parent, size_t size);
+#ifdef AROMA_ALLOC_PROFILE
+void* aroma_widget_alloc_under_at(AromaNode* parent, size_t size, const char* file, int line);
+#define aroma_widget_alloc_under(parent, size) aroma_widget_alloc_under_at((parent), (size), __FILE__, __LINE__)
+#endif
 AromaNode* __find_node_by_id(AromaNode* root, uint64_t node_id);
 
 uint64_t __generate_node_id(void);
@@ -58,10 +76,12 @@ int32_t aroma_node_get_z_index(AromaNode* node);
 
 void aroma_node_invalidate(AromaNode* node);
 void aroma_node_invalidate_tree(AromaNode* root);
+void aroma_node_invalidate_rect(AromaNode* node, int x, int y, int width, int height);
 bool aroma_node_is_dirty(AromaNode* node);
 void aroma_node_mark_clean(AromaNode* node);
 void aroma_node_set_draw_cb(AromaNode* node, AromaNodeDrawFn draw_cb);
 AromaNodeDrawFn aroma_node_get_draw_cb(AromaNode* node);
+void aroma_node_set_destroy_cb(AromaNode* node, AromaNodeDestroyFn destroy_cb);
 void aroma_node_set_hidden(AromaNode* node, bool hidden);
 bool aroma_node_is_hidden(AromaNode* node);
 
@@ -69,6 +89,12 @@ void aroma_dirty_list_init(void);
 void aroma_dirty_list_clear(void);
 AromaNode** aroma_dirty_list_get(size_t* count);
 void aroma_dirty_list_add(AromaNode* node);
+
+/* Returns true and fills out_rect when only part of the window was damaged
+   this frame; false means a full repaint is required (or nothing is dirty). */
+bool aroma_dirty_region_get(AromaRect* out_rect);
+void aroma_dirty_region_add(int x, int y, int width, int height);
+void aroma_dirty_region_mark_full(void);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,57 @@
+#ifndef AROMA_POST_H
+#define AROMA_POST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_MAX_POSTED_UPDATES 32
+#define AROMA_POST_TEXT_MAX 256
+
+typedef struct AromaNode AromaNode;
+
+typedef union AromaPostValue {
+    int32_t i;
+    uint32_t u;
+    float f;
+    char text[AROMA_POST_TEXT_MAX];
+} AromaPostValue;
+
+/* Runs on the UI thread with the latest value posted for (node, apply). */
+typedef void (*AromaPostApplyFn)(AromaNode* node, const AromaPostValue* value);
+typedef AromaNode* (*AromaPostResolveFn)(uint64_t node_id);
+
+typedef struct AromaPostStats {
+    uint64_t posted;
+    uint64_t coalesced;
+    uint64_t applied;
+    uint64_t dropped;
+    uint64_t stale;
+} AromaPostStats;
+
+void aroma_post_init(void);
+void aroma_post_shutdown(void);
+
+/*
+ * Thread-safe. Queues a property mutation for the UI thread; a pending update
+ * for the same node and apply function is overwritten in place, so only the
+ * newest value is applied when the queue is flushed once per frame.
+ * Producers pass the node's id, read on the UI thread while the node was
+ * alive: the node itself may be destroyed before the post is made.
+ */
+bool aroma_post_update(uint64_t node_id, AromaPostApplyFn apply, const AromaPostValue* value);
+bool aroma_post_text(uint64_t node_id, AromaPostApplyFn apply, const char* text);
+bool aroma_post_float(uint64_t node_id, AromaPostApplyFn apply, float value);
+
+/* UI thread only. Applies every pending update; nodes that no longer resolve are skipped. */
+size_t aroma_post_flush(AromaPostResolveFn resolve);
+size_t aroma_post_pending(void);
+
+AromaPostStats aroma_post_get_stats(void);
+void aroma_post_reset_stats(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
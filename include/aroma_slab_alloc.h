@@ -3,53 +3,234 @@
 
 #include <stdlib.h>
 #include "aroma_node.h"
+#include "aroma_alloc_profile.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 #define AROMA_GENERIC_PAGE_SIZE 2048
 #define AROMA_MAX_PAGES 32
 #define AROMA_NODE_POOL_INDEX 0xFF
-#define AROMA_WIDGET_BUCKET_COUNT 7
-#define AROMA_WIDGET_BUCKET_SIZES {32, 64, 128, 256, 512, 1024, 2048}
+#define AROMA_WIDGET_BUCKET_COUNT 8
+#define AROMA_WIDGET_BUCKET_SIZES {32, 64, 128, 256, 512, 1024, 2048, 4096}
+/* Page size per bucket: small classes pack many objects into generic pages,
+   large classes get multi-KB pages so several still share one. Anything
+   bigger than the last bucket takes the large-object path. Page sizes are
+   powers of two between AROMA_GENERIC_PAGE_SIZE and AROMA_SLAB_MAX_PAGE_SIZE. */
+#ifndef AROMA_WIDGET_PAGE_SIZES
+#define AROMA_WIDGET_PAGE_SIZES {2048, 2048, 4096, 4096, 8192, 8192, 16384, 16384}
+#endif
+#define AROMA_SLAB_MAX_PAGE_SIZE 16384
+#define AROMA_SLAB_ALIGNMENT 16
+#define AROMA_SLAB_PAGE_MAGIC 0x41524D50u
+/* Fully empty pages a pool keeps when trimmed. */
+#define AROMA_SLAB_EMPTY_PAGES_KEPT 1
+#define AROMA_PAGE_BITMAP_WORDS ((AROMA_MAX_PAGES + 31) / 32)
+/* Objects a thread frees into another thread's pools are queued locally and
+   handed to the shared depot this many at a time. */
+#ifndef AROMA_SLAB_MAGAZINE_SIZE
+#define AROMA_SLAB_MAGAZINE_SIZE 32
+#endif
+#define AROMA_SLAB_CLASS_NONE 0xFF
+/* Scene arena chunks are the largest page size so address masking still
+   finds their header. */
+#define AROMA_SCENE_ARENA_CHUNK_SIZE AROMA_SLAB_MAX_PAGE_SIZE
 
 
 typedef struct AromaFreeSlot {
     struct AromaFreeSlot* next;
 } AromaFreeSlot;
 
+typedef struct AromaSlabThreadHeap AromaSlabThreadHeap;
+
+/*
+ * Every page is aligned to its own size and starts with this header, so the
+ * owner of any object is found by masking its address. Large objects get a
+ * header of their own with pool == NULL, as do scene arena chunks, which
+ * point back at their arena instead. Each page keeps its own free list so it
+ * can be handed back once its last object is freed.
+ */
 typedef struct AromaSlabAllocatorPage {
-    uint8_t data[AROMA_GENERIC_PAGE_SIZE];
-    struct AromaSlabAllocatorPage* next_page;
+    uint32_t magic;
     uint8_t is_stack_page;
+    size_t page_size;
+    struct AromaSlabAllocator* pool;
+    struct AromaSceneArena* scene_arena;
+    struct AromaSlabAllocatorPage* self;
+    struct AromaSlabAllocatorPage* prev_page;
+    struct AromaSlabAllocatorPage* next_page;
+    AromaFreeSlot* free_list;
+    uint32_t live_count;
+    uint32_t capacity;
 } AromaSlabAllocatorPage;
 
+#define AROMA_SLAB_HEADER_SIZE \
+    ((sizeof(AromaSlabAllocatorPage) + AROMA_SLAB_ALIGNMENT - 1) & ~(size_t)(AROMA_SLAB_ALIGNMENT - 1))
+
+/*
+ * Pages with free slots sit at the head of `pages`, full ones at the tail.
+ * Only the owning thread touches pages and counters; other threads return
+ * objects through `remote_frees`, which is guarded by the depot lock. The
+ * owning thread is the one whose private key equals `owner_key`.
+ */
 typedef struct AromaSlabAllocator {
     size_t object_size;
-    AromaFreeSlot* free_list;
+    size_t requested_size;
+    size_t page_size;
+    size_t objects_offset;
+    uint32_t page_capacity;
+    uint8_t object_shift;
+    uint8_t class_index;
+    bool trim_pending;
+    AromaSlabThreadHeap* owner;
+    unsigned owner_key;
     AromaSlabAllocatorPage* pages;
+    AromaSlabAllocatorPage* pages_tail;
+    size_t empty_pages;
     size_t total_pages;
+    size_t peak_pages;
+    size_t in_use;
+    size_t peak_in_use;
+    size_t requested_bytes;
+    size_t malloc_fallbacks;
     size_t total_allocated;
     size_t total_freed;
+    AromaFreeSlot* remote_frees;
+    size_t remote_count;
 } AromaSlabAllocator;
 
 typedef struct AromaMemorySystem {
     AromaSlabAllocator node_pool;
     AromaSlabAllocator widget_pools[AROMA_WIDGET_BUCKET_COUNT];
-    AromaSlabAllocatorPage preallocated_pages[AROMA_MAX_PAGES];
-    uint8_t page_used[AROMA_MAX_PAGES];
+    uint32_t page_used_bitmap[AROMA_PAGE_BITMAP_WORDS];
+    AromaSlabAllocatorPage* large_objects;
+    size_t large_object_count;
+    size_t large_object_bytes;
+    size_t peak_large_object_bytes;
 } AromaMemorySystem;
 
-void __slab_pool_init(AromaSlabAllocator* pool, size_t object_size);
+/* Counters are maintained on every alloc/free, so reading them is O(1). */
+typedef struct AromaSlabPoolStats {
+    size_t object_size;
+    size_t page_size;
+    size_t in_use;
+    size_t peak_in_use;
+    size_t available;
+    size_t pages;
+    size_t peak_pages;
+    size_t empty_pages;
+    size_t requested_bytes;
+    /* Slot bytes beyond what live allocations asked for. */
+    size_t fragmentation_bytes;
+    /* Page headers, size tables and tail slack. */
+    size_t overhead_bytes;
+    /* Pages that had to come from the system allocator. */
+    size_t malloc_fallbacks;
+    size_t total_allocated;
+    size_t total_freed;
+} AromaSlabPoolStats;
+
+typedef struct AromaMemoryStats {
+    AromaSlabPoolStats node_pool;
+    AromaSlabPoolStats widget_pools[AROMA_WIDGET_BUCKET_COUNT];
+    size_t widgets_in_use;
+    size_t widget_requested_bytes;
+    size_t fragmentation_bytes;
+    size_t malloc_fallbacks;
+    size_t large_objects;
+    size_t large_object_bytes;
+    size_t peak_large_object_bytes;
+    size_t preallocated_pages_used;
+    /* Worker heaps still alive or waiting to be adopted. Their pools are
+       folded into the per-class figures above. */
+    size_t thread_heaps;
+    size_t remote_frees_pending;
+    size_t scene_arena_chunks;
+    size_t scene_arena_bytes;
+} AromaMemoryStats;
+
+typedef struct AromaSceneArena AromaSceneArena;
+
+typedef struct AromaSceneArenaStats {
+    size_t chunks;
+    size_t bytes_reserved;
+    size_t bytes_used;
+    size_t objects;
+    /* Requests too large for a chunk, served by the regular allocator. */
+    size_t fallback_allocs;
+} AromaSceneArenaStats;
+
+/* What a scene holds outside its chunks; the node layer keeps these so that
+   teardown visits them instead of every node. */
+typedef enum AromaSceneArenaList {
+    AROMA_SCENE_ARENA_HOOKS,    /* carved nodes with a destroy hook */
+    AROMA_SCENE_ARENA_GUESTS,   /* pool nodes attached to a carved parent */
+    AROMA_SCENE_ARENA_LIST_COUNT
+} AromaSceneArenaList;
+
+void __slab_pool_init(AromaSlabAllocator* pool, size_t object_size, size_t page_size);
 void __slab_pool_destroy(AromaSlabAllocator* pool);
 void* __slab_pool_alloc(AromaSlabAllocator* pool);
 void __slab_pool_free(AromaSlabAllocator* pool, void* object);
+/* Page owning a slab object or large object, found by address masking. */
+AromaSlabAllocatorPage* __slab_page_from_ptr(const void* object);
 
 void* aroma_widget_alloc(size_t size);
 void aroma_widget_free(void* widget);
 
+/*
+ * The thread that calls aroma_memory_system_init owns global_memory_system
+ * and allocates from it without locking. Any other thread transparently gets
+ * a private heap of the same pools on first use; freeing another thread's
+ * object queues it in a per-thread magazine that is returned to the owner in
+ * batches. A finished worker's heap is adopted by the owner on its next trim,
+ * so screens built off-thread can be handed to the UI thread.
+ */
 void aroma_memory_system_init(void);
 void aroma_memory_system_destroy(void);
 void aroma_memory_system_stats(void);
+AromaMemoryStats aroma_memory_system_get_stats(void);
+AromaSlabPoolStats aroma_slab_pool_get_stats(const AromaSlabAllocator* pool);
+/* Returns empty pages beyond AROMA_SLAB_EMPTY_PAGES_KEPT per pool to the
+   preallocated set or the system; the UI calls it after each frame. */
+size_t aroma_memory_system_trim(void);
+bool aroma_memory_system_trim_pending(void);
+/* Hands the calling thread's queued cross-thread frees to the depot now. */
+void aroma_memory_thread_flush(void);
+
+/*
+ * A scene arena holds one screen, bump-allocated into a few contiguous
+ * chunks. The node layer decides what is carved from the arena active on the
+ * thread (see aroma_widget_alloc_under); plain allocations always come from
+ * the pools. Freeing an arena object is a no-op; the memory comes back all at
+ * once in aroma_scene_arena_destroy. Begin returns the previously active
+ * arena so that end can restore it.
+ */
+AromaSceneArena* aroma_scene_arena_create(void);
+void aroma_scene_arena_destroy(AromaSceneArena* arena);
+AromaSceneArena* aroma_scene_arena_begin(AromaSceneArena* arena);
+void aroma_scene_arena_end(AromaSceneArena* previous);
+AromaSceneArena* aroma_scene_arena_current(void);
+bool aroma_scene_arena_owns(const void* object);
+/* The arena `object` was carved from, or NULL. `object` must be a slab allocation. */
+AromaSceneArena* aroma_scene_arena_of(const void* object);
+AromaSceneArenaStats aroma_scene_arena_get_stats(const AromaSceneArena* arena);
+/* NULL when `size` does not fit a chunk or no chunk can be had. */
+void* aroma_scene_arena_alloc(AromaSceneArena* arena, size_t size);
+/* The node the scene hangs from; the node layer binds it to the first node carved. */
+void* aroma_scene_arena_get_root(const AromaSceneArena* arena);
+void aroma_scene_arena_set_root(AromaSceneArena* arena, void* root);
+bool aroma_scene_arena_track(AromaSceneArena* arena, AromaSceneArenaList list, void* object);
+void aroma_scene_arena_untrack(AromaSceneArena* arena, AromaSceneArenaList list, void* object);
+/* Latest tracked object first; NULL once the list is empty. */
+void* aroma_scene_arena_pop(AromaSceneArena* arena, AromaSceneArenaList list);
+
+#ifdef AROMA_ALLOC_PROFILE
+/* Profiling builds route allocations through call-site-recording twins. */
+void* __slab_pool_alloc_at(AromaSlabAllocator* pool, const char* file, int line);
+void* aroma_widget_alloc_at(size_t size, const char* file, int line);
+#define __slab_pool_alloc(pool) __slab_pool_alloc_at((pool), __FILE__, __LINE__)
+#define aroma_widget_alloc(size) aroma_widget_alloc_at((size), __FILE__, __LINE__)
+#endif
 
 extern AromaMemorySystem global_memory_system;
 #ifdef __cplusplus
@@ -0,0 +1,65 @@
+#ifndef AROMA_STRING_H
+#define AROMA_STRING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* Strings up to this many characters are stored inside the AromaStr itself. */
+#define AROMA_STR_INLINE_CAPACITY 15
+#define AROMA_STRING_POOL_BUCKETS 256
+
+typedef struct AromaStrEntry AromaStrEntry;
+
+/*
+ * A 16-byte string handle for widget text. Short strings live inline; longer
+ * ones point at a refcounted entry in the intern pool, so every "Cancel" or
+ * image path is stored once however many widgets use it. A zeroed AromaStr
+ * is the empty string. The last byte is 0 for inline strings, where it also
+ * terminates a full 15-character string.
+ */
+typedef struct AromaStr {
+    union {
+        char inline_text[AROMA_STR_INLINE_CAPACITY + 1];
+        struct {
+            const char* text;   /* inside the pool entry */
+            uint8_t pad[AROMA_STR_INLINE_CAPACITY - sizeof(const char*)];
+            uint8_t is_interned;
+        } ref;
+    } data;
+} AromaStr;
+
+typedef struct AromaStringPoolStats {
+    size_t entries;
+    size_t references;
+    size_t bytes;             /* entry headers plus text */
+    size_t shared_bytes_saved;/* bytes a private copy per reference would have cost */
+    uint64_t lookups;
+    uint64_t hits;
+} AromaStringPoolStats;
+
+void aroma_str_set(AromaStr* str, const char* text);
+void aroma_str_set_n(AromaStr* str, const char* text, size_t length);
+/* Copying an interned string only bumps its refcount; it never locks or
+   allocates, so it is cheap enough to pin text for a frame. */
+void aroma_str_copy(AromaStr* dst, const AromaStr* src);
+/* Drops the reference (if any) and leaves `str` empty. */
+void aroma_str_release(AromaStr* str);
+size_t aroma_str_length(const AromaStr* str);
+bool aroma_str_equals(const AromaStr* str, const char* text);
+
+static inline bool aroma_str_is_interned(const AromaStr* str) {
+    return str->data.ref.is_interned != 0;
+}
+
+static inline const char* aroma_str_get(const AromaStr* str) {
+    return aroma_str_is_interned(str) ? str->data.ref.text : str->data.inline_text;
+}
+
+AromaStringPoolStats aroma_string_pool_get_stats(void);
+#ifdef __cplusplus
+}
+#endif
+#endif
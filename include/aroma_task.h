@@ -0,0 +1,97 @@
+#ifndef AROMA_TASK_H
+#define AROMA_TASK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "aroma_event.h"
+#include "aroma_asset.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define AROMA_MAX_TASKS 16
+
+/*
+ * Stackless coroutines resumed by the UI loop once per frame tick. A task
+ * body is a function bracketed by AROMA_TASK_BEGIN/AROMA_TASK_END; every
+ * AROMA_TASK_* await returns to the scheduler and resumes on the following
+ * line. Locals do not survive an await, so keep state in the ctx struct,
+ * and use at most one await per source line.
+ */
+typedef enum AromaTaskStatus {
+    AROMA_TASK_SUSPENDED,
+    AROMA_TASK_DONE
+} AromaTaskStatus;
+
+typedef enum AromaTaskWait {
+    AROMA_TASK_WAIT_NONE,
+    AROMA_TASK_WAIT_SLEEP,
+    AROMA_TASK_WAIT_FRAME,
+    AROMA_TASK_WAIT_EVENT,
+    AROMA_TASK_WAIT_ASSET
+} AromaTaskWait;
+
+typedef struct AromaTask AromaTask;
+typedef AromaTaskStatus (*AromaTaskFn)(AromaTask* task, void* ctx);
+typedef void (*AromaTaskDoneCallback)(AromaTask* task, void* ctx);
+
+struct AromaTask {
+    AromaTaskFn fn;
+    void* ctx;
+    AromaTaskDoneCallback on_done;
+    uint32_t resume_point;
+    bool active;
+
+    AromaTaskWait wait;
+    uint64_t wake_ms;
+    uint32_t wake_frame;
+    uint64_t wait_node_id;
+    AromaEventType wait_event_type;
+    const AromaAsset* wait_asset;
+
+    /* Copy of the event that woke the task; custom payloads are already freed. */
+    AromaEvent event;
+};
+
+#define AROMA_TASK_BEGIN(task) switch ((task)->resume_point) { case 0:
+#define AROMA_TASK_END(task) } (task)->resume_point = 0; return AROMA_TASK_DONE
+
+#define __AROMA_TASK_SUSPEND(task)              \
+    (task)->resume_point = __LINE__;            \
+    return AROMA_TASK_SUSPENDED;                \
+    case __LINE__:;
+
+#define AROMA_TASK_SLEEP_MS(task, ms) \
+    do { aroma_task_wait_sleep((task), (ms)); __AROMA_TASK_SUSPEND(task); } while (0)
+#define AROMA_TASK_NEXT_FRAME(task) \
+    do { aroma_task_wait_frame(task); __AROMA_TASK_SUSPEND(task); } while (0)
+/* node_id 0 matches any target; the event is left in task->event. */
+#define AROMA_TASK_AWAIT_EVENT(task, node_id, event_type) \
+    do { aroma_task_wait_event((task), (node_id), (event_type)); __AROMA_TASK_SUSPEND(task); } while (0)
+/* Returns immediately if the asset already settled; check its state after. */
+#define AROMA_TASK_AWAIT_ASSET(task, asset) \
+    do { if (aroma_asset_is_pending(asset)) { aroma_task_wait_asset((task), (asset)); __AROMA_TASK_SUSPEND(task); } } while (0)
+
+void aroma_task_init(void);
+void aroma_task_shutdown(void);
+
+/* The task first runs on the next scheduler tick. */
+AromaTask* aroma_task_spawn(AromaTaskFn fn, void* ctx);
+void aroma_task_set_on_done(AromaTask* task, AromaTaskDoneCallback cb);
+void aroma_task_cancel(AromaTask* task);
+bool aroma_task_is_active(const AromaTask* task);
+uint32_t aroma_task_active_count(void);
+
+/* Resumes every task whose wait is satisfied at frame clock `now_ms`. */
+void aroma_task_tick(uint64_t now_ms);
+/* Earliest wake time of a sleeping task; false if none sleeps. */
+bool aroma_task_next_deadline(uint64_t* out_ms);
+
+/* Wait primitives behind the await macros. */
+void aroma_task_wait_sleep(AromaTask* task, uint32_t ms);
+void aroma_task_wait_frame(AromaTask* task);
+void aroma_task_wait_event(AromaTask* task, uint64_t node_id, AromaEventType event_type);
+void aroma_task_wait_asset(AromaTask* task, const AromaAsset* asset);
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -14,7 +14,10 @@ void aroma_timer_init(void);
 void aroma_timer_shutdown(void);
 AromaTimer* aroma_timer_create(uint32_t period_ms, bool repeat, AromaTimerCallback cb, void* user_data);
 void aroma_timer_cancel(AromaTimer* timer);
+void aroma_timer_reset(AromaTimer* timer);
+void aroma_timer_set_paused(AromaTimer* timer, bool paused);
 void aroma_timer_tick(uint64_t now_ms);
+bool aroma_timer_next_deadline(uint64_t* out_ms);
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,12 @@
 #include "aroma_style.h"
 #include "aroma_widgets.h"
 #include "aroma_drawlist.h"
+#include "aroma_frame_arena.h"
+#include "aroma_time.h"
+#include "aroma_timer.h"
+#include "aroma_animation.h"
+#include "aroma_idle.h"
+#include "aroma_task.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -53,6 +59,7 @@ typedef struct {
     AromaNode* root_node;
     size_t window_id;
     bool is_active;
+    bool has_focus;
     AromaFont* default_font;
 } AromaWindowHandle;
 
@@ -86,8 +93,38 @@ bool aroma_ui_is_immediate_mode(void);
 void aroma_ui_request_redraw(void* user_data);
 bool aroma_ui_consume_redraw(void);
 
+/* Platform/app hooks that let periodic UI work such as caret blinking sleep.
+   Windows start out focused and no platform backend reports focus changes
+   yet, so the application forwards its own focus-in/focus-out events. */
+void aroma_ui_set_window_focused(size_t window_id, bool focused);
+/* Whether the window holding `node` has focus; true for detached nodes. */
+bool aroma_ui_is_node_window_focused(const AromaNode* node);
+void aroma_ui_set_idle_throttled(bool throttled);
+bool aroma_ui_is_idle_throttled(void);
+
+typedef struct AromaFrameStats {
+    uint64_t frames_presented;
+    uint64_t frames_skipped;    /* identical to the window's last presented frame */
+    uint64_t commands_occluded; /* dropped before flushing, hidden under later fills */
+    uint64_t pixels_occluded;   /* overdraw those commands would have cost */
+    uint64_t commands_clipped;  /* dropped while recording, outside their clip */
+} AromaFrameStats;
+
 AromaDrawList* aroma_ui_begin_frame(size_t window_id);
-void aroma_ui_end_frame(size_t window_id);
+/* Flushes the frame, unless it hashes the same as the last one presented to
+   this window: then it is dropped, false is returned and the following
+   aroma_graphics_swap_buffers does nothing. */
+bool aroma_ui_end_frame(size_t window_id);
+bool aroma_ui_frame_was_skipped(size_t window_id);
+/* Presents the next frame even if it matches, e.g. after reloading a texture in place. */
+void aroma_ui_force_present(size_t window_id);
+AromaFrameStats aroma_ui_get_frame_stats(void);
+/* Saves the next `frames` presented frames as drawlist captures (see
+   aroma_drawlist_save); a "%u" in `path` becomes the capture's index.
+   AROMA_UI_CAPTURE=<path> and AROMA_UI_CAPTURE_FRAMES=<n> do this at init. */
+bool aroma_ui_capture_frames(const char* path, uint32_t frames);
+/* Per-window scratch memory that lives until the window's next begin_frame. */
+AromaFrameArena* aroma_ui_get_frame_arena(size_t window_id);
 void aroma_ui_render_dirty_window(size_t window_id, uint32_t clear_color);
 
 extern bool aroma_ui_init_impl(void);
@@ -125,12 +162,16 @@ static inline bool aroma_ui_is_running(void) {
     return aroma_ui_is_running_impl();
 }
 
+extern void aroma_ui_tick_impl(uint64_t now_ms);
+
 static inline void aroma_ui_process_events(void) {
     if (!g_ui_initialized) return;
     aroma_event_process_queue();
+    aroma_ui_tick_impl(aroma_time_now_ms());
 }
 
 extern void aroma_ui_render_impl(struct AromaWindow* window_data);
+extern void aroma_ui_run_idle_impl(void);
 extern void aroma_ui_render_all_windows_impl(void);
 
 static inline void aroma_ui_render(AromaWindow* window) {
@@ -143,7 +184,10 @@ static inline void aroma_ui_render(AromaWindow* window) {
 
     size_t dirty_count = 0;
     aroma_dirty_list_get(&dirty_count);
-    if (dirty_count == 0 && !aroma_ui_is_immediate_mode()) return;
+    if (dirty_count == 0 && !aroma_ui_is_immediate_mode()) {
+        aroma_ui_run_idle_impl();
+        return;
+    }
 
     aroma_ui_render_impl(window_data);
 
@@ -21,6 +21,9 @@ AromaNode* aroma_label_create(AromaNode* parent, const char* text, int x, int y,
 // Set text
 void aroma_label_set_text(AromaNode* label_node, const char* text);
 
+// Set text from any thread by node id (read it on the UI thread); applied once per frame with the latest value
+bool aroma_label_post_text(uint64_t label_node_id, const char* text);
+
 // Set color
 void aroma_label_set_color(AromaNode* label_node, uint32_t color);
 
@@ -5,13 +5,14 @@
 #include "aroma_node.h"
 #include "aroma_event.h"
 #include "aroma_font.h"
+#include "aroma_string.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 // Material Design 3 List View
 typedef struct AromaListItem {
-    char text[128];
-    char secondary_text[128];
+    AromaStr text;
+    AromaStr secondary_text;
     void* user_data;
 } AromaListItem;
 
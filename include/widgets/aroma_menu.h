@@ -5,12 +5,13 @@
 #include "aroma_node.h"
 #include "aroma_event.h"
 #include "aroma_font.h"
+#include "aroma_string.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 // Material Design 3 Menu
 typedef struct AromaMenuItem {
-    char text[64];
+    AromaStr text;
     bool enabled;
     bool separator;
     void (*callback)(void* user_data);
@@ -20,6 +20,9 @@ AromaNode* aroma_progressbar_create(AromaNode* parent, int x, int y, int width,
 // Set progress (0.0 to 1.0)
 void aroma_progressbar_set_progress(AromaNode* progress_node, float progress);
 
+// Set progress from any thread by node id (read it on the UI thread); applied once per frame with the latest value
+bool aroma_progressbar_post_progress(uint64_t progress_node_id, float progress);
+
 // Get progress
 float aroma_progressbar_get_progress(AromaNode* progress_node);
 
@@ -18,6 +18,7 @@ typedef struct AromaSwitch
 
     uint32_t color_on;
     uint32_t color_off;
+    uint32_t track_color;
     bool is_hovered;
     float track_radius;
     int toggle_size;
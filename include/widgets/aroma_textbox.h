@@ -4,6 +4,7 @@
 #include "aroma_common.h"
 #include "aroma_node.h"
 #include "aroma_logger.h"
+#include "aroma_string.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
@@ -12,6 +13,7 @@ extern "C" {
 #endif
 #define AROMA_TEXTBOX_MAX_LENGTH 256
 #define AROMA_TEXTBOX_CURSOR_BLINK_RATE 500
+#define AROMA_TEXTBOX_CURSOR_BLINK_TIMEOUT 10000
 
 typedef struct AromaFont AromaFont;
 typedef struct AromaWindow AromaWindow;
@@ -19,7 +21,8 @@ typedef struct AromaWindow AromaWindow;
 typedef struct AromaTextbox
 {
     AromaRect rect;
-    char text[AROMA_TEXTBOX_MAX_LENGTH];
+    char* text;                 /* edit buffer, grown on demand; NULL while empty */
+    size_t text_capacity;
     size_t text_length;
     size_t cursor_pos;
 
@@ -27,7 +30,6 @@ typedef struct AromaTextbox
     bool is_hovered;
     bool show_cursor;
 
-    uint64_t cursor_blink_time;
 
     uint32_t bg_color;
     uint32_t hover_bg_color;
@@ -38,7 +40,7 @@ typedef struct AromaTextbox
     uint32_t focused_border_color;
     uint32_t cursor_color;
     uint32_t placeholder_color;
-    char placeholder[AROMA_TEXTBOX_MAX_LENGTH];
+    AromaStr placeholder;
     AromaFont* font;
     float text_scale;
     int cursor_x;
@@ -70,6 +72,10 @@ void aroma_textbox_on_char(AromaNode* node, char character);
 
 void aroma_textbox_on_backspace(AromaNode* node);
 
+/* Freezes the caret (visible, not blinking) of the textbox focused in
+   window_id, e.g. when the window loses focus or the UI is idle-throttled. */
+void aroma_textbox_set_caret_blink_paused(size_t window_id, bool paused);
+
 void aroma_textbox_set_on_text_changed(AromaNode* node,
                                       bool (*callback)(AromaNode*, const char*, void*),
                                       void* user_data);
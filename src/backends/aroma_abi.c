@@ -23,6 +23,7 @@
 #include "graphics/aroma_graphics_interface.h"
 #include "platforms/aroma_platform_interface.h"
 #include <aroma_drawlist.h>
+#include <aroma_logger.h>
 #include <stdatomic.h>
 #include <stddef.h>
 
@@ -36,6 +37,18 @@ static AromaGraphicsInterface* get_real_graphics_interface(void) {
    // return &aroma_graphics_glps;
 }
 
+/*
+ * Workers recording in parallel must not reach the backend: its state is
+ * owned by the render thread. Drawing calls record as usual; anything that
+ * would change backend state is refused here instead.
+ */
+static bool drawlist_proxy_refuse_on_worker(const char* call)
+{
+    if (!aroma_drawlist_is_worker()) return false;
+    LOG_WARNING("%s called while recording on a worker thread; ignored", call);
+    return true;
+}
+
 static void drawlist_proxy_clear(size_t window_id, uint32_t color)
 {
     #ifndef ESP32
@@ -81,6 +94,26 @@ static void drawlist_proxy_draw_hollow_rectangle(size_t window_id, int x, int y,
     }
 }
 
+static void drawlist_proxy_draw_rectangles(size_t window_id, const AromaRectBatchItem* rects, size_t count)
+{
+    AromaDrawList* list = aroma_drawlist_get_active();
+    AromaGraphicsInterface* real = list ? NULL : get_real_graphics_interface();
+    if (real && real->draw_rectangles) {
+        real->draw_rectangles(window_id, rects, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const AromaRectBatchItem* r = &rects[i];
+        if (r->border_width > 0) {
+            drawlist_proxy_draw_hollow_rectangle(window_id, r->x, r->y, r->width, r->height, r->color,
+                                                 r->border_width, r->is_rounded, r->corner_radius);
+        } else {
+            drawlist_proxy_fill_rectangle(window_id, r->x, r->y, r->width, r->height, r->color,
+                                          r->is_rounded, r->corner_radius);
+        }
+    }
+}
+
 static void drawlist_proxy_draw_arc(size_t window_id, int cx, int cy, int radius,
                                     float start_angle, float end_angle, uint32_t color, int thickness)
 {
@@ -119,6 +152,7 @@ static float drawlist_proxy_measure_text(size_t window_id, AromaFont* font, cons
 
 static unsigned int drawlist_proxy_load_image(const char* image_path)
 {
+    if (drawlist_proxy_refuse_on_worker("load_image")) return 0;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if(real && real->load_image)
     {
@@ -128,6 +162,7 @@ static unsigned int drawlist_proxy_load_image(const char* image_path)
 
 static void drawlist_proxy_unload_image(unsigned int texture_id)
 {
+    if (drawlist_proxy_refuse_on_worker("unload_image")) return;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if(real && real->unload_image)
     {
@@ -141,6 +176,7 @@ static unsigned int drawlist_proxy_load_image_from_memory(unsigned char* data, s
 static unsigned int drawlist_proxy_load_image_from_memory(const uint16_t* data, size_t binary_length)
 #endif
 {
+    if (drawlist_proxy_refuse_on_worker("load_image_from_memory")) return 0;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if(real && real->load_image_from_memory)
     {
@@ -162,6 +198,7 @@ static void drawlist_proxy_draw_image(size_t window_id, int x, int y, int width,
     }
 }
 static void drawlist_proxy_graphics_set_tft_context(void* tft) {
+    if (drawlist_proxy_refuse_on_worker("graphics_set_tft_context")) return;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->graphics_set_tft_context) {
         real->graphics_set_tft_context(tft);
@@ -169,6 +206,7 @@ static void drawlist_proxy_graphics_set_tft_context(void* tft) {
 }
 
 static void drawlist_proxy_graphics_set_sprite_mode(bool enable, void* sprite) {
+    if (drawlist_proxy_refuse_on_worker("graphics_set_sprite_mode")) return;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->graphics_set_sprite_mode) {
         real->graphics_set_sprite_mode(enable, sprite);
@@ -177,6 +215,7 @@ static void drawlist_proxy_graphics_set_sprite_mode(bool enable, void* sprite) {
 
 static int drawlist_proxy_setup_shared_window_resources(void)
 {
+    if (drawlist_proxy_refuse_on_worker("setup_shared_window_resources")) return 0;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->setup_shared_window_resources) {
         return real->setup_shared_window_resources();
@@ -186,6 +225,7 @@ static int drawlist_proxy_setup_shared_window_resources(void)
 
 static int drawlist_proxy_setup_separate_window_resources(size_t window_id)
 {
+    if (drawlist_proxy_refuse_on_worker("setup_separate_window_resources")) return 0;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->setup_separate_window_resources) {
         return real->setup_separate_window_resources(window_id);
@@ -193,6 +233,33 @@ static int drawlist_proxy_setup_separate_window_resources(size_t window_id)
     return 0;
 }
 
+/* Backend clips are absolute, so while recording they replace the list's clip. */
+static void drawlist_proxy_set_draw_clip(size_t window_id, int x, int y, int width, int height)
+{
+    AromaDrawList* list = aroma_drawlist_get_active();
+    if (list) {
+        aroma_drawlist_cmd_set_clip(list, true, x, y, width, height);
+        return;
+    }
+    AromaGraphicsInterface* real = get_real_graphics_interface();
+    if (real && real->set_draw_clip) {
+        real->set_draw_clip(window_id, x, y, width, height);
+    }
+}
+
+static void drawlist_proxy_clear_draw_clip(size_t window_id)
+{
+    AromaDrawList* list = aroma_drawlist_get_active();
+    if (list) {
+        aroma_drawlist_cmd_set_clip(list, false, 0, 0, 0, 0);
+        return;
+    }
+    AromaGraphicsInterface* real = get_real_graphics_interface();
+    if (real && real->clear_draw_clip) {
+        real->clear_draw_clip(window_id);
+    }
+}
+
 static void drawlist_proxy_shutdown(void)
 {
     AromaGraphicsInterface* real = get_real_graphics_interface();
@@ -202,6 +269,7 @@ static void drawlist_proxy_shutdown(void)
 }
 
 void drawlist_proxy_graphics_set_clip(int x, int y, int w, int h) {
+    if (drawlist_proxy_refuse_on_worker("graphics_set_clip")) return;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->graphics_set_clip) {
         real->graphics_set_clip(x, y, w, h);
@@ -209,6 +277,7 @@ void drawlist_proxy_graphics_set_clip(int x, int y, int w, int h) {
 }
 
 void drawlist_proxy_graphics_clear_clip(void) {
+    if (drawlist_proxy_refuse_on_worker("graphics_clear_clip")) return;
     AromaGraphicsInterface* real = get_real_graphics_interface();
     if (real && real->graphics_clear_clip) {
         real->graphics_clear_clip();
@@ -221,11 +290,14 @@ static AromaGraphicsInterface drawlist_proxy = {
     .clear = drawlist_proxy_clear,
     .fill_rectangle = drawlist_proxy_fill_rectangle,
     .draw_hollow_rectangle = drawlist_proxy_draw_hollow_rectangle,
+    .draw_rectangles = drawlist_proxy_draw_rectangles,
     .draw_arc = drawlist_proxy_draw_arc,
     .unload_image = drawlist_proxy_unload_image,
     .load_image = drawlist_proxy_load_image,
     .load_image_from_memory = drawlist_proxy_load_image_from_memory,
     .draw_image = drawlist_proxy_draw_image,
+    .set_draw_clip = drawlist_proxy_set_draw_clip,
+    .clear_draw_clip = drawlist_proxy_clear_draw_clip,
     .render_text = drawlist_proxy_render_text,
     .measure_text = drawlist_proxy_measure_text,
     .shutdown = drawlist_proxy_shutdown,
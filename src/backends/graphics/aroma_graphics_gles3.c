@@ -25,6 +25,7 @@
 #include "aroma_abi.h"
 #include "core/aroma_logger.h"
 #include "core/aroma_font.h"
+#include "core/aroma_memory.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <math.h>
@@ -48,6 +49,10 @@ typedef struct
 {
     GLuint text_programs[256];
     GLuint shape_program;
+    struct {
+        GLint projection, use_texture, size, radius, border_width;
+        GLint is_rounded, is_hollow, shape_type, tex;
+    } shape_uniforms;
     GLuint text_vbo;
     GLuint shape_vbo;
     GLuint text_vaos[256];
@@ -65,6 +70,48 @@ typedef struct
 
 static AromaGLES3Context ctx = {0};
 
+/* GLES 3.0 cannot query a texture's size back, so remember what each
+   uploaded image costs for the memory report. */
+typedef struct {
+    GLuint texture;
+    size_t bytes;
+} AromaGLES3TextureSize;
+
+static AromaGLES3TextureSize* g_texture_sizes = NULL;
+static size_t g_texture_size_count = 0;
+static size_t g_texture_size_capacity = 0;
+
+/* Vertices for draw_rectangles, kept between frames so batches do not allocate. */
+static Vertex* g_batch_vertices = NULL;
+static size_t g_batch_vertex_capacity = 0;
+
+static void __gles3_track_texture(GLuint texture, int width, int height, int channels)
+{
+    /* A full mip chain adds a third on top of the base level. */
+    size_t bytes = (size_t)width * (size_t)height * (size_t)channels;
+    bytes += bytes / 3;
+    if (g_texture_size_count == g_texture_size_capacity) {
+        size_t capacity = g_texture_size_capacity ? g_texture_size_capacity * 2 : 16;
+        AromaGLES3TextureSize* sizes = realloc(g_texture_sizes, capacity * sizeof(AromaGLES3TextureSize));
+        if (!sizes) return;
+        g_texture_sizes = sizes;
+        g_texture_size_capacity = capacity;
+    }
+    g_texture_sizes[g_texture_size_count++] = (AromaGLES3TextureSize){ texture, bytes };
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, (ptrdiff_t)bytes);
+}
+
+static void __gles3_untrack_texture(GLuint texture)
+{
+    for (size_t i = 0; i < g_texture_size_count; i++) {
+        if (g_texture_sizes[i].texture == texture) {
+            aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, -(ptrdiff_t)g_texture_sizes[i].bytes);
+            g_texture_sizes[i] = g_texture_sizes[--g_texture_size_count];
+            return;
+        }
+    }
+}
+
 int setup_shared_window_resources(void)
 {
      glGenBuffers(1, &ctx.text_vbo);
@@ -122,6 +169,17 @@ int setup_shared_window_resources(void)
 
     glDeleteShader(shape_vertex_shader);
     glDeleteShader(shape_fragment_shader);
+
+    /* Looked up once; every shape draw sets some of these. */
+    ctx.shape_uniforms.projection = glGetUniformLocation(ctx.shape_program, "projection");
+    ctx.shape_uniforms.use_texture = glGetUniformLocation(ctx.shape_program, "useTexture");
+    ctx.shape_uniforms.size = glGetUniformLocation(ctx.shape_program, "size");
+    ctx.shape_uniforms.radius = glGetUniformLocation(ctx.shape_program, "radius");
+    ctx.shape_uniforms.border_width = glGetUniformLocation(ctx.shape_program, "borderWidth");
+    ctx.shape_uniforms.is_rounded = glGetUniformLocation(ctx.shape_program, "isRounded");
+    ctx.shape_uniforms.is_hollow = glGetUniformLocation(ctx.shape_program, "isHollow");
+    ctx.shape_uniforms.shape_type = glGetUniformLocation(ctx.shape_program, "shapeType");
+    ctx.shape_uniforms.tex = glGetUniformLocation(ctx.shape_program, "tex");
     return 1;
 }
 
@@ -236,14 +294,14 @@ void fill_rectangle(size_t window_id, int x, int y, int width, int height, uint3
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
 
     glUseProgram(ctx.shape_program);
-    glUniformMatrix4fv(glGetUniformLocation(ctx.shape_program, "projection"), 1, GL_FALSE, (const GLfloat*)projection);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "useTexture"), 0);
-    glUniform2f(glGetUniformLocation(ctx.shape_program, "size"), width, height);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "radius"), cornerRadius);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "borderWidth"), 1.0f);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isRounded"), isRounded ? 1 : 0);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isHollow"), 0);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "shapeType"), 0);
+    glUniformMatrix4fv(ctx.shape_uniforms.projection, 1, GL_FALSE, (const GLfloat*)projection);
+    glUniform1i(ctx.shape_uniforms.use_texture, 0);
+    glUniform2f(ctx.shape_uniforms.size, width, height);
+    glUniform1f(ctx.shape_uniforms.radius, cornerRadius);
+    glUniform1f(ctx.shape_uniforms.border_width, 1.0f);
+    glUniform1i(ctx.shape_uniforms.is_rounded, isRounded ? 1 : 0);
+    glUniform1i(ctx.shape_uniforms.is_hollow, 0);
+    glUniform1i(ctx.shape_uniforms.shape_type, 0);
 
     glBindVertexArray(ctx.shape_vaos[window_id]);
     glEnableVertexAttribArray(0);
@@ -261,6 +319,12 @@ void fill_rectangle(size_t window_id, int x, int y, int width, int height, uint3
 
 static void shutdown(void)
 {
+    if (g_batch_vertices) {
+        aroma_memory_track(AROMA_MEMORY_DRAWLIST, -(ptrdiff_t)(g_batch_vertex_capacity * sizeof(Vertex)), 0);
+        free(g_batch_vertices);
+        g_batch_vertices = NULL;
+        g_batch_vertex_capacity = 0;
+    }
     for (int i = 0; i < 256; i++) {
         gles3_text_renderer_cleanup(&ctx.text_renderers[i]);
         if (ctx.text_programs[i]) {
@@ -390,14 +454,14 @@ static void draw_hollow_rectangle(size_t window_id, int x, int y, int width, int
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
 
     glUseProgram(ctx.shape_program);
-    glUniformMatrix4fv(glGetUniformLocation(ctx.shape_program, "projection"), 1, GL_FALSE, (const GLfloat*)projection);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "useTexture"), 0);
-    glUniform2f(glGetUniformLocation(ctx.shape_program, "size"), (float)width, (float)height);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "radius"), cornerRadius);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "borderWidth"), (float)border_width);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isRounded"), isRounded ? 1 : 0);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isHollow"), 1);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "shapeType"), 0);
+    glUniformMatrix4fv(ctx.shape_uniforms.projection, 1, GL_FALSE, (const GLfloat*)projection);
+    glUniform1i(ctx.shape_uniforms.use_texture, 0);
+    glUniform2f(ctx.shape_uniforms.size, (float)width, (float)height);
+    glUniform1f(ctx.shape_uniforms.radius, cornerRadius);
+    glUniform1f(ctx.shape_uniforms.border_width, (float)border_width);
+    glUniform1i(ctx.shape_uniforms.is_rounded, isRounded ? 1 : 0);
+    glUniform1i(ctx.shape_uniforms.is_hollow, 1);
+    glUniform1i(ctx.shape_uniforms.shape_type, 0);
 
     glBindVertexArray(ctx.shape_vaos[window_id]);
     glEnableVertexAttribArray(0);
@@ -414,6 +478,114 @@ static void draw_hollow_rectangle(size_t window_id, int x, int y, int width, int
     glBindVertexArray(0);
 }
 
+static bool __gles3_same_shape(const AromaRectBatchItem* a, const AromaRectBatchItem* b)
+{
+    return a->width == b->width && a->height == b->height && a->border_width == b->border_width &&
+           a->is_rounded == b->is_rounded && a->corner_radius == b->corner_radius;
+}
+
+/*
+ * Uploads every quad once and binds the program, VAO and projection once.
+ * The SDF uniforms still describe a single shape, so consecutive rectangles
+ * of the same size and style share one glDrawArrays.
+ */
+static void draw_rectangles(size_t window_id, const AromaRectBatchItem* rects, size_t count)
+{
+    if (!rects || count == 0) return;
+
+    AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
+    if (!platform || !platform->make_context_current || !platform->get_window_size) {
+        LOG_ERROR("Platform interface missing required functions for rectangle draw");
+        return;
+    }
+
+    platform->make_context_current(window_id);
+
+    int window_width = 0;
+    int window_height = 0;
+    platform->get_window_size(window_id, &window_width, &window_height);
+    if (window_width <= 0 || window_height <= 0) {
+        LOG_WARNING("Skipping rectangle batch due to invalid window size (%d x %d)", window_width, window_height);
+        return;
+    }
+
+    size_t needed = count * 6;
+    if (needed > g_batch_vertex_capacity) {
+        size_t capacity = g_batch_vertex_capacity ? g_batch_vertex_capacity : 384;
+        while (capacity < needed) capacity *= 2;
+        Vertex* next = realloc(g_batch_vertices, capacity * sizeof(Vertex));
+        if (!next) return;
+        aroma_memory_track(AROMA_MEMORY_DRAWLIST,
+                           (ptrdiff_t)((capacity - g_batch_vertex_capacity) * sizeof(Vertex)), 0);
+        g_batch_vertices = next;
+        g_batch_vertex_capacity = capacity;
+    }
+
+    static const float tex_coords[6][2] = {
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    for (size_t r = 0; r < count; r++) {
+        vec3 color_rgb;
+        convert_hex_to_rgb(&color_rgb, rects[r].color);
+        float x0 = (float)rects[r].x;
+        float y0 = (float)rects[r].y;
+        float x1 = x0 + (float)rects[r].width;
+        float y1 = y0 + (float)rects[r].height;
+        const float positions[6][2] = {{x0, y0}, {x1, y0}, {x0, y1}, {x1, y0}, {x1, y1}, {x0, y1}};
+        Vertex* v = &g_batch_vertices[r * 6];
+        for (int i = 0; i < 6; i++) {
+            v[i].pos[0] = positions[i][0];
+            v[i].pos[1] = positions[i][1];
+            v[i].col[0] = color_rgb[0];
+            v[i].col[1] = color_rgb[1];
+            v[i].col[2] = color_rgb[2];
+            v[i].texCoord[0] = tex_coords[i][0];
+            v[i].texCoord[1] = tex_coords[i][1];
+        }
+    }
+
+    glViewport(0, 0, window_width, window_height);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    mat4x4 projection;
+    mat4x4_ortho(projection, 0.0f, (float)window_width, (float)window_height, 0.0f, -1.0f, 1.0f);
+
+    glBindBuffer(GL_ARRAY_BUFFER, ctx.shape_vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(needed * sizeof(Vertex)), g_batch_vertices, GL_DYNAMIC_DRAW);
+
+    glUseProgram(ctx.shape_program);
+    glUniformMatrix4fv(ctx.shape_uniforms.projection, 1, GL_FALSE, (const GLfloat*)projection);
+    glUniform1i(ctx.shape_uniforms.use_texture, 0);
+    glUniform1i(ctx.shape_uniforms.shape_type, 0);
+
+    glBindVertexArray(ctx.shape_vaos[window_id]);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, pos));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, col));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+
+    size_t run = 0;
+    for (size_t r = 1; r <= count; r++) {
+        if (r < count && __gles3_same_shape(&rects[run], &rects[r])) continue;
+        const AromaRectBatchItem* shape = &rects[run];
+        bool hollow = shape->border_width > 0;
+        glUniform2f(ctx.shape_uniforms.size, (float)shape->width, (float)shape->height);
+        glUniform1f(ctx.shape_uniforms.radius, shape->corner_radius);
+        glUniform1f(ctx.shape_uniforms.border_width, hollow ? (float)shape->border_width : 1.0f);
+        glUniform1i(ctx.shape_uniforms.is_rounded, shape->is_rounded ? 1 : 0);
+        glUniform1i(ctx.shape_uniforms.is_hollow, hollow ? 1 : 0);
+        glDrawArrays(GL_TRIANGLES, (GLint)(run * 6), (GLsizei)((r - run) * 6));
+        run = r;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
 static void draw_arc(size_t window_id, int cx, int cy, int radius, float start_angle, float end_angle,
                      uint32_t color, int thickness)
 {
@@ -465,6 +637,7 @@ static int is_stb_supported_image_format(const char *path)
 
 void unload_image(unsigned int texture_id)
 {
+    __gles3_untrack_texture(texture_id);
     glDeleteTextures(1, &texture_id);
 }
 
@@ -686,6 +859,8 @@ unsigned int load_image(const char* image_path)
         return 0;
     }
 
+    __gles3_track_texture(texture, img_width, img_height, nrChannels);
+
     LOG_INFO("Texture %u successfully created: %s (%dx%d)",
              texture, image_path, img_width, img_height);
 
@@ -736,6 +911,7 @@ unsigned int load_image_from_memory(unsigned char* data, size_t binary_length)
     glGenerateMipmap(GL_TEXTURE_2D);
 
     stbi_image_free(img_data);
+    __gles3_track_texture(texture, width, height, channels);
 
     LOG_INFO("Successfully loaded texture from memory (ID: %u, %dx%d, %d channels)",
              texture, width, height, channels);
@@ -819,19 +995,19 @@ void draw_image(size_t window_id, int x, int y, int width, int height, unsigned
 
     glUseProgram(ctx.shape_program);
 
-    glUniformMatrix4fv(glGetUniformLocation(ctx.shape_program, "projection"),
+    glUniformMatrix4fv(ctx.shape_uniforms.projection,
                       1, GL_FALSE, (const GLfloat*)projection);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "useTexture"), 1);
-    glUniform2f(glGetUniformLocation(ctx.shape_program, "size"), 0.0f, 0.0f);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "radius"), 0.0f);
-    glUniform1f(glGetUniformLocation(ctx.shape_program, "borderWidth"), 0.0f);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isRounded"), 0);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "isHollow"), 0);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "shapeType"), 0);
+    glUniform1i(ctx.shape_uniforms.use_texture, 1);
+    glUniform2f(ctx.shape_uniforms.size, 0.0f, 0.0f);
+    glUniform1f(ctx.shape_uniforms.radius, 0.0f);
+    glUniform1f(ctx.shape_uniforms.border_width, 0.0f);
+    glUniform1i(ctx.shape_uniforms.is_rounded, 0);
+    glUniform1i(ctx.shape_uniforms.is_hollow, 0);
+    glUniform1i(ctx.shape_uniforms.shape_type, 0);
 
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, texture_id);
-    glUniform1i(glGetUniformLocation(ctx.shape_program, "tex"), 0);
+    glUniform1i(ctx.shape_uniforms.tex, 0);
 
     glBindVertexArray(ctx.shape_vaos[window_id]);
 
@@ -860,6 +1036,33 @@ void draw_image(size_t window_id, int x, int y, int width, int height, unsigned
 
     LOG_INFO("Image drawn successfully: texture %u", texture_id);
 }
+
+static void set_draw_clip(size_t window_id, int x, int y, int width, int height)
+{
+    AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
+    if (!platform || !platform->make_context_current || !platform->get_window_size) {
+        LOG_ERROR("Platform interface missing required functions for clipping");
+        return;
+    }
+
+    platform->make_context_current(window_id);
+
+    int window_width = 0;
+    int window_height = 0;
+    platform->get_window_size(window_id, &window_width, &window_height);
+
+    /* The scissor box counts rows up from the bottom of the window. */
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, window_height - (y + height), width > 0 ? width : 0, height > 0 ? height : 0);
+}
+
+static void clear_draw_clip(size_t window_id)
+{
+    AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
+    if (platform && platform->make_context_current) platform->make_context_current(window_id);
+    glDisable(GL_SCISSOR_TEST);
+}
+
 AromaGraphicsInterface aroma_graphics_gles3 = {
     .setup_shared_window_resources = setup_shared_window_resources,
     .setup_separate_window_resources = setup_separate_window_resources,
@@ -867,6 +1070,7 @@ AromaGraphicsInterface aroma_graphics_gles3 = {
     .draw_rectangle = draw_rectangle,
     .fill_rectangle = fill_rectangle,
     .draw_hollow_rectangle = draw_hollow_rectangle,
+    .draw_rectangles = draw_rectangles,
     .draw_arc = draw_arc,
     .render_text = render_text,
     .measure_text = measure_text,
@@ -874,6 +1078,8 @@ AromaGraphicsInterface aroma_graphics_gles3 = {
     .load_image = load_image,
     .load_image_from_memory = load_image_from_memory,
     .draw_image = draw_image,
+    .set_draw_clip = set_draw_clip,
+    .clear_draw_clip = clear_draw_clip,
     .shutdown = shutdown
 };
 #endif
@@ -11,6 +11,16 @@ extern "C" {
 
 typedef struct AromaFont AromaFont;
 
+/* One rectangle of a batch; filled when border_width is 0, hollow otherwise. */
+typedef struct AromaRectBatchItem {
+    int x, y;
+    int width, height;
+    uint32_t color;
+    int border_width;
+    bool is_rounded;
+    float corner_radius;
+} AromaRectBatchItem;
+
 typedef struct AromaGraphicsInterface {
 
     int  (*setup_shared_window_resources)(void);
@@ -44,6 +54,14 @@ typedef struct AromaGraphicsInterface {
         float cornerRadius
     );
 
+    /* Optional. Draws `count` rectangles in array order with shared state;
+       the drawlist falls back to one call per rectangle without it. */
+    void (*draw_rectangles)(
+        size_t window_id,
+        const AromaRectBatchItem* rects,
+        size_t count
+    );
+
     void (*draw_arc)(
         size_t window_id,
         int cx, int cy,
@@ -92,6 +110,11 @@ typedef struct AromaGraphicsInterface {
         unsigned int texture_id
     );
 
+    /* Clips the draws that follow to a rectangle in window coordinates,
+       already intersected with any enclosing clip; clear_draw_clip lifts it. */
+    void (*set_draw_clip)(size_t window_id, int x, int y, int width, int height);
+    void (*clear_draw_clip)(size_t window_id);
+
     void (*graphics_set_tft_context)(void* tft);
 
     void (*graphics_set_sprite_mode)(
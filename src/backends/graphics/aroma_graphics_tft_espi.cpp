@@ -56,6 +56,28 @@ void graphics_clear_clip(void) {
     g_clip.enabled = false;
 }
 
+/* The sprite holds one tile whose origin g_clip gives; clips stay in window
+   coordinates, so they are moved into the sprite like every draw. */
+void set_draw_clip(size_t window_id, int x, int y, int w, int h) {
+    if (window_id != 0 || !g_tft) return;
+    if (w < 0) w = 0;
+    if (h < 0) h = 0;
+    if (USING_SPRITE()) {
+        g_sprite->setViewport(x - g_clip.x, y - g_clip.y, w, h, false);
+    } else {
+        g_tft->setViewport(x, y, w, h, false);
+    }
+}
+
+void clear_draw_clip(size_t window_id) {
+    if (window_id != 0 || !g_tft) return;
+    if (USING_SPRITE()) {
+        g_sprite->resetViewport();
+    } else {
+        g_tft->resetViewport();
+    }
+}
+
 void graphics_set_tft_context(void* tft) {
     if (!tft) return;
     g_tft = (TFT_eSPI*)tft;
@@ -94,7 +116,9 @@ void fill_rectangle(size_t window_id, int x, int y, int w, int h,
     int r = (int)radius;
                         
     AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
-    if(platform && platform->tft_mark_tiles_dirty) {
+    /* During a tiled flush the damage tiles are already chosen; marking here
+       would drag every tile a large fill touches into the same frame. */
+    if(!USING_SPRITE() && platform && platform->tft_mark_tiles_dirty) {
         platform->tft_mark_tiles_dirty(y, h);
     }
        
@@ -155,7 +179,7 @@ void draw_arc(size_t window_id, int cx, int cy, int r,
     int e = (int)(a1 * 180.0f / M_PI);
 
     AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
-    if(platform && platform->tft_mark_tiles_dirty)
+    if(!USING_SPRITE() && platform && platform->tft_mark_tiles_dirty)
         platform->tft_mark_tiles_dirty(cy, r*2); //TODO: better estimate
 
 
@@ -183,7 +207,7 @@ void render_text(size_t window_id, AromaFont* font,
     int ascender    = 14;
     int line_height = 18;
 
-    if (platform && platform->tft_mark_tiles_dirty) {
+    if (!USING_SPRITE() && platform && platform->tft_mark_tiles_dirty) {
         platform->tft_mark_tiles_dirty(
             y,
             line_height
@@ -290,6 +314,8 @@ AromaGraphicsInterface aroma_graphics_tft = {
     .load_image                      = load_image,
     .load_image_from_memory          = load_image_from_memory,
     .draw_image                      = draw_image,
+    .set_draw_clip                   = set_draw_clip,
+    .clear_draw_clip                 = clear_draw_clip,
     .graphics_set_tft_context        = graphics_set_tft_context,
     .graphics_set_sprite_mode        = graphics_set_sprite_mode,
     .graphics_set_clip               = graphics_set_clip,
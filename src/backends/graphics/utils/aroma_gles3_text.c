@@ -22,6 +22,7 @@
 #include "aroma_gles3_text.h"
 #include "helpers_gles3.h"
 #include "core/aroma_logger.h"
+#include "core/aroma_memory.h"
 #include "aroma_abi.h"
 #include <string.h>
 #include <stdlib.h>
@@ -103,6 +104,7 @@ void gles3_text_renderer_load_font(GLES3TextRenderer* renderer, FT_Face face) {
             glBindTexture(GL_TEXTURE_2D, 0);
 
             glyph.texture_id = texture;
+            aroma_memory_track(AROMA_MEMORY_GLYPHS, 0, (ptrdiff_t)glyph.width * glyph.height);
         }
 
         renderer->glyphs[glyph_index] = glyph;
@@ -246,6 +248,7 @@ void gles3_text_renderer_cleanup(GLES3TextRenderer* renderer) {
 
     for (int i = 0; i < renderer->glyph_count; i++) {
         if (renderer->glyphs[i].texture_id) {
+            aroma_memory_track(AROMA_MEMORY_GLYPHS, 0, -(ptrdiff_t)renderer->glyphs[i].width * renderer->glyphs[i].height);
             glDeleteTextures(1, &renderer->glyphs[i].texture_id);
         }
     }
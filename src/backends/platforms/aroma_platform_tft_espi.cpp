@@ -2,6 +2,7 @@
 #include "backends/graphics/aroma_graphics_interface.h"
 #include "backends/platforms/aroma_platform_interface.h"
 #include "core/aroma_logger.h"
+#include "core/aroma_drawlist.h"
 
 #include <Arduino.h>
 #include <TFT_eSPI.h>
@@ -158,9 +159,7 @@ void get_window_size(size_t window_id, int* w, int* h) {
 void request_window_update(size_t window_id) {
     if (window_id != 0) return;
 
-    for(int i=0; i<MAX_TILES; i++) {
-        g_tile_dirty[i] = true;
-    }
+    /* Tiles are marked from the frame's damage region in aroma_ui_end_frame. */
     if (g_update_callback) {
         g_update_callback(0, g_callback_data);
     }
@@ -179,6 +178,7 @@ void call_flush_function_ptr(
     if (!gfx) return;
 
     gfx->graphics_set_sprite_mode(true, g_sprite);
+    aroma_drawlist_bin_tiles((AromaDrawList*) list, TILE_H, full_height);
 
     int num_tiles = (full_height + TILE_H - 1) / TILE_H;
     for (int ty = 0; ty < num_tiles; ty++) {
@@ -0,0 +1,303 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_alloc_profile.h"
+
+#ifdef AROMA_ALLOC_PROFILE
+
+#include "core/aroma_logger.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AROMA_ALLOC_PROFILE_NO_SITE 0xFFFF
+
+typedef struct AromaAllocLiveEntry {
+    uintptr_t ptr;      /* 0 = empty, 1 = tombstone */
+    uint32_t size;
+    uint16_t site;
+    uint8_t type;
+} AromaAllocLiveEntry;
+
+static pthread_mutex_t g_profile_mutex = PTHREAD_MUTEX_INITIALIZER;
+static AromaAllocSiteStats g_sites[AROMA_ALLOC_PROFILE_MAX_SITES];
+static size_t g_site_count = 0;
+static AromaAllocTypeStats g_types[AROMA_ALLOC_PROFILE_TYPE_COUNT];
+static AromaAllocLiveEntry g_live[AROMA_ALLOC_PROFILE_MAX_LIVE];
+static size_t g_untracked = 0;
+
+static inline size_t __profile_hash(uintptr_t ptr) {
+    /* Slab objects are 16-byte aligned; fold the low bits away first. */
+    uint64_t h = (uint64_t)(ptr >> 4) * 0x9E3779B97F4A7C15ull;
+    return (size_t)(h >> 32) & (AROMA_ALLOC_PROFILE_MAX_LIVE - 1);
+}
+
+static uint16_t __profile_site(const char* file, int line) {
+    for (size_t i = 0; i < g_site_count; i++) {
+        /* __FILE__ literals of one translation unit share an address. */
+        if (g_sites[i].line == line && (g_sites[i].file == file || strcmp(g_sites[i].file, file) == 0)) {
+            return (uint16_t)i;
+        }
+    }
+    if (g_site_count == AROMA_ALLOC_PROFILE_MAX_SITES) return AROMA_ALLOC_PROFILE_NO_SITE;
+    AromaAllocSiteStats* site = &g_sites[g_site_count];
+    memset(site, 0, sizeof(*site));
+    site->file = file;
+    site->line = line;
+    return (uint16_t)g_site_count++;
+}
+
+static AromaAllocLiveEntry* __profile_find(uintptr_t ptr) {
+    size_t index = __profile_hash(ptr);
+    for (size_t probe = 0; probe < AROMA_ALLOC_PROFILE_MAX_LIVE; probe++) {
+        AromaAllocLiveEntry* entry = &g_live[(index + probe) & (AROMA_ALLOC_PROFILE_MAX_LIVE - 1)];
+        if (entry->ptr == ptr) return entry;
+        if (entry->ptr == 0) return NULL;
+    }
+    return NULL;
+}
+
+static void __profile_type_add(uint8_t type, size_t size) {
+    AromaAllocTypeStats* stats = &g_types[type];
+    stats->live_count++;
+    stats->live_bytes += size;
+    if (stats->live_bytes > stats->peak_live_bytes) stats->peak_live_bytes = stats->live_bytes;
+}
+
+static void __profile_type_remove(uint8_t type, size_t size) {
+    g_types[type].live_count--;
+    g_types[type].live_bytes -= size;
+}
+
+void aroma_alloc_profile_record_alloc(void* ptr, size_t size, const char* file, int line) {
+    if (!ptr) return;
+    pthread_mutex_lock(&g_profile_mutex);
+    uint16_t site_index = __profile_site(file ? file : "?", line);
+    if (site_index != AROMA_ALLOC_PROFILE_NO_SITE) {
+        AromaAllocSiteStats* site = &g_sites[site_index];
+        site->allocs++;
+        site->live_count++;
+        site->live_bytes += size;
+        site->total_bytes += size;
+        if (site->live_bytes > site->peak_live_bytes) site->peak_live_bytes = site->live_bytes;
+    }
+
+    size_t index = __profile_hash((uintptr_t)ptr);
+    AromaAllocLiveEntry* slot = NULL;
+    for (size_t probe = 0; probe < AROMA_ALLOC_PROFILE_MAX_LIVE; probe++) {
+        AromaAllocLiveEntry* entry = &g_live[(index + probe) & (AROMA_ALLOC_PROFILE_MAX_LIVE - 1)];
+        if (entry->ptr <= 1) {
+            slot = entry;
+            break;
+        }
+    }
+    if (slot) {
+        slot->ptr = (uintptr_t)ptr;
+        slot->size = (uint32_t)size;
+        slot->site = site_index;
+        slot->type = AROMA_ALLOC_PROFILE_UNTAGGED;
+        __profile_type_add(AROMA_ALLOC_PROFILE_UNTAGGED, size);
+    } else {
+        g_untracked++;
+    }
+    pthread_mutex_unlock(&g_profile_mutex);
+}
+
+void aroma_alloc_profile_record_free(void* ptr) {
+    if (!ptr) return;
+    pthread_mutex_lock(&g_profile_mutex);
+    AromaAllocLiveEntry* entry = __profile_find((uintptr_t)ptr);
+    if (entry) {
+        if (entry->site != AROMA_ALLOC_PROFILE_NO_SITE) {
+            AromaAllocSiteStats* site = &g_sites[entry->site];
+            site->frees++;
+            site->live_count--;
+            site->live_bytes -= entry->size;
+        }
+        __profile_type_remove(entry->type, entry->size);
+        entry->ptr = 1;
+    }
+    pthread_mutex_unlock(&g_profile_mutex);
+}
+
+void aroma_alloc_profile_tag(void* ptr, int node_type) {
+    if (!ptr || node_type < 0 || node_type >= AROMA_ALLOC_PROFILE_UNTAGGED) return;
+    pthread_mutex_lock(&g_profile_mutex);
+    AromaAllocLiveEntry* entry = __profile_find((uintptr_t)ptr);
+    if (entry && entry->type != (uint8_t)node_type) {
+        __profile_type_remove(entry->type, entry->size);
+        entry->type = (uint8_t)node_type;
+        __profile_type_add(entry->type, entry->size);
+    }
+    pthread_mutex_unlock(&g_profile_mutex);
+}
+
+void aroma_alloc_profile_reset(void) {
+    pthread_mutex_lock(&g_profile_mutex);
+    memset(g_sites, 0, sizeof(g_sites));
+    memset(g_types, 0, sizeof(g_types));
+    memset(g_live, 0, sizeof(g_live));
+    g_site_count = 0;
+    g_untracked = 0;
+    pthread_mutex_unlock(&g_profile_mutex);
+}
+
+static AromaAllocProfileSort g_sort_key;
+
+static size_t __profile_sort_value(const AromaAllocSiteStats* site) {
+    switch (g_sort_key) {
+        case AROMA_ALLOC_SORT_TOTAL_BYTES: return site->total_bytes;
+        case AROMA_ALLOC_SORT_ALLOCS: return site->allocs;
+        case AROMA_ALLOC_SORT_LIVE_BYTES:
+        default: return site->live_bytes;
+    }
+}
+
+static int __profile_site_compare(const void* a, const void* b) {
+    size_t va = __profile_sort_value((const AromaAllocSiteStats*)a);
+    size_t vb = __profile_sort_value((const AromaAllocSiteStats*)b);
+    return (va < vb) - (va > vb);
+}
+
+size_t aroma_alloc_profile_get_sites(AromaAllocSiteStats* out, size_t max, AromaAllocProfileSort sort) {
+    if (!out || max == 0) return 0;
+    AromaAllocSiteStats sorted[AROMA_ALLOC_PROFILE_MAX_SITES];
+    pthread_mutex_lock(&g_profile_mutex);
+    size_t count = g_site_count;
+    memcpy(sorted, g_sites, count * sizeof(AromaAllocSiteStats));
+    g_sort_key = sort;
+    qsort(sorted, count, sizeof(AromaAllocSiteStats), __profile_site_compare);
+    pthread_mutex_unlock(&g_profile_mutex);
+
+    if (count > max) count = max;
+    memcpy(out, sorted, count * sizeof(AromaAllocSiteStats));
+    return count;
+}
+
+AromaAllocTypeStats aroma_alloc_profile_get_type(int node_type) {
+    AromaAllocTypeStats stats = {0};
+    if (node_type < 0 || node_type >= AROMA_ALLOC_PROFILE_TYPE_COUNT) return stats;
+    pthread_mutex_lock(&g_profile_mutex);
+    stats = g_types[node_type];
+    pthread_mutex_unlock(&g_profile_mutex);
+    return stats;
+}
+
+size_t aroma_alloc_profile_untracked(void) {
+    pthread_mutex_lock(&g_profile_mutex);
+    size_t untracked = g_untracked;
+    pthread_mutex_unlock(&g_profile_mutex);
+    return untracked;
+}
+
+static const char* __profile_basename(const char* path) {
+    const char* base = path;
+    for (const char* p = path; *p; p++) {
+        if (*p == '/' || *p == '\\') base = p + 1;
+    }
+    return base;
+}
+
+static const char* const TYPE_NAMES[AROMA_ALLOC_PROFILE_TYPE_COUNT] = {"root", "container", "widget", "untagged"};
+
+void aroma_alloc_profile_report(AromaAllocProfileSort sort, size_t max_sites) {
+    AromaAllocSiteStats sites[AROMA_ALLOC_PROFILE_MAX_SITES];
+    if (max_sites == 0 || max_sites > AROMA_ALLOC_PROFILE_MAX_SITES) max_sites = AROMA_ALLOC_PROFILE_MAX_SITES;
+    size_t count = aroma_alloc_profile_get_sites(sites, max_sites, sort);
+
+    LOG_INFO("=== Allocation Profile ===");
+    for (size_t i = 0; i < count; i++) {
+        LOG_INFO("  %s:%d  live %zu (%zu bytes, peak %zu)  allocs %zu  frees %zu  total %zu bytes",
+                 __profile_basename(sites[i].file), sites[i].line, sites[i].live_count, sites[i].live_bytes,
+                 sites[i].peak_live_bytes, sites[i].allocs, sites[i].frees, sites[i].total_bytes);
+    }
+    LOG_INFO("By node type:");
+    for (int t = 0; t < AROMA_ALLOC_PROFILE_TYPE_COUNT; t++) {
+        AromaAllocTypeStats stats = aroma_alloc_profile_get_type(t);
+        LOG_INFO("  %-9s live %zu (%zu bytes, peak %zu)", TYPE_NAMES[t], stats.live_count, stats.live_bytes,
+                 stats.peak_live_bytes);
+    }
+    size_t untracked = aroma_alloc_profile_untracked();
+    if (untracked) LOG_INFO("Untracked allocations: %zu (raise AROMA_ALLOC_PROFILE_MAX_LIVE)", untracked);
+    LOG_INFO("=== End Allocation Profile ===");
+}
+
+void aroma_alloc_profile_snapshot(AromaAllocSnapshot* snapshot) {
+    if (!snapshot) return;
+    pthread_mutex_lock(&g_profile_mutex);
+    snapshot->site_count = g_site_count;
+    memcpy(snapshot->sites, g_sites, g_site_count * sizeof(AromaAllocSiteStats));
+    memcpy(snapshot->types, g_types, sizeof(g_types));
+    pthread_mutex_unlock(&g_profile_mutex);
+}
+
+static int __profile_delta_compare(const void* a, const void* b) {
+    long long va = llabs(((const AromaAllocSiteDelta*)a)->live_bytes);
+    long long vb = llabs(((const AromaAllocSiteDelta*)b)->live_bytes);
+    return (va < vb) - (va > vb);
+}
+
+size_t aroma_alloc_profile_diff(const AromaAllocSnapshot* before, const AromaAllocSnapshot* after,
+                                AromaAllocSiteDelta* out, size_t max) {
+    if (!before || !after || !out || max == 0) return 0;
+    AromaAllocSiteDelta deltas[AROMA_ALLOC_PROFILE_MAX_SITES];
+    size_t count = 0;
+    /* Sites are only ever appended, so index i names the same site in both. */
+    for (size_t i = 0; i < after->site_count; i++) {
+        const AromaAllocSiteStats* now = &after->sites[i];
+        AromaAllocSiteStats then = {0};
+        if (i < before->site_count && before->sites[i].line == now->line) then = before->sites[i];
+        AromaAllocSiteDelta delta = {
+            .file = now->file,
+            .line = now->line,
+            .live_count = (long long)now->live_count - (long long)then.live_count,
+            .live_bytes = (long long)now->live_bytes - (long long)then.live_bytes,
+            .allocs = now->allocs - then.allocs,
+            .frees = now->frees - then.frees,
+        };
+        if (delta.live_bytes || delta.allocs || delta.frees) deltas[count++] = delta;
+    }
+    qsort(deltas, count, sizeof(AromaAllocSiteDelta), __profile_delta_compare);
+    if (count > max) count = max;
+    memcpy(out, deltas, count * sizeof(AromaAllocSiteDelta));
+    return count;
+}
+
+void aroma_alloc_profile_report_diff(const AromaAllocSnapshot* before, const AromaAllocSnapshot* after) {
+    AromaAllocSiteDelta deltas[AROMA_ALLOC_PROFILE_MAX_SITES];
+    size_t count = aroma_alloc_profile_diff(before, after, deltas, AROMA_ALLOC_PROFILE_MAX_SITES);
+    LOG_INFO("=== Allocation Diff ===");
+    for (size_t i = 0; i < count; i++) {
+        LOG_INFO("  %s:%d  %+lld objects, %+lld bytes  (%zu allocs, %zu frees)", __profile_basename(deltas[i].file),
+                 deltas[i].line, deltas[i].live_count, deltas[i].live_bytes, deltas[i].allocs, deltas[i].frees);
+    }
+    for (int t = 0; t < AROMA_ALLOC_PROFILE_TYPE_COUNT; t++) {
+        long long bytes = (long long)after->types[t].live_bytes - (long long)before->types[t].live_bytes;
+        if (bytes) LOG_INFO("  %-9s %+lld bytes", TYPE_NAMES[t], bytes);
+    }
+    LOG_INFO("=== End Allocation Diff ===");
+}
+
+#else
+
+typedef int __aroma_alloc_profile_disabled;
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_ALLOC_PROFILE_H
+#define AROMA_CORE_ALLOC_PROFILE_H
+
+#include <aroma_alloc_profile.h>
+
+#endif
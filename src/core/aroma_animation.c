@@ -0,0 +1,286 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_animation.h"
+#include "core/aroma_node.h"
+#include <string.h>
+
+typedef enum AromaAnimValueKind {
+    ANIM_VALUE_INT,
+    ANIM_VALUE_FLOAT,
+    ANIM_VALUE_COLOR
+} AromaAnimValueKind;
+
+typedef union AromaAnimValue {
+    int i;
+    float f;
+    uint32_t c;
+} AromaAnimValue;
+
+struct AromaAnimation {
+    AromaNode* node;
+    AromaRect damage;
+    AromaAnimValueKind kind;
+    void* value;
+    AromaAnimValue from;
+    AromaAnimValue to;
+    uint64_t start_ms;
+    uint32_t duration_ms;
+    AromaEasing easing;
+    bool started;
+    bool active;
+    AromaAnimationDoneCallback on_done;
+    void* user_data;
+};
+
+static struct AromaAnimation g_animations[AROMA_MAX_ANIMATIONS];
+static uint32_t g_active_count = 0;
+
+void aroma_animation_init(void) {
+    memset(g_animations, 0, sizeof(g_animations));
+    g_active_count = 0;
+}
+
+void aroma_animation_shutdown(void) {
+    memset(g_animations, 0, sizeof(g_animations));
+    g_active_count = 0;
+}
+
+float aroma_easing_apply(AromaEasing easing, float t) {
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+    switch (easing) {
+        case AROMA_EASE_IN_QUAD:
+            return t * t;
+        case AROMA_EASE_OUT_QUAD:
+            return t * (2.0f - t);
+        case AROMA_EASE_IN_OUT_QUAD:
+            return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case AROMA_EASE_OUT_CUBIC: {
+            float u = t - 1.0f;
+            return u * u * u + 1.0f;
+        }
+        case AROMA_EASE_IN_OUT_CUBIC:
+            if (t < 0.5f) return 4.0f * t * t * t;
+            {
+                float u = 2.0f * t - 2.0f;
+                return 0.5f * u * u * u + 1.0f;
+            }
+        case AROMA_EASE_LINEAR:
+        default:
+            return t;
+    }
+}
+
+static uint32_t __lerp_color(uint32_t from, uint32_t to, float k) {
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int a = (int)((from >> shift) & 0xFF);
+        int b = (int)((to >> shift) & 0xFF);
+        int c = a + (int)((float)(b - a) * k + (b >= a ? 0.5f : -0.5f));
+        out |= ((uint32_t)c & 0xFF) << shift;
+    }
+    return out;
+}
+
+static AromaAnimValue __read_value(const struct AromaAnimation* anim) {
+    AromaAnimValue v;
+    switch (anim->kind) {
+        case ANIM_VALUE_INT:   v.i = *(int*)anim->value; break;
+        case ANIM_VALUE_FLOAT: v.f = *(float*)anim->value; break;
+        default:               v.c = *(uint32_t*)anim->value; break;
+    }
+    return v;
+}
+
+/* Writes the eased value and reports whether the property actually changed. */
+static bool __write_value(struct AromaAnimation* anim, float k) {
+    switch (anim->kind) {
+        case ANIM_VALUE_INT: {
+            int* p = (int*)anim->value;
+            float delta = (float)(anim->to.i - anim->from.i) * k;
+            int next = anim->from.i + (int)(delta + (delta >= 0.0f ? 0.5f : -0.5f));
+            if (*p == next) return false;
+            *p = next;
+            return true;
+        }
+        case ANIM_VALUE_FLOAT: {
+            float* p = (float*)anim->value;
+            float next = anim->from.f + (anim->to.f - anim->from.f) * k;
+            if (*p == next) return false;
+            *p = next;
+            return true;
+        }
+        default: {
+            uint32_t* p = (uint32_t*)anim->value;
+            uint32_t next = __lerp_color(anim->from.c, anim->to.c, k);
+            if (*p == next) return false;
+            *p = next;
+            return true;
+        }
+    }
+}
+
+static void __damage(struct AromaAnimation* anim) {
+    if (anim->damage.width > 0 && anim->damage.height > 0) {
+        aroma_node_invalidate_rect(anim->node, anim->damage.x, anim->damage.y,
+                                   anim->damage.width, anim->damage.height);
+    } else {
+        aroma_node_invalidate(anim->node);
+    }
+}
+
+static AromaAnimation* __animate(AromaNode* node, AromaRect damage, AromaAnimValueKind kind,
+                                 void* value, AromaAnimValue to,
+                                 uint32_t duration_ms, AromaEasing easing) {
+    if (!node || !value) return NULL;
+
+    struct AromaAnimation* slot = NULL;
+    for (size_t i = 0; i < AROMA_MAX_ANIMATIONS; i++) {
+        if (g_animations[i].active && g_animations[i].value == value) {
+            slot = &g_animations[i];
+            break;
+        }
+    }
+
+    if (duration_ms == 0) {
+        if (slot) aroma_animation_cancel(slot);
+        struct AromaAnimation instant = { .node = node, .damage = damage, .kind = kind,
+                                          .value = value, .to = to };
+        instant.from = to;
+        if (__write_value(&instant, 1.0f)) __damage(&instant);
+        return NULL;
+    }
+
+    if (!slot) {
+        for (size_t i = 0; i < AROMA_MAX_ANIMATIONS; i++) {
+            if (!g_animations[i].active) {
+                slot = &g_animations[i];
+                g_active_count++;
+                break;
+            }
+        }
+    }
+    if (!slot) return NULL;
+
+    slot->node = node;
+    slot->damage = damage;
+    slot->kind = kind;
+    slot->value = value;
+    slot->from = __read_value(slot);
+    slot->to = to;
+    slot->start_ms = 0;
+    slot->duration_ms = duration_ms;
+    slot->easing = easing;
+    slot->started = false;
+    slot->active = true;
+    slot->on_done = NULL;
+    slot->user_data = NULL;
+    return slot;
+}
+
+AromaAnimation* aroma_animate_int(AromaNode* node, AromaRect damage, int* value, int to,
+                                  uint32_t duration_ms, AromaEasing easing) {
+    AromaAnimValue v = { .i = to };
+    return __animate(node, damage, ANIM_VALUE_INT, value, v, duration_ms, easing);
+}
+
+AromaAnimation* aroma_animate_float(AromaNode* node, AromaRect damage, float* value, float to,
+                                    uint32_t duration_ms, AromaEasing easing) {
+    AromaAnimValue v = { .f = to };
+    return __animate(node, damage, ANIM_VALUE_FLOAT, value, v, duration_ms, easing);
+}
+
+AromaAnimation* aroma_animate_color(AromaNode* node, AromaRect damage, uint32_t* value, uint32_t to,
+                                    uint32_t duration_ms, AromaEasing easing) {
+    AromaAnimValue v = { .c = to };
+    return __animate(node, damage, ANIM_VALUE_COLOR, value, v, duration_ms, easing);
+}
+
+void aroma_animation_set_on_done(AromaAnimation* anim, AromaAnimationDoneCallback cb, void* user_data) {
+    if (!anim || !anim->active) return;
+    anim->on_done = cb;
+    anim->user_data = user_data;
+}
+
+void aroma_animation_cancel(AromaAnimation* anim) {
+    if (!anim || !anim->active) return;
+    anim->active = false;
+    g_active_count--;
+}
+
+void aroma_animation_cancel_node(AromaNode* node) {
+    if (!node || g_active_count == 0) return;
+    for (size_t i = 0; i < AROMA_MAX_ANIMATIONS; i++) {
+        if (g_animations[i].active && g_animations[i].node == node) {
+            aroma_animation_cancel(&g_animations[i]);
+        }
+    }
+}
+
+void aroma_animation_cancel_scene(const AromaSceneArena* arena) {
+    if (!arena || g_active_count == 0) return;
+    for (size_t i = 0; i < AROMA_MAX_ANIMATIONS; i++) {
+        if (g_animations[i].active && g_animations[i].node && g_animations[i].node->scene_arena == arena) {
+            aroma_animation_cancel(&g_animations[i]);
+        }
+    }
+}
+
+bool aroma_animation_tick(uint64_t now_ms) {
+    if (g_active_count == 0) return false;
+
+    for (size_t i = 0; i < AROMA_MAX_ANIMATIONS; i++) {
+        struct AromaAnimation* anim = &g_animations[i];
+        if (!anim->active) continue;
+
+        if (!anim->started) {
+            anim->start_ms = now_ms;
+            anim->started = true;
+        }
+
+        uint64_t elapsed = now_ms > anim->start_ms ? now_ms - anim->start_ms : 0;
+        bool finished = elapsed >= anim->duration_ms;
+        float t = finished ? 1.0f : (float)elapsed / (float)anim->duration_ms;
+
+        if (__write_value(anim, aroma_easing_apply(anim->easing, t))) {
+            __damage(anim);
+        }
+
+        if (finished) {
+            AromaAnimationDoneCallback on_done = anim->on_done;
+            AromaNode* node = anim->node;
+            void* user_data = anim->user_data;
+            aroma_animation_cancel(anim);
+            if (on_done) on_done(node, user_data);
+        }
+    }
+
+    return g_active_count > 0;
+}
+
+bool aroma_animation_is_running(void) {
+    return g_active_count > 0;
+}
+
+uint32_t aroma_animation_active_count(void) {
+    return g_active_count;
+}
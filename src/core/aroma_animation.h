@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_ANIMATION_H
+#define AROMA_CORE_ANIMATION_H
+
+#include <aroma_animation.h>
+
+#endif
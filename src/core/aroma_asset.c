@@ -0,0 +1,180 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_asset.h"
+#include "core/aroma_idle.h"
+#include "core/aroma_time.h"
+#include "core/aroma_logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct AromaAsset {
+    AromaAssetState state;
+    FILE* file;
+    uint8_t* data;
+    size_t size;
+    size_t loaded;
+    uint32_t generation;
+};
+
+static AromaAsset g_assets[AROMA_MAX_ASSETS];
+
+static void __asset_reset(AromaAsset* asset) {
+    if (asset->file) fclose(asset->file);
+    free(asset->data);
+    uint32_t generation = asset->generation;
+    memset(asset, 0, sizeof(*asset));
+    asset->generation = generation + 1;
+}
+
+void aroma_asset_init(void) {
+    memset(g_assets, 0, sizeof(g_assets));
+}
+
+void aroma_asset_shutdown(void) {
+    for (int i = 0; i < AROMA_MAX_ASSETS; i++) {
+        if (g_assets[i].state != AROMA_ASSET_FREE) __asset_reset(&g_assets[i]);
+    }
+    memset(g_assets, 0, sizeof(g_assets));
+}
+
+AromaAsset* aroma_asset_create_pending(void) {
+    for (int i = 0; i < AROMA_MAX_ASSETS; i++) {
+        if (g_assets[i].state == AROMA_ASSET_FREE) {
+            g_assets[i].state = AROMA_ASSET_PENDING;
+            return &g_assets[i];
+        }
+    }
+    LOG_ERROR("No free asset handles (max %d)", AROMA_MAX_ASSETS);
+    return NULL;
+}
+
+void aroma_asset_complete(AromaAsset* asset, void* data, size_t size) {
+    if (!asset || asset->state != AROMA_ASSET_PENDING) {
+        free(data);
+        return;
+    }
+    if (asset->file) {
+        fclose(asset->file);
+        asset->file = NULL;
+    }
+    if (asset->data != data) free(asset->data);
+    asset->data = (uint8_t*)data;
+    asset->size = size;
+    asset->loaded = size;
+    asset->state = AROMA_ASSET_READY;
+}
+
+void aroma_asset_fail(AromaAsset* asset) {
+    if (!asset || asset->state != AROMA_ASSET_PENDING) return;
+    if (asset->file) {
+        fclose(asset->file);
+        asset->file = NULL;
+    }
+    free(asset->data);
+    asset->data = NULL;
+    asset->size = 0;
+    asset->state = AROMA_ASSET_FAILED;
+}
+
+typedef struct {
+    AromaAsset* asset;
+    uint32_t generation;
+} AromaAssetLoad;
+
+static AromaAssetLoad g_asset_loads[AROMA_MAX_ASSETS];
+
+static AromaIdleResult __asset_load_step(void* ctx, const AromaIdleDeadline* deadline) {
+    AromaAssetLoad* load = (AromaAssetLoad*)ctx;
+    AromaAsset* asset = load->asset;
+
+    /* Released (and possibly reused) while queued. */
+    if (asset->generation != load->generation || asset->state != AROMA_ASSET_PENDING || !asset->file)
+        return AROMA_IDLE_DONE;
+
+    do {
+        size_t want = asset->size - asset->loaded;
+        if (want > AROMA_ASSET_CHUNK_SIZE) want = AROMA_ASSET_CHUNK_SIZE;
+        size_t got = want ? fread(asset->data + asset->loaded, 1, want, asset->file) : 0;
+        asset->loaded += got;
+
+        if (asset->loaded == asset->size) {
+            asset->data[asset->size] = '\0';
+            aroma_asset_complete(asset, asset->data, asset->size);
+            return AROMA_IDLE_DONE;
+        }
+        if (got < want) {
+            LOG_ERROR("Asset read failed after %zu of %zu bytes", asset->loaded, asset->size);
+            aroma_asset_fail(asset);
+            return AROMA_IDLE_DONE;
+        }
+    } while (aroma_idle_time_remaining(deadline) > 0);
+
+    return AROMA_IDLE_YIELD;
+}
+
+AromaAsset* aroma_asset_load_async(const char* path) {
+    if (!path) return NULL;
+    AromaAsset* asset = aroma_asset_create_pending();
+    if (!asset) return NULL;
+
+    asset->file = fopen(path, "rb");
+    long size = -1;
+    if (asset->file && fseek(asset->file, 0, SEEK_END) == 0) {
+        size = ftell(asset->file);
+        rewind(asset->file);
+    }
+    if (size < 0 || !(asset->data = (uint8_t*)malloc((size_t)size + 1))) {
+        LOG_ERROR("Failed to open asset %s", path);
+        aroma_asset_fail(asset);
+        return asset;
+    }
+    asset->size = (size_t)size;
+
+    AromaAssetLoad* load = &g_asset_loads[asset - g_assets];
+    load->asset = asset;
+    load->generation = asset->generation;
+    if (!aroma_idle_post(__asset_load_step, load)) aroma_asset_fail(asset);
+    return asset;
+}
+
+AromaAssetState aroma_asset_state(const AromaAsset* asset) {
+    return asset ? asset->state : AROMA_ASSET_FAILED;
+}
+
+bool aroma_asset_is_pending(const AromaAsset* asset) {
+    return asset && asset->state == AROMA_ASSET_PENDING;
+}
+
+const void* aroma_asset_data(const AromaAsset* asset, size_t* out_size) {
+    if (!asset || asset->state != AROMA_ASSET_READY) {
+        if (out_size) *out_size = 0;
+        return NULL;
+    }
+    if (out_size) *out_size = asset->size;
+    return asset->data;
+}
+
+void aroma_asset_release(AromaAsset* asset) {
+    if (!asset || asset->state == AROMA_ASSET_FREE) return;
+    __asset_reset(asset);
+}
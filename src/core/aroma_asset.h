@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_ASSET_H
+#define AROMA_CORE_ASSET_H
+
+#include <aroma_asset.h>
+
+#endif
@@ -20,94 +20,284 @@
  */
 
 #include "core/aroma_drawlist.h"
+#include "core/aroma_frame_arena.h"
+#include "core/aroma_font.h"
+#include "core/aroma_logger.h"
+#include "core/aroma_memory.h"
+#include "core/aroma_string.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
+#include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct AromaDrawCmd {
-    AromaDrawCmdType type;
-    bool is_drawn;
-    union {
-        struct {
-            uint32_t color;
-        } clear;
-        struct {
-            int x;
-            int y;
-            int width;
-            int height;
-            uint32_t color;
-            bool is_rounded;
-            float corner_radius;
-        } fill_rect;
-        struct {
-            int x;
-            int y;
-            int width;
-            int height;
-            uint32_t color;
-            int border_width;
-            bool is_rounded;
-            float corner_radius;
-        } hollow_rect;
-        struct {
-            int cx;
-            int cy;
-            int radius;
-            float start_angle;
-            float end_angle;
-            uint32_t color;
-            int thickness;
-        } arc;
-        struct {
-            AromaFont* font;
-            char* text;
-            int x;
-            int y;
-            uint32_t color;
-            float scale;
-        } text;
-        struct {
-            int x;
-            int y;
-            int width;
-            int height;
-            unsigned int texture_id;
-        } image;
-    } data;
-} AromaDrawCmd;
+/*
+ * Commands are packed back to back in one byte stream. Each starts with a
+ * small header carrying its type and its aligned size, so a clear costs a
+ * few bytes rather than the size of the largest command. Embedded builds
+ * store coordinates as int16 and colors as RGB565, which is all the TFT
+ * can show anyway.
+ */
+#ifdef ESP32
+typedef int16_t AromaDrawCoord;
+typedef uint16_t AromaDrawColor;
+#define AROMA_DRAWLIST_ALIGN 4
+#else
+typedef int32_t AromaDrawCoord;
+typedef uint32_t AromaDrawColor;
+#define AROMA_DRAWLIST_ALIGN 8
+#endif
+
+#define AROMA_DRAWLIST_INITIAL_BYTES 2048
+/* How many state groups the batching pass looks back across. */
+#define AROMA_DRAWLIST_BATCH_WINDOW 32
+/* Width claimed by text whose advance the backend cannot measure. */
+#define AROMA_DRAWLIST_TEXT_OPEN_WIDTH INT16_MAX
+/* FNV-1a over the recorded commands, used to detect unchanged frames. */
+#define AROMA_DRAWLIST_HASH_SEED  0xcbf29ce484222325ull
+#define AROMA_DRAWLIST_HASH_PRIME 0x100000001b3ull
+
+enum {
+    AROMA_DRAW_FLAG_ROUNDED   = 1 << 0,
+    /* Where a text command keeps its characters. */
+    AROMA_DRAW_FLAG_TEXT_INLINE = 1 << 1,  /* NUL-terminated bytes in the tail */
+    AROMA_DRAW_FLAG_TEXT_POOL   = 1 << 2,  /* pinned AromaStr in the tail */
+    AROMA_DRAW_FLAG_TEXT_ARENA  = 1 << 3,  /* const char* into a byte arena */
+    AROMA_DRAW_FLAG_CLIP_OFF    = 1 << 4   /* clip command lifting the clip */
+};
+
+typedef struct AromaDrawCmdHeader {
+    uint8_t type;
+    uint8_t flags;
+    uint16_t size;
+} AromaDrawCmdHeader;
+
+typedef struct AromaDrawClearCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawColor color;
+} AromaDrawClearCmd;
+
+typedef struct AromaDrawRectCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawCoord x;
+    AromaDrawCoord y;
+    AromaDrawCoord width;
+    AromaDrawCoord height;
+    AromaDrawColor color;
+    AromaDrawCoord border_width;   /* hollow rectangles only */
+    float corner_radius;
+} AromaDrawRectCmd;
+
+typedef struct AromaDrawArcCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawCoord cx;
+    AromaDrawCoord cy;
+    AromaDrawCoord radius;
+    AromaDrawCoord thickness;
+    AromaDrawColor color;
+    float start_angle;
+    float end_angle;
+} AromaDrawArcCmd;
+
+typedef struct AromaDrawTextCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawCoord x;
+    AromaDrawCoord y;
+    int16_t bounds_dx;            /* ink box measured at record time, relative to x/y */
+    int16_t bounds_dy;
+    uint16_t bounds_width;
+    uint16_t bounds_height;
+    AromaDrawColor color;
+    float scale;
+    AromaFont* font;
+    char tail[];
+} AromaDrawTextCmd;
+
+typedef struct AromaDrawImageCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawCoord x;
+    AromaDrawCoord y;
+    AromaDrawCoord width;
+    AromaDrawCoord height;
+    unsigned int texture_id;
+} AromaDrawImageCmd;
+
+/* Sets the clip for the commands that follow; never a stack operation, so
+   any subset of commands can be replayed as long as these come along. */
+typedef struct AromaDrawClipCmd {
+    AromaDrawCmdHeader header;
+    AromaDrawCoord x;
+    AromaDrawCoord y;
+    AromaDrawCoord width;
+    AromaDrawCoord height;
+} AromaDrawClipCmd;
+
+typedef struct AromaDrawClipRect {
+    bool enabled;
+    int x0, y0, x1, y1;
+} AromaDrawClipRect;
+
+/* Entry 0 is the base clip; each push stores its intersection with the
+   entry below, and pushes beyond the maximum depth only count. */
+typedef struct AromaDrawClipStack {
+    AromaDrawClipRect rects[AROMA_DRAWLIST_MAX_CLIP_DEPTH + 1];
+    uint32_t depth;
+    uint32_t overflow;
+} AromaDrawClipStack;
+
+/* Batching state of a command: its kind plus the texture or font it binds. */
+typedef enum AromaDrawBatchKind {
+    AROMA_DRAW_BATCH_BARRIER,   /* clears: nothing moves across them */
+    AROMA_DRAW_BATCH_RECT,
+    AROMA_DRAW_BATCH_ARC,
+    AROMA_DRAW_BATCH_TEXT,
+    AROMA_DRAW_BATCH_IMAGE
+} AromaDrawBatchKind;
+
+typedef struct AromaDrawBatchEntry {
+    uint32_t offset;
+    uint32_t kind;
+    uintptr_t state;
+    int x0, y0, x1, y1;
+    uint32_t next;      /* next member of the same group */
+} AromaDrawBatchEntry;
+
+/* A run of commands sharing one state, with the union of their bounds. */
+typedef struct AromaDrawBatchGroup {
+    uint32_t kind;
+    uintptr_t state;
+    int x0, y0, x1, y1;
+    uint32_t head;
+    uint32_t tail;
+} AromaDrawBatchGroup;
 
 struct AromaDrawList {
-    AromaDrawCmd* commands;
-    size_t count;
+    uint8_t* bytes;
+    size_t used;
     size_t capacity;
+    size_t count;
+    size_t peak_count;
+    size_t peak_bytes;
+    size_t heap_allocs;
+    size_t pinned;               /* text commands holding a pool reference */
+    uint64_t hash;               /* running hash of the recorded commands */
+    AromaFrameArena* arena;
+    AromaFrameArena* own_arena;  /* text bytes when no shared arena is set */
+    bool batching;
+    size_t flush_calls;
+    AromaDrawBatchEntry* entries; /* scratch for the batching pass */
+    size_t entry_capacity;
+    AromaDrawBatchGroup* groups;
+    size_t group_capacity;
+    uint32_t* order;
+    size_t order_capacity;
+    AromaRectBatchItem* rects;
+    size_t rect_capacity;
+    uint32_t* bin_starts;         /* tile -> first slot in bin_items, plus an end slot */
+    size_t bin_start_capacity;
+    uint32_t* bin_items;          /* byte offsets of the commands touching each tile */
+    size_t bin_item_capacity;
+    size_t bin_count;             /* 0 when the list has not been binned */
+    int bin_height;
+    size_t occluded;              /* results of the last aroma_drawlist_cull_occluded */
+    size_t occluded_pixels;
+    size_t painted_pixels;
+    AromaDrawClipStack clip;      /* clip while recording */
+    AromaDrawClipRect clip_base;   /* clip the first command is appended under */
+    AromaDrawClipRect clip_emitted; /* clip set by the last clip command, else the base */
+    size_t clip_commands;
+    size_t clipped;
+    AromaGraphicsInterface* measure_gfx; /* NULL measures with the active backend */
+    size_t measure_window;
 };
 
-static AromaDrawList* g_active_drawlist = NULL;
+/* Each recording thread has its own active list; see aroma_drawlist_record_parallel. */
+static _Thread_local AromaDrawList* g_active_drawlist = NULL;
+static _Thread_local bool g_recording_worker = false;
+
+static inline AromaDrawCoord __drawlist_coord(int value)
+{
+#ifdef ESP32
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+#endif
+    return (AromaDrawCoord)value;
+}
+
+static inline AromaDrawColor __drawlist_pack_color(uint32_t color)
+{
+#ifdef ESP32
+    return (AromaDrawColor)(((color & 0xF80000) >> 8) | ((color & 0xFC00) >> 5) | ((color & 0xFF) >> 3));
+#else
+    return color;
+#endif
+}
+
+/* Widens RGB565 back to RGB888 so that the backend's own 565 conversion
+   lands on exactly the recorded value. */
+static inline uint32_t __drawlist_unpack_color(AromaDrawColor color)
+{
+#ifdef ESP32
+    uint32_t r = (color >> 11) & 0x1F;
+    uint32_t g = (color >> 5) & 0x3F;
+    uint32_t b = color & 0x1F;
+    return (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+#else
+    return color;
+#endif
+}
 
 static void aroma_drawlist_reserve(AromaDrawList* list, size_t additional)
 {
     if (!list) return;
-    size_t required = list->count + additional;
+    size_t required = list->used + additional;
     if (required <= list->capacity) return;
 
-    size_t new_capacity = list->capacity == 0 ? 64 : list->capacity * 2;
+    size_t new_capacity = list->capacity == 0 ? AROMA_DRAWLIST_INITIAL_BYTES : list->capacity * 2;
     while (new_capacity < required) {
         new_capacity *= 2;
     }
 
-    AromaDrawCmd* next = realloc(list->commands, new_capacity * sizeof(AromaDrawCmd));
+    uint8_t* next = realloc(list->bytes, new_capacity);
     if (!next) {
         return;
     }
-    list->commands = next;
+    aroma_memory_track(AROMA_MEMORY_DRAWLIST, (ptrdiff_t)(new_capacity - list->capacity), 0);
+    list->bytes = next;
     list->capacity = new_capacity;
+    list->heap_allocs++;
+}
+
+/* Appends a zeroed command of `size` bytes, rounded up to the stream alignment. */
+static void* __drawlist_push(AromaDrawList* list, AromaDrawCmdType type, size_t size)
+{
+    size = (size + AROMA_DRAWLIST_ALIGN - 1) & ~(size_t)(AROMA_DRAWLIST_ALIGN - 1);
+    if (size > UINT16_MAX) return NULL;
+    aroma_drawlist_reserve(list, size);
+    if (list->used + size > list->capacity) return NULL;
+
+    AromaDrawCmdHeader* header = (AromaDrawCmdHeader*)(list->bytes + list->used);
+    memset(header, 0, size);
+    header->type = (uint8_t)type;
+    header->size = (uint16_t)size;
+    list->used += size;
+    list->count++;
+    list->bin_count = 0;
+    return header;
 }
 
+#define AROMA_DRAWLIST_FOREACH(list, header)                                                   \
+    for (AromaDrawCmdHeader* header = (AromaDrawCmdHeader*)(list)->bytes;                      \
+         (uint8_t*)header < (list)->bytes + (list)->used;                                      \
+         header = (AromaDrawCmdHeader*)((uint8_t*)header + header->size))
+
 AromaDrawList* aroma_drawlist_create(void)
 {
     AromaDrawList* list = calloc(1, sizeof(AromaDrawList));
+    if (!list) return NULL;
+    list->hash = AROMA_DRAWLIST_HASH_SEED;
+    aroma_memory_track(AROMA_MEMORY_DRAWLIST, (ptrdiff_t)sizeof(AromaDrawList), 0);
     return list;
 }
 
@@ -115,23 +305,103 @@ void aroma_drawlist_destroy(AromaDrawList* list)
 {
     if (!list) return;
     aroma_drawlist_reset(list);
-    free(list->commands);
+    aroma_frame_arena_destroy(list->own_arena);
+    aroma_memory_track(AROMA_MEMORY_DRAWLIST,
+                       -(ptrdiff_t)(sizeof(AromaDrawList) + list->capacity +
+                                    list->entry_capacity * sizeof(AromaDrawBatchEntry) +
+                                    list->group_capacity * sizeof(AromaDrawBatchGroup) +
+                                    list->order_capacity * sizeof(uint32_t) +
+                                    list->rect_capacity * sizeof(AromaRectBatchItem) +
+                                    (list->bin_start_capacity + list->bin_item_capacity) * sizeof(uint32_t)), 0);
+    free(list->entries);
+    free(list->groups);
+    free(list->order);
+    free(list->rects);
+    free(list->bin_starts);
+    free(list->bin_items);
+    free(list->bytes);
     free(list);
 }
 
 void aroma_drawlist_reset(AromaDrawList* list)
 {
     if (!list) return;
-    for (size_t i = 0; i < list->count; i++) {
-        AromaDrawCmd* cmd = &list->commands[i];
-        if (cmd->type == AROMA_DRAW_CMD_TEXT) {
-            free(cmd->data.text.text);
-            cmd->data.text.text = NULL;
-            
+    if (list->count > list->peak_count) list->peak_count = list->count;
+    if (list->used > list->peak_bytes) list->peak_bytes = list->used;
+    /* Arena bytes are reclaimed wholesale; only pool pins need releasing. */
+    if (list->pinned) {
+        AROMA_DRAWLIST_FOREACH(list, header) {
+            if (header->type != AROMA_DRAW_CMD_TEXT || !(header->flags & AROMA_DRAW_FLAG_TEXT_POOL)) continue;
+            AromaStr str;
+            memcpy(&str, ((AromaDrawTextCmd*)header)->tail, sizeof(str));
+            aroma_str_release(&str);
         }
-        cmd->is_drawn = false;
+        list->pinned = 0;
     }
+    list->used = 0;
     list->count = 0;
+    list->bin_count = 0;
+    list->hash = AROMA_DRAWLIST_HASH_SEED;
+    memset(&list->clip, 0, sizeof(list->clip));
+    memset(&list->clip_base, 0, sizeof(list->clip_base));
+    list->clip_emitted = list->clip_base;
+    list->clip_commands = 0;
+    list->clipped = 0;
+    if (list->own_arena) aroma_frame_arena_reset(list->own_arena);
+}
+
+void aroma_drawlist_set_arena(AromaDrawList* list, AromaFrameArena* arena)
+{
+    if (!list) return;
+    /* Text already recorded must be released by the allocator that owns it. */
+    aroma_drawlist_reset(list);
+    list->arena = arena;
+}
+
+AromaFrameArena* aroma_drawlist_get_arena(const AromaDrawList* list)
+{
+    return list ? list->arena : NULL;
+}
+
+void aroma_drawlist_set_batching(AromaDrawList* list, bool enabled)
+{
+    if (list) list->batching = enabled;
+}
+
+bool aroma_drawlist_get_batching(const AromaDrawList* list)
+{
+    return list ? list->batching : false;
+}
+
+void aroma_drawlist_set_text_measure(AromaDrawList* list, AromaGraphicsInterface* gfx, size_t window_id)
+{
+    if (!list) return;
+    list->measure_gfx = gfx;
+    list->measure_window = window_id;
+}
+
+uint64_t aroma_drawlist_get_hash(const AromaDrawList* list)
+{
+    return list ? list->hash : 0;
+}
+
+AromaDrawListStats aroma_drawlist_get_stats(const AromaDrawList* list)
+{
+    AromaDrawListStats stats = {0};
+    if (!list) return stats;
+    stats.count = list->count;
+    stats.peak_count = list->count > list->peak_count ? list->count : list->peak_count;
+    stats.bytes = list->used;
+    stats.peak_bytes = list->used > list->peak_bytes ? list->used : list->peak_bytes;
+    stats.capacity = list->capacity;
+    stats.heap_allocs = list->heap_allocs;
+    stats.flush_calls = list->flush_calls;
+    stats.occluded = list->occluded;
+    stats.occluded_pixels = list->occluded_pixels;
+    stats.painted_pixels = list->painted_pixels;
+    stats.clipped = list->clipped;
+    if (list->own_arena) stats.heap_allocs += aroma_frame_arena_get_stats(list->own_arena).chunk_allocs;
+    return stats;
 }
 
 void aroma_drawlist_begin(AromaDrawList* list)
@@ -139,9 +409,21 @@ void aroma_drawlist_begin(AromaDrawList* list)
     g_active_drawlist = list;
 }
 
+void aroma_drawlist_begin_worker(AromaDrawList* list)
+{
+    g_active_drawlist = list;
+    g_recording_worker = list != NULL;
+}
+
 void aroma_drawlist_end(void)
 {
     g_active_drawlist = NULL;
+    g_recording_worker = false;
+}
+
+bool aroma_drawlist_is_worker(void)
+{
+    return g_recording_worker;
 }
 
 bool aroma_drawlist_is_active(void)
@@ -154,191 +436,530 @@ AromaDrawList* aroma_drawlist_get_active(void)
     return g_active_drawlist;
 }
 
+static inline const char* __drawlist_text(const AromaDrawTextCmd* cmd)
+{
+    if (cmd->header.flags & AROMA_DRAW_FLAG_TEXT_INLINE) return cmd->tail;
+    if (cmd->header.flags & AROMA_DRAW_FLAG_TEXT_POOL) {
+        AromaStr str;
+        memcpy(&str, cmd->tail, sizeof(str));
+        return aroma_str_get(&str);
+    }
+    if (cmd->header.flags & AROMA_DRAW_FLAG_TEXT_ARENA) {
+        const char* bytes;
+        memcpy(&bytes, cmd->tail, sizeof(bytes));
+        return bytes ? bytes : "";
+    }
+    return "";
+}
+
+static inline uint64_t __drawlist_hash_bytes(uint64_t hash, const void* data, size_t length)
+{
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * AROMA_DRAWLIST_HASH_PRIME;
+    }
+    return hash;
+}
+
+/*
+ * Folds a finished command into the list's running hash. Commands are
+ * zeroed before they are filled in, so padding hashes the same every frame.
+ * Text is hashed by content: its storage points somewhere new each frame.
+ */
+static void __drawlist_seal(AromaDrawList* list, const AromaDrawCmdHeader* header)
+{
+    size_t length = header->size;
+    if (header->type == AROMA_DRAW_CMD_TEXT) length = offsetof(AromaDrawTextCmd, tail);
+
+    uint64_t hash = list->hash;
+    const uint32_t* words = (const uint32_t*)header;
+    for (size_t i = 0; i < length / sizeof(uint32_t); i++) {
+        hash = (hash ^ words[i]) * AROMA_DRAWLIST_HASH_PRIME;
+    }
+    if (header->type == AROMA_DRAW_CMD_TEXT) {
+        const char* text = __drawlist_text((const AromaDrawTextCmd*)header);
+        hash = __drawlist_hash_bytes(hash, text, strlen(text) + 1);
+    }
+    list->hash = hash;
+}
+
+static bool __drawlist_bounds(const AromaDrawCmdHeader* header, int* x, int* y, int* width, int* height);
+
+static inline bool __drawlist_same_clip(const AromaDrawClipRect* a, const AromaDrawClipRect* b)
+{
+    if (!a->enabled || !b->enabled) return a->enabled == b->enabled;
+    return a->x0 == b->x0 && a->y0 == b->y0 && a->x1 == b->x1 && a->y1 == b->y1;
+}
+
+static AromaDrawClipRect __drawlist_clip_rect(bool enabled, int x, int y, int width, int height)
+{
+    AromaDrawClipRect rect = { enabled, x, y, x + (width > 0 ? width : 0), y + (height > 0 ? height : 0) };
+    return rect;
+}
+
+static void __drawlist_clip_push(AromaDrawClipStack* stack, int x, int y, int width, int height)
+{
+    if (stack->depth == AROMA_DRAWLIST_MAX_CLIP_DEPTH) {
+        if (stack->overflow++ == 0) LOG_WARNING("Clip stack deeper than %d; inner clips ignored",
+                                                AROMA_DRAWLIST_MAX_CLIP_DEPTH);
+        return;
+    }
+    const AromaDrawClipRect* outer = &stack->rects[stack->depth];
+    AromaDrawClipRect rect = __drawlist_clip_rect(true, x, y, width, height);
+    if (outer->enabled) {
+        if (rect.x0 < outer->x0) rect.x0 = outer->x0;
+        if (rect.y0 < outer->y0) rect.y0 = outer->y0;
+        if (rect.x1 > outer->x1) rect.x1 = outer->x1;
+        if (rect.y1 > outer->y1) rect.y1 = outer->y1;
+        /* Disjoint clips leave an empty rectangle that hides everything. */
+        if (rect.x1 < rect.x0) rect.x1 = rect.x0;
+        if (rect.y1 < rect.y0) rect.y1 = rect.y0;
+    }
+    stack->rects[++stack->depth] = rect;
+}
+
+static void __drawlist_clip_pop(AromaDrawClipStack* stack)
+{
+    if (stack->overflow) {
+        stack->overflow--;
+    } else if (stack->depth) {
+        stack->depth--;
+    } else {
+        LOG_WARNING("Clip popped without a matching push");
+    }
+}
+
+static size_t __drawlist_clip_cmd_size(void)
+{
+    return (sizeof(AromaDrawClipCmd) + AROMA_DRAWLIST_ALIGN - 1) & ~(size_t)(AROMA_DRAWLIST_ALIGN - 1);
+}
+
+static void __drawlist_write_clip(AromaDrawList* list, uint8_t* at, const AromaDrawClipRect* rect)
+{
+    AromaDrawClipCmd* cmd = (AromaDrawClipCmd*)at;
+    memset(cmd, 0, __drawlist_clip_cmd_size());
+    cmd->header.type = AROMA_DRAW_CMD_CLIP;
+    cmd->header.size = (uint16_t)__drawlist_clip_cmd_size();
+    if (rect->enabled) {
+        cmd->x = __drawlist_coord(rect->x0);
+        cmd->y = __drawlist_coord(rect->y0);
+        cmd->width = __drawlist_coord(rect->x1 - rect->x0);
+        cmd->height = __drawlist_coord(rect->y1 - rect->y0);
+    } else {
+        cmd->header.flags |= AROMA_DRAW_FLAG_CLIP_OFF;
+    }
+    __drawlist_seal(list, &cmd->header);
+    list->clip_emitted = *rect;
+    list->clip_commands++;
+}
+
+/* Takes back the last command pushed, e.g. one that turned out to be clipped away. */
+static void __drawlist_unpush(AromaDrawList* list, AromaDrawCmdHeader* header)
+{
+    if (header->type == AROMA_DRAW_CMD_TEXT && (header->flags & AROMA_DRAW_FLAG_TEXT_POOL)) {
+        AromaStr str;
+        memcpy(&str, ((AromaDrawTextCmd*)header)->tail, sizeof(str));
+        aroma_str_release(&str);
+        list->pinned--;
+    }
+    list->used = (size_t)((uint8_t*)header - list->bytes);
+    list->count--;
+}
+
+/*
+ * Finishes the command just pushed: drops it if it misses the clip, or
+ * else records the clip ahead of it when that changed since the last
+ * command, then seals it.
+ */
+static void __drawlist_commit(AromaDrawList* list, AromaDrawCmdHeader* header)
+{
+    const AromaDrawClipRect* clip = &list->clip.rects[list->clip.depth];
+    int x, y, width, height;
+    if (clip->enabled && __drawlist_bounds(header, &x, &y, &width, &height) &&
+        !(x < clip->x1 && clip->x0 < x + width && y < clip->y1 && clip->y0 < y + height)) {
+        __drawlist_unpush(list, header);
+        list->clipped++;
+        return;
+    }
+    if (!__drawlist_same_clip(clip, &list->clip_emitted)) {
+        size_t offset = (size_t)((uint8_t*)header - list->bytes);
+        size_t size = header->size;
+        size_t clip_size = __drawlist_clip_cmd_size();
+        aroma_drawlist_reserve(list, clip_size);
+        if (list->used + clip_size > list->capacity) {
+            __drawlist_unpush(list, (AromaDrawCmdHeader*)(list->bytes + offset));
+            return;
+        }
+        memmove(list->bytes + offset + clip_size, list->bytes + offset, size);
+        __drawlist_write_clip(list, list->bytes + offset, clip);
+        list->used += clip_size;
+        list->count++;
+        header = (AromaDrawCmdHeader*)(list->bytes + offset + clip_size);
+    }
+    __drawlist_seal(list, header);
+}
+
+void aroma_drawlist_cmd_push_clip(AromaDrawList* list, int x, int y, int width, int height)
+{
+    if (list) __drawlist_clip_push(&list->clip, x, y, width, height);
+}
+
+void aroma_drawlist_cmd_pop_clip(AromaDrawList* list)
+{
+    if (list) __drawlist_clip_pop(&list->clip);
+}
+
+void aroma_drawlist_cmd_set_clip(AromaDrawList* list, bool enabled, int x, int y, int width, int height)
+{
+    if (list) list->clip.rects[list->clip.depth] = __drawlist_clip_rect(enabled, x, y, width, height);
+}
+
+bool aroma_drawlist_get_clip(const AromaDrawList* list, int* x, int* y, int* width, int* height)
+{
+    if (!list || !list->clip.rects[list->clip.depth].enabled) return false;
+    const AromaDrawClipRect* clip = &list->clip.rects[list->clip.depth];
+    if (x) *x = clip->x0;
+    if (y) *y = clip->y0;
+    if (width) *width = clip->x1 - clip->x0;
+    if (height) *height = clip->y1 - clip->y0;
+    return true;
+}
+
+void aroma_drawlist_set_base_clip(AromaDrawList* list, bool enabled, int x, int y, int width, int height)
+{
+    if (!list) return;
+    list->clip_base = __drawlist_clip_rect(enabled, x, y, width, height);
+    list->clip.rects[0] = list->clip_base;
+    list->clip_emitted = list->clip_base;
+}
+
 void aroma_drawlist_cmd_clear(AromaDrawList* list, uint32_t color)
 {
     #ifndef ESP32
     if (!list) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_CLEAR;
-    cmd->data.clear.color = color;
-    cmd->is_drawn = false;
+    AromaDrawClearCmd* cmd = __drawlist_push(list, AROMA_DRAW_CMD_CLEAR, sizeof(*cmd));
+    if (!cmd) return;
+    cmd->color = __drawlist_pack_color(color);
+    __drawlist_commit(list, &cmd->header);
     #endif
 }
 
-void aroma_drawlist_cmd_fill_rect(AromaDrawList* list, int x, int y, int width, int height,
-                                  uint32_t color, bool is_rounded, float corner_radius)
+static void __drawlist_push_rect(AromaDrawList* list, AromaDrawCmdType type, int x, int y, int width, int height,
+                                 uint32_t color, int border_width, bool is_rounded, float corner_radius)
 {
     if (!list) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_FILL_RECT;
-    cmd->data.fill_rect.x = x;
-    cmd->data.fill_rect.y = y;
-    cmd->data.fill_rect.width = width;
-    cmd->data.fill_rect.height = height;
-    cmd->data.fill_rect.color = color;
-    cmd->data.fill_rect.is_rounded = is_rounded;
-    cmd->data.fill_rect.corner_radius = corner_radius;
-        cmd->is_drawn = false;
+    AromaDrawRectCmd* cmd = __drawlist_push(list, type, sizeof(*cmd));
+    if (!cmd) return;
+    if (is_rounded) cmd->header.flags |= AROMA_DRAW_FLAG_ROUNDED;
+    cmd->x = __drawlist_coord(x);
+    cmd->y = __drawlist_coord(y);
+    cmd->width = __drawlist_coord(width);
+    cmd->height = __drawlist_coord(height);
+    cmd->color = __drawlist_pack_color(color);
+    cmd->border_width = __drawlist_coord(border_width);
+    cmd->corner_radius = corner_radius;
+    __drawlist_commit(list, &cmd->header);
+}
 
+void aroma_drawlist_cmd_fill_rect(AromaDrawList* list, int x, int y, int width, int height,
+                                  uint32_t color, bool is_rounded, float corner_radius)
+{
+    __drawlist_push_rect(list, AROMA_DRAW_CMD_FILL_RECT, x, y, width, height, color, 0, is_rounded, corner_radius);
 }
 
 void aroma_drawlist_cmd_hollow_rect(AromaDrawList* list, int x, int y, int width, int height,
                                     uint32_t color, int border_width, bool is_rounded, float corner_radius)
 {
-    if (!list) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_HOLLOW_RECT;
-    cmd->data.hollow_rect.x = x;
-    cmd->data.hollow_rect.y = y;
-    cmd->data.hollow_rect.width = width;
-    cmd->data.hollow_rect.height = height;
-    cmd->data.hollow_rect.color = color;
-    cmd->data.hollow_rect.border_width = border_width;
-    cmd->data.hollow_rect.is_rounded = is_rounded;
-    cmd->data.hollow_rect.corner_radius = corner_radius;
-        cmd->is_drawn = false;
-
+    __drawlist_push_rect(list, AROMA_DRAW_CMD_HOLLOW_RECT, x, y, width, height, color, border_width,
+                         is_rounded, corner_radius);
 }
 
 void aroma_drawlist_cmd_arc(AromaDrawList* list, int cx, int cy, int radius,
                             float start_angle, float end_angle, uint32_t color, int thickness)
 {
     if (!list) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_ARC;
-    cmd->data.arc.cx = cx;
-    cmd->data.arc.cy = cy;
-    cmd->data.arc.radius = radius;
-    cmd->data.arc.start_angle = start_angle;
-    cmd->data.arc.end_angle = end_angle;
-    cmd->data.arc.color = color;
-    cmd->data.arc.thickness = thickness;
-        cmd->is_drawn = false;
+    AromaDrawArcCmd* cmd = __drawlist_push(list, AROMA_DRAW_CMD_ARC, sizeof(*cmd));
+    if (!cmd) return;
+    cmd->cx = __drawlist_coord(cx);
+    cmd->cy = __drawlist_coord(cy);
+    cmd->radius = __drawlist_coord(radius);
+    cmd->thickness = __drawlist_coord(thickness);
+    cmd->color = __drawlist_pack_color(color);
+    cmd->start_angle = start_angle;
+    cmd->end_angle = end_angle;
+    __drawlist_commit(list, &cmd->header);
+}
+
+static AromaDrawTextCmd* __drawlist_push_text(AromaDrawList* list, AromaFont* font, size_t tail,
+                                              int x, int y, uint32_t color, float scale)
+{
+    AromaDrawTextCmd* cmd = __drawlist_push(list, AROMA_DRAW_CMD_TEXT, sizeof(AromaDrawTextCmd) + tail);
+    if (!cmd) return NULL;
+    cmd->font = font;
+    cmd->x = __drawlist_coord(x);
+    cmd->y = __drawlist_coord(y);
+    cmd->color = __drawlist_pack_color(color);
+    cmd->scale = scale;
+    return cmd;
+}
 
+static const char* __drawlist_strndup(AromaDrawList* list, const char* text, size_t length)
+{
+    AromaFrameArena* arena = list->arena;
+    if (!arena) {
+        if (!list->own_arena) list->own_arena = aroma_frame_arena_create();
+        arena = list->own_arena;
+    }
+    return arena ? aroma_frame_arena_strndup(arena, text, length) : NULL;
+}
+
+/*
+ * Both backends treat y as the top of the line box. Glyphs may dip below it
+ * by the descender and overhang the advance slightly, hence the padding.
+ */
+static void __drawlist_finish_text(AromaDrawList* list, AromaDrawTextCmd* cmd)
+{
+    const char* text = __drawlist_text(cmd);
+    float scale = cmd->scale;
+#ifdef ESP32
+    /* The TFT draws text unscaled, so never shrink the box below the font. */
+    if (scale < 1.0f) scale = 1.0f;
+#endif
+    int line_height = aroma_font_get_line_height(cmd->font);
+    int ascender = aroma_font_get_ascender(cmd->font);
+    int descender = abs(aroma_font_get_descender(cmd->font));
+    if (line_height < ascender + descender) line_height = ascender + descender;
+    int pad = (int)((float)line_height * scale) / 8 + 1;
+
+    AromaGraphicsInterface* gfx = list->measure_gfx ? list->measure_gfx : aroma_backend_abi.get_graphics_interface();
+    float advance = (gfx && gfx->measure_text) ? gfx->measure_text(list->measure_window, cmd->font, text, scale) : 0.0f;
+    int width = (advance > 0.0f || text[0] == '\0') ? (int)advance + 1 : AROMA_DRAWLIST_TEXT_OPEN_WIDTH;
+
+    int height = (int)((float)(line_height + descender) * scale) + pad * 2;
+    if (pad > INT16_MAX) pad = INT16_MAX;
+    cmd->bounds_dx = (int16_t)-pad;
+    cmd->bounds_dy = (int16_t)-pad;
+    cmd->bounds_width = (uint16_t)(width + pad * 2 > UINT16_MAX ? UINT16_MAX : width + pad * 2);
+    cmd->bounds_height = (uint16_t)(height > UINT16_MAX ? UINT16_MAX : height);
+    __drawlist_commit(list, &cmd->header);
 }
 
 void aroma_drawlist_cmd_text(AromaDrawList* list, AromaFont* font, const char* text,
                              int x, int y, uint32_t color, float scale)
 {
     if (!list || !text) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_TEXT;
-    cmd->data.text.font = font;
-    cmd->data.text.text = strdup(text);
-    cmd->data.text.x = x;
-    cmd->data.text.y = y;
-    cmd->data.text.color = color;
-    cmd->data.text.scale = scale;
-        cmd->is_drawn = false;
-
+    size_t length = strlen(text);
+    if (length <= AROMA_STR_INLINE_CAPACITY) {
+        AromaDrawTextCmd* cmd = __drawlist_push_text(list, font, length + 1, x, y, color, scale);
+        if (!cmd) return;
+        cmd->header.flags |= AROMA_DRAW_FLAG_TEXT_INLINE;
+        memcpy(cmd->tail, text, length);
+        __drawlist_finish_text(list, cmd);
+        return;
+    }
+    /* Longer transient text is bump-allocated and reclaimed when the list resets. */
+    AromaDrawTextCmd* cmd = __drawlist_push_text(list, font, sizeof(const char*), x, y, color, scale);
+    if (!cmd) return;
+    const char* bytes = __drawlist_strndup(list, text, length);
+    cmd->header.flags |= AROMA_DRAW_FLAG_TEXT_ARENA;
+    memcpy(cmd->tail, &bytes, sizeof(bytes));
+    __drawlist_finish_text(list, cmd);
 }
 
-
-void aroma_drawlist_cmd_image(AromaDrawList* list, int x, int y, int width, int height, unsigned int texture_id)
+void aroma_drawlist_cmd_text_str(AromaDrawList* list, AromaFont* font, const AromaStr* text,
+                                 int x, int y, uint32_t color, float scale)
 {
-    if (!list) return;
-    aroma_drawlist_reserve(list, 1);
-    AromaDrawCmd* cmd = &list->commands[list->count++];
-    cmd->type = AROMA_DRAW_CMD_IMAGE;
-    cmd->data.image.x = x;
-    cmd->data.image.y = y;
-    cmd->data.image.width = width;
-    cmd->data.image.height = height;
-    cmd->data.image.texture_id = texture_id;
-    cmd->is_drawn = false;
+    if (!list || !text) return;
+    if (!aroma_str_is_interned(text)) {
+        aroma_drawlist_cmd_text(list, font, aroma_str_get(text), x, y, color, scale);
+        return;
+    }
+    AromaDrawTextCmd* cmd = __drawlist_push_text(list, font, sizeof(AromaStr), x, y, color, scale);
+    if (!cmd) return;
+    AromaStr pinned;
+    memset(&pinned, 0, sizeof(pinned));
+    aroma_str_copy(&pinned, text);
+    cmd->header.flags |= AROMA_DRAW_FLAG_TEXT_POOL;
+    memcpy(cmd->tail, &pinned, sizeof(pinned));
+    list->pinned++;
+    __drawlist_finish_text(list, cmd);
+}
 
+void aroma_draw_text_str(size_t window_id, AromaFont* font, const AromaStr* text,
+                         int x, int y, uint32_t color, float scale)
+{
+    if (!text) return;
+    if (g_active_drawlist) {
+        aroma_drawlist_cmd_text_str(g_active_drawlist, font, text, x, y, color, scale);
+        return;
+    }
+    AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
+    if (gfx && gfx->render_text) {
+        gfx->render_text(window_id, font, aroma_str_get(text), x, y, color, scale);
+    }
 }
 
+/* Clips of immediate drawing, which has no list to keep them. */
+static AromaDrawClipStack g_immediate_clip;
 
-void aroma_drawlist_flush(AromaDrawList* list, size_t window_id)
+static void __drawlist_apply_immediate_clip(size_t window_id)
 {
-    if (!list || list->count == 0) return;
+    AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
+    const AromaDrawClipRect* clip = &g_immediate_clip.rects[g_immediate_clip.depth];
+    if (!gfx) return;
+    if (clip->enabled) {
+        if (gfx->set_draw_clip) {
+            gfx->set_draw_clip(window_id, clip->x0, clip->y0, clip->x1 - clip->x0, clip->y1 - clip->y0);
+        }
+    } else if (gfx->clear_draw_clip) {
+        gfx->clear_draw_clip(window_id);
+    }
+}
 
-    AromaDrawList* previous = g_active_drawlist;
-    g_active_drawlist = NULL;
+void aroma_draw_push_clip(size_t window_id, int x, int y, int width, int height)
+{
+    if (g_active_drawlist) {
+        aroma_drawlist_cmd_push_clip(g_active_drawlist, x, y, width, height);
+        return;
+    }
+    __drawlist_clip_push(&g_immediate_clip, x, y, width, height);
+    __drawlist_apply_immediate_clip(window_id);
+}
 
-    AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
-    if (!gfx) {
-        g_active_drawlist = previous;
+void aroma_draw_pop_clip(size_t window_id)
+{
+    if (g_active_drawlist) {
+        aroma_drawlist_cmd_pop_clip(g_active_drawlist);
         return;
     }
+    __drawlist_clip_pop(&g_immediate_clip);
+    __drawlist_apply_immediate_clip(window_id);
+}
 
-    for (size_t i = 0; i < list->count; i++) {
-        const AromaDrawCmd* cmd = &list->commands[i];
-        
-        switch (cmd->type) {
-            case AROMA_DRAW_CMD_CLEAR:
-                if (gfx->clear) {
-                    gfx->clear(window_id, cmd->data.clear.color);
-                }
-                break;
-            case AROMA_DRAW_CMD_FILL_RECT:
-                if (gfx->fill_rectangle) {
-                    gfx->fill_rectangle(window_id,
-                                        cmd->data.fill_rect.x,
-                                        cmd->data.fill_rect.y,
-                                        cmd->data.fill_rect.width,
-                                        cmd->data.fill_rect.height,
-                                        cmd->data.fill_rect.color,
-                                        cmd->data.fill_rect.is_rounded,
-                                        cmd->data.fill_rect.corner_radius);
-                }
-                break;
-            case AROMA_DRAW_CMD_HOLLOW_RECT:
-                if (gfx->draw_hollow_rectangle) {
-                    gfx->draw_hollow_rectangle(window_id,
-                                               cmd->data.hollow_rect.x,
-                                               cmd->data.hollow_rect.y,
-                                               cmd->data.hollow_rect.width,
-                                               cmd->data.hollow_rect.height,
-                                               cmd->data.hollow_rect.color,
-                                               cmd->data.hollow_rect.border_width,
-                                               cmd->data.hollow_rect.is_rounded,
-                                               cmd->data.hollow_rect.corner_radius);
-                }
-                break;
-            case AROMA_DRAW_CMD_ARC:
-                if (gfx->draw_arc) {
-                    gfx->draw_arc(window_id,
-                                  cmd->data.arc.cx,
-                                  cmd->data.arc.cy,
-                                  cmd->data.arc.radius,
-                                  cmd->data.arc.start_angle,
-                                  cmd->data.arc.end_angle,
-                                  cmd->data.arc.color,
-                                  cmd->data.arc.thickness);
-                }
-                break;
-            case AROMA_DRAW_CMD_TEXT:
-                if (gfx->render_text) {
-                    gfx->render_text(window_id,
-                                     cmd->data.text.font,
-                                     cmd->data.text.text ? cmd->data.text.text : "",
-                                     cmd->data.text.x,
-                                     cmd->data.text.y,
-                                     cmd->data.text.color, cmd->data.text.scale);
-                }
-                break;
-            case AROMA_DRAW_CMD_IMAGE:
-                if (gfx->draw_image) {
-                    gfx->draw_image(window_id,
-                                    cmd->data.image.x,
-                                    cmd->data.image.y,
-                                    cmd->data.image.width,   
-                                    cmd->data.image.height,
-                                    cmd->data.image.texture_id);
-                    }
-                    break;
+void aroma_drawlist_append(AromaDrawList* list, const AromaDrawList* other)
+{
+    if (!list || !other || other == list) return;
+    list->clipped += other->clipped;
+    if (other->used == 0) return;
+    /* `other` assumed its base clip for the commands before its first clip command. */
+    bool restore = ((const AromaDrawCmdHeader*)other->bytes)->type != AROMA_DRAW_CMD_CLIP &&
+                   !__drawlist_same_clip(&other->clip_base, &list->clip_emitted);
+    size_t clip_size = restore ? __drawlist_clip_cmd_size() : 0;
+    aroma_drawlist_reserve(list, other->used + clip_size);
+    if (list->used + other->used + clip_size > list->capacity) return;
+    if (restore) {
+        __drawlist_write_clip(list, list->bytes + list->used, &other->clip_base);
+        list->used += clip_size;
+        list->count++;
+    }
+
+    AROMA_DRAWLIST_FOREACH(other, header) {
+        AromaDrawCmdHeader* copy = (AromaDrawCmdHeader*)(list->bytes + list->used);
+        memcpy(copy, header, header->size);
+        list->used += header->size;
+        list->count++;
+        /* Text storage belongs to `other`, which may reset before this list flushes. */
+        if (copy->type == AROMA_DRAW_CMD_TEXT && (copy->flags & AROMA_DRAW_FLAG_TEXT_POOL)) {
+            AromaStr ref, pinned;
+            memset(&pinned, 0, sizeof(pinned));
+            memcpy(&ref, ((AromaDrawTextCmd*)copy)->tail, sizeof(ref));
+            aroma_str_copy(&pinned, &ref);
+            memcpy(((AromaDrawTextCmd*)copy)->tail, &pinned, sizeof(pinned));
+            list->pinned++;
+        } else if (copy->type == AROMA_DRAW_CMD_TEXT && (copy->flags & AROMA_DRAW_FLAG_TEXT_ARENA)) {
+            const char* text = __drawlist_text((const AromaDrawTextCmd*)header);
+            const char* bytes = __drawlist_strndup(list, text, strlen(text));
+            memcpy(((AromaDrawTextCmd*)copy)->tail, &bytes, sizeof(bytes));
         }
+        __drawlist_seal(list, copy);
+    }
+    if (other->clip_commands) {
+        list->clip_emitted = other->clip_emitted;
+        list->clip_commands += other->clip_commands;
     }
+    list->bin_count = 0;
+}
 
-    aroma_drawlist_reset(list);
-    g_active_drawlist = previous;
+void aroma_drawlist_cmd_image(AromaDrawList* list, int x, int y, int width, int height, unsigned int texture_id)
+{
+    if (!list) return;
+    AromaDrawImageCmd* cmd = __drawlist_push(list, AROMA_DRAW_CMD_IMAGE, sizeof(*cmd));
+    if (!cmd) return;
+    cmd->x = __drawlist_coord(x);
+    cmd->y = __drawlist_coord(y);
+    cmd->width = __drawlist_coord(width);
+    cmd->height = __drawlist_coord(height);
+    cmd->texture_id = texture_id;
+    __drawlist_commit(list, &cmd->header);
+}
+
+static void __drawlist_execute(const AromaDrawCmdHeader* header, AromaGraphicsInterface* gfx, size_t window_id)
+{
+    switch ((AromaDrawCmdType)header->type) {
+        case AROMA_DRAW_CMD_CLEAR: {
+            const AromaDrawClearCmd* cmd = (const AromaDrawClearCmd*)header;
+            if (gfx->clear) {
+                gfx->clear(window_id, __drawlist_unpack_color(cmd->color));
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_FILL_RECT: {
+            const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+            if (gfx->fill_rectangle) {
+                gfx->fill_rectangle(window_id, cmd->x, cmd->y, cmd->width, cmd->height,
+                                    __drawlist_unpack_color(cmd->color),
+                                    (header->flags & AROMA_DRAW_FLAG_ROUNDED) != 0, cmd->corner_radius);
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_HOLLOW_RECT: {
+            const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+            if (gfx->draw_hollow_rectangle) {
+                gfx->draw_hollow_rectangle(window_id, cmd->x, cmd->y, cmd->width, cmd->height,
+                                           __drawlist_unpack_color(cmd->color), cmd->border_width,
+                                           (header->flags & AROMA_DRAW_FLAG_ROUNDED) != 0, cmd->corner_radius);
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_ARC: {
+            const AromaDrawArcCmd* cmd = (const AromaDrawArcCmd*)header;
+            if (gfx->draw_arc) {
+                gfx->draw_arc(window_id, cmd->cx, cmd->cy, cmd->radius, cmd->start_angle, cmd->end_angle,
+                              __drawlist_unpack_color(cmd->color), cmd->thickness);
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_TEXT: {
+            const AromaDrawTextCmd* cmd = (const AromaDrawTextCmd*)header;
+            if (gfx->render_text) {
+                gfx->render_text(window_id, cmd->font, __drawlist_text(cmd), cmd->x, cmd->y,
+                                 __drawlist_unpack_color(cmd->color), cmd->scale);
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_IMAGE: {
+            const AromaDrawImageCmd* cmd = (const AromaDrawImageCmd*)header;
+            if (gfx->draw_image) {
+                gfx->draw_image(window_id, cmd->x, cmd->y, cmd->width, cmd->height, cmd->texture_id);
+            }
+            break;
+        }
+        case AROMA_DRAW_CMD_CLIP: {
+            const AromaDrawClipCmd* cmd = (const AromaDrawClipCmd*)header;
+            if (header->flags & AROMA_DRAW_FLAG_CLIP_OFF) {
+                if (gfx->clear_draw_clip) gfx->clear_draw_clip(window_id);
+            } else if (gfx->set_draw_clip) {
+                gfx->set_draw_clip(window_id, cmd->x, cmd->y, cmd->width, cmd->height);
+            }
+            break;
+        }
+    }
+}
+
+/* A replay leaves the backend unclipped, whatever clip the list ended in. */
+static void __drawlist_end_replay_clip(const AromaDrawList* list, AromaGraphicsInterface* gfx, size_t window_id)
+{
+    if (list->clip_commands && gfx->clear_draw_clip) gfx->clear_draw_clip(window_id);
 }
 
 static inline bool rect_intersects(
@@ -351,120 +972,1035 @@ static inline bool rect_intersects(
              by + bh <= ay);
 }
 
-void aroma_drawlist_smart_flush(AromaDrawList* list,
-                                size_t window_id,
-                                int x, int y, int width, int height)
+/* Screen bounds of a drawing command; false for clears and clips. */
+static bool __drawlist_bounds(const AromaDrawCmdHeader* header, int* x, int* y, int* width, int* height)
+{
+    switch ((AromaDrawCmdType)header->type) {
+        case AROMA_DRAW_CMD_FILL_RECT:
+        case AROMA_DRAW_CMD_HOLLOW_RECT: {
+            const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+            *x = cmd->x; *y = cmd->y; *width = cmd->width; *height = cmd->height;
+            return true;
+        }
+        case AROMA_DRAW_CMD_ARC: {
+            const AromaDrawArcCmd* cmd = (const AromaDrawArcCmd*)header;
+            *x = cmd->cx - cmd->radius; *y = cmd->cy - cmd->radius;
+            *width = cmd->radius * 2; *height = cmd->radius * 2;
+            return true;
+        }
+        case AROMA_DRAW_CMD_IMAGE: {
+            const AromaDrawImageCmd* cmd = (const AromaDrawImageCmd*)header;
+            *x = cmd->x; *y = cmd->y; *width = cmd->width; *height = cmd->height;
+            return true;
+        }
+        case AROMA_DRAW_CMD_TEXT: {
+            const AromaDrawTextCmd* cmd = (const AromaDrawTextCmd*)header;
+            *x = cmd->x + cmd->bounds_dx; *y = cmd->y + cmd->bounds_dy;
+            *width = cmd->bounds_width; *height = cmd->bounds_height;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool __drawlist_grow_scratch(void** items, size_t* capacity, size_t needed, size_t item_size)
+{
+    if (needed <= *capacity) return true;
+    size_t next_capacity = *capacity ? *capacity * 2 : 64;
+    while (next_capacity < needed) next_capacity *= 2;
+    void* next = realloc(*items, next_capacity * item_size);
+    if (!next) return false;
+    aroma_memory_track(AROMA_MEMORY_DRAWLIST, (ptrdiff_t)((next_capacity - *capacity) * item_size), 0);
+    *items = next;
+    *capacity = next_capacity;
+    return true;
+}
+
+static void __drawlist_batch_entry(const AromaDrawCmdHeader* header, AromaDrawBatchEntry* entry)
+{
+    int x = 0, y = 0, width = 0, height = 0;
+    entry->state = 0;
+    switch ((AromaDrawCmdType)header->type) {
+        case AROMA_DRAW_CMD_FILL_RECT:
+        case AROMA_DRAW_CMD_HOLLOW_RECT:
+            entry->kind = AROMA_DRAW_BATCH_RECT;
+            break;
+        case AROMA_DRAW_CMD_ARC:
+            entry->kind = AROMA_DRAW_BATCH_ARC;
+            break;
+        case AROMA_DRAW_CMD_IMAGE:
+            entry->kind = AROMA_DRAW_BATCH_IMAGE;
+            entry->state = ((const AromaDrawImageCmd*)header)->texture_id;
+            break;
+        case AROMA_DRAW_CMD_TEXT:
+            entry->kind = AROMA_DRAW_BATCH_TEXT;
+            entry->state = (uintptr_t)((const AromaDrawTextCmd*)header)->font;
+            break;
+        default:
+            entry->kind = AROMA_DRAW_BATCH_BARRIER;
+            return;
+    }
+    __drawlist_bounds(header, &x, &y, &width, &height);
+    entry->x0 = x;
+    entry->y0 = y;
+    entry->x1 = x + width;
+    entry->y1 = y + height;
+}
+
+static inline bool __drawlist_boxes_overlap(int ax0, int ay0, int ax1, int ay1,
+                                            int bx0, int by0, int bx1, int by1)
+{
+    return ax0 < bx1 && bx0 < ax1 && ay0 < by1 && by0 < ay1;
+}
+
+/* True when `entry` may not be drawn before the members of `group`. */
+static bool __drawlist_group_blocks(const AromaDrawList* list, const AromaDrawBatchGroup* group,
+                                    const AromaDrawBatchEntry* entry)
+{
+    if (group->kind == AROMA_DRAW_BATCH_BARRIER || entry->kind == AROMA_DRAW_BATCH_BARRIER) return true;
+    if (!__drawlist_boxes_overlap(group->x0, group->y0, group->x1, group->y1,
+                                  entry->x0, entry->y0, entry->x1, entry->y1)) {
+        return false;
+    }
+    for (uint32_t i = group->head; i != UINT32_MAX; i = list->entries[i].next) {
+        const AromaDrawBatchEntry* member = &list->entries[i];
+        if (__drawlist_boxes_overlap(member->x0, member->y0, member->x1, member->y1,
+                                     entry->x0, entry->y0, entry->x1, entry->y1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Sorts the commands into groups that bind the same state and emits the
+ * groups in the order they were opened. A command joins the latest group
+ * with its state only if no member of a newer group overlaps it, so every
+ * pair of overlapping commands keeps its painter's order. Returns the number
+ * of commands written to list->order, or 0 when scratch memory ran out.
+ */
+static size_t __drawlist_sort_batches(AromaDrawList* list)
+{
+    if (!__drawlist_grow_scratch((void**)&list->entries, &list->entry_capacity, list->count,
+                                 sizeof(AromaDrawBatchEntry)) ||
+        !__drawlist_grow_scratch((void**)&list->groups, &list->group_capacity, list->count,
+                                 sizeof(AromaDrawBatchGroup)) ||
+        !__drawlist_grow_scratch((void**)&list->order, &list->order_capacity, list->count, sizeof(uint32_t))) {
+        return 0;
+    }
+
+    size_t n = 0;
+    size_t group_count = 0;
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        AromaDrawBatchEntry* entry = &list->entries[n];
+        entry->offset = (uint32_t)((uint8_t*)header - list->bytes);
+        entry->next = UINT32_MAX;
+        __drawlist_batch_entry(header, entry);
+
+        AromaDrawBatchGroup* target = NULL;
+        size_t floor = group_count > AROMA_DRAWLIST_BATCH_WINDOW ? group_count - AROMA_DRAWLIST_BATCH_WINDOW : 0;
+        for (size_t g = group_count; g > floor; g--) {
+            AromaDrawBatchGroup* group = &list->groups[g - 1];
+            if (entry->kind != AROMA_DRAW_BATCH_BARRIER && group->kind == entry->kind && group->state == entry->state) {
+                target = group;
+                break;
+            }
+            if (__drawlist_group_blocks(list, group, entry)) break;
+        }
+
+        if (target) {
+            list->entries[target->tail].next = (uint32_t)n;
+            target->tail = (uint32_t)n;
+            if (entry->x0 < target->x0) target->x0 = entry->x0;
+            if (entry->y0 < target->y0) target->y0 = entry->y0;
+            if (entry->x1 > target->x1) target->x1 = entry->x1;
+            if (entry->y1 > target->y1) target->y1 = entry->y1;
+        } else {
+            AromaDrawBatchGroup* group = &list->groups[group_count++];
+            group->kind = entry->kind;
+            group->state = entry->state;
+            group->x0 = entry->x0;
+            group->y0 = entry->y0;
+            group->x1 = entry->x1;
+            group->y1 = entry->y1;
+            group->head = group->tail = (uint32_t)n;
+        }
+        n++;
+    }
+
+    size_t written = 0;
+    for (size_t g = 0; g < group_count; g++) {
+        for (uint32_t i = list->groups[g].head; i != UINT32_MAX; i = list->entries[i].next) {
+            list->order[written++] = list->entries[i].offset;
+        }
+    }
+    return written;
+}
+
+static void __drawlist_rect_item(const AromaDrawCmdHeader* header, AromaRectBatchItem* item)
+{
+    const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+    item->x = cmd->x;
+    item->y = cmd->y;
+    item->width = cmd->width;
+    item->height = cmd->height;
+    item->color = __drawlist_unpack_color(cmd->color);
+    item->border_width = header->type == AROMA_DRAW_CMD_HOLLOW_RECT ? cmd->border_width : 0;
+    item->is_rounded = (header->flags & AROMA_DRAW_FLAG_ROUNDED) != 0;
+    item->corner_radius = cmd->corner_radius;
+}
+
+static inline bool __drawlist_is_batchable_rect(const AromaDrawCmdHeader* header)
+{
+    if (header->type == AROMA_DRAW_CMD_FILL_RECT) return true;
+    /* A hollow rectangle without a border would turn into a fill. */
+    return header->type == AROMA_DRAW_CMD_HOLLOW_RECT && ((const AromaDrawRectCmd*)header)->border_width > 0;
+}
+
+static void __drawlist_replay_batched(AromaDrawList* list, size_t window_id, AromaGraphicsInterface* gfx)
+{
+    size_t n = __drawlist_sort_batches(list);
+    if (n == 0 && list->count != 0) {
+        /* Out of scratch memory: fall back to recording order. */
+        AROMA_DRAWLIST_FOREACH(list, header) {
+            __drawlist_execute(header, gfx, window_id);
+            list->flush_calls++;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < n;) {
+        const AromaDrawCmdHeader* header = (const AromaDrawCmdHeader*)(list->bytes + list->order[i]);
+        size_t run = i;
+        if (gfx->draw_rectangles) {
+            while (run < n &&
+                   __drawlist_is_batchable_rect((const AromaDrawCmdHeader*)(list->bytes + list->order[run]))) {
+                run++;
+            }
+        }
+        if (run - i > 1 &&
+            __drawlist_grow_scratch((void**)&list->rects, &list->rect_capacity, run - i, sizeof(AromaRectBatchItem))) {
+            for (size_t k = i; k < run; k++) {
+                __drawlist_rect_item((const AromaDrawCmdHeader*)(list->bytes + list->order[k]),
+                                     &list->rects[k - i]);
+            }
+            gfx->draw_rectangles(window_id, list->rects, run - i);
+            list->flush_calls++;
+            i = run;
+            continue;
+        }
+        __drawlist_execute(header, gfx, window_id);
+        list->flush_calls++;
+        i++;
+    }
+}
+
+void aroma_drawlist_replay(AromaDrawList* list, size_t window_id, AromaGraphicsInterface* gfx)
+{
+    if (!list || !gfx) return;
+
+    AromaDrawList* previous = g_active_drawlist;
+    g_active_drawlist = NULL;
+    list->flush_calls = 0;
+    if (list->batching) {
+        __drawlist_replay_batched(list, window_id, gfx);
+    } else {
+        AROMA_DRAWLIST_FOREACH(list, header) {
+            __drawlist_execute(header, gfx, window_id);
+            list->flush_calls++;
+        }
+    }
+    __drawlist_end_replay_clip(list, gfx, window_id);
+    g_active_drawlist = previous;
+}
+
+void aroma_drawlist_flush(AromaDrawList* list, size_t window_id)
 {
     if (!list || list->count == 0) return;
 
+    AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
+    if (!gfx) return;
+
+    aroma_drawlist_replay(list, window_id, gfx);
+    aroma_drawlist_reset(list);
+}
+
+static bool __drawlist_tile_span(const AromaDrawCmdHeader* header, int* top, int* bottom)
+{
+    /* Every tile replays the clip commands to know the clip of its draws. */
+    if (header->type == AROMA_DRAW_CMD_CLIP) {
+        *top = INT_MIN / 2;
+        *bottom = INT_MAX / 2;
+        return true;
+    }
+    int x, y, width, height;
+    if (!__drawlist_bounds(header, &x, &y, &width, &height)) return false;
+    *top = y;
+    *bottom = y + height;
+    return true;
+}
+
+/* Clears are skipped: the caller repaints only the damaged region. */
+static bool __drawlist_tile_hit(const AromaDrawCmdHeader* header, int x, int y, int width, int height)
+{
+    if (header->type == AROMA_DRAW_CMD_CLIP) return true;
+    int bx, by, bw, bh;
+    if (!__drawlist_bounds(header, &bx, &by, &bw, &bh) || bw <= 0 || bh <= 0) return false;
+    return rect_intersects(bx, by, bw, bh, x, y, width, height);
+}
+
+static inline int __drawlist_floor_div(int value, int divisor)
+{
+    int q = value / divisor;
+    return (value % divisor != 0 && value < 0) ? q - 1 : q;
+}
+
+/* Tiles [first, last] overlapping rows [top, bottom); false when none do. */
+static bool __drawlist_tile_range(const AromaDrawList* list, int top, int bottom, size_t* first, size_t* last)
+{
+    if (bottom <= top) return false;
+    int t0 = __drawlist_floor_div(top, list->bin_height);
+    int t1 = __drawlist_floor_div(bottom - 1, list->bin_height);
+    if (t1 < 0 || t0 >= (int)list->bin_count) return false;
+    *first = t0 < 0 ? 0 : (size_t)t0;
+    *last = t1 >= (int)list->bin_count ? list->bin_count - 1 : (size_t)t1;
+    return true;
+}
+
+bool aroma_drawlist_bin_tiles(AromaDrawList* list, int tile_height, int surface_height)
+{
+    if (!list) return false;
+    list->bin_count = 0;
+    if (tile_height <= 0 || surface_height <= 0 || list->used > UINT32_MAX) return false;
+
+    size_t tiles = (size_t)((surface_height + tile_height - 1) / tile_height);
+    if (!__drawlist_grow_scratch((void**)&list->bin_starts, &list->bin_start_capacity, tiles + 1, sizeof(uint32_t))) {
+        return false;
+    }
+    list->bin_count = tiles;
+    list->bin_height = tile_height;
+    memset(list->bin_starts, 0, (tiles + 1) * sizeof(uint32_t));
+
+    /* Count per tile, then turn the counts into start slots. */
+    size_t total = 0;
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        int top, bottom;
+        size_t first, last;
+        if (!__drawlist_tile_span(header, &top, &bottom)) continue;
+        if (!__drawlist_tile_range(list, top, bottom, &first, &last)) continue;
+        for (size_t t = first; t <= last; t++) list->bin_starts[t + 1]++;
+        total += last - first + 1;
+    }
+    if (!__drawlist_grow_scratch((void**)&list->bin_items, &list->bin_item_capacity, total, sizeof(uint32_t))) {
+        list->bin_count = 0;
+        return false;
+    }
+    for (size_t t = 0; t < tiles; t++) list->bin_starts[t + 1] += list->bin_starts[t];
+
+    /* Fill each tile in stream order; bin_starts[t] ends up at tile t's end. */
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        int top, bottom;
+        size_t first, last;
+        if (!__drawlist_tile_span(header, &top, &bottom)) continue;
+        if (!__drawlist_tile_range(list, top, bottom, &first, &last)) continue;
+        uint32_t offset = (uint32_t)((uint8_t*)header - list->bytes);
+        for (size_t t = first; t <= last; t++) list->bin_items[list->bin_starts[t]++] = offset;
+    }
+    memmove(list->bin_starts + 1, list->bin_starts, tiles * sizeof(uint32_t));
+    list->bin_starts[0] = 0;
+    return true;
+}
+
+void aroma_drawlist_replay_region(AromaDrawList* list, size_t window_id, AromaGraphicsInterface* gfx,
+                                  int x, int y, int width, int height)
+{
+    if (!list || !gfx || list->count == 0) return;
+
     AromaDrawList* previous = g_active_drawlist;
     g_active_drawlist = NULL;
+    /* A region that fits inside one tile only needs that tile's commands. */
+    size_t tile = list->bin_count;
+    if (list->bin_count && y >= 0 && height > 0 && y / list->bin_height == (y + height - 1) / list->bin_height) {
+        tile = (size_t)(y / list->bin_height);
+    }
+    if (tile < list->bin_count) {
+        for (uint32_t i = list->bin_starts[tile]; i < list->bin_starts[tile + 1]; i++) {
+            const AromaDrawCmdHeader* header = (const AromaDrawCmdHeader*)(list->bytes + list->bin_items[i]);
+            if (__drawlist_tile_hit(header, x, y, width, height)) {
+                __drawlist_execute(header, gfx, window_id);
+            }
+        }
+    } else {
+        AROMA_DRAWLIST_FOREACH(list, header) {
+            if (__drawlist_tile_hit(header, x, y, width, height)) {
+                __drawlist_execute(header, gfx, window_id);
+            }
+        }
+    }
+    __drawlist_end_replay_clip(list, gfx, window_id);
+    g_active_drawlist = previous;
+}
+
+void aroma_drawlist_smart_flush(AromaDrawList* list,
+                                size_t window_id,
+                                int x, int y, int width, int height)
+{
+    if (!list || list->count == 0) return;
 
     AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
-    if (!gfx) {
-        g_active_drawlist = previous;
+    if (!gfx) return;
+
+    aroma_drawlist_replay_region(list, window_id, gfx, x, y, width, height);
+}
+
+/*
+ * Occlusion. Fills are the only opaque commands: colors carry no alpha, but
+ * images may have transparent texels. An occluder is the fill minus the
+ * corners of a rounded one, in one direction or the other, and on GLES3
+ * minus the antialiased edge pixels that blend with what lies beneath; so
+ * there a fill hides the clear only if it overshoots the surface.
+ */
+#define AROMA_DRAWLIST_MAX_OCCLUDERS 16
+#ifdef ESP32
+#define AROMA_DRAWLIST_OCCLUDER_INSET 0
+#else
+#define AROMA_DRAWLIST_OCCLUDER_INSET 1
+#endif
+
+typedef struct AromaDrawOccluder {
+    int x0, y0, x1, y1;
+} AromaDrawOccluder;
+
+static inline long long __drawlist_box_area(int x0, int y0, int x1, int y1)
+{
+    return (x1 > x0 && y1 > y0) ? (long long)(x1 - x0) * (y1 - y0) : 0;
+}
+
+/* Keeps the largest occluders once the set is full. */
+static void __drawlist_add_occluder(AromaDrawOccluder* set, size_t* count, const AromaDrawOccluder* view,
+                                    int x0, int y0, int x1, int y1)
+{
+    x0 += AROMA_DRAWLIST_OCCLUDER_INSET;
+    y0 += AROMA_DRAWLIST_OCCLUDER_INSET;
+    x1 -= AROMA_DRAWLIST_OCCLUDER_INSET;
+    y1 -= AROMA_DRAWLIST_OCCLUDER_INSET;
+    /* A clipped fill covers only what the clip lets through. */
+    if (x0 < view->x0) x0 = view->x0;
+    if (y0 < view->y0) y0 = view->y0;
+    if (x1 > view->x1) x1 = view->x1;
+    if (y1 > view->y1) y1 = view->y1;
+    long long area = __drawlist_box_area(x0, y0, x1, y1);
+    if (area == 0) return;
+
+    size_t slot = *count;
+    if (slot == AROMA_DRAWLIST_MAX_OCCLUDERS) {
+        slot = 0;
+        for (size_t i = 1; i < *count; i++) {
+            if (__drawlist_box_area(set[i].x0, set[i].y0, set[i].x1, set[i].y1) <
+                __drawlist_box_area(set[slot].x0, set[slot].y0, set[slot].x1, set[slot].y1)) {
+                slot = i;
+            }
+        }
+        if (__drawlist_box_area(set[slot].x0, set[slot].y0, set[slot].x1, set[slot].y1) >= area) return;
+    } else {
+        (*count)++;
+    }
+    set[slot] = (AromaDrawOccluder){ x0, y0, x1, y1 };
+}
+
+static void __drawlist_add_fill_occluders(const AromaDrawCmdHeader* header, const AromaDrawOccluder* view,
+                                          AromaDrawOccluder* set, size_t* count)
+{
+    const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+    int x0 = cmd->x, y0 = cmd->y, x1 = cmd->x + cmd->width, y1 = cmd->y + cmd->height;
+    if (!(header->flags & AROMA_DRAW_FLAG_ROUNDED) || cmd->corner_radius <= 0.0f) {
+        __drawlist_add_occluder(set, count, view, x0, y0, x1, y1);
         return;
     }
+    int half = (cmd->width < cmd->height ? cmd->width : cmd->height) / 2;
+    int radius = cmd->corner_radius >= (float)half ? half : (int)cmd->corner_radius + 1;
+    __drawlist_add_occluder(set, count, view, x0 + radius, y0, x1 - radius, y1);
+    __drawlist_add_occluder(set, count, view, x0, y0 + radius, x1, y1 - radius);
+}
+
+static bool __drawlist_occluded(const AromaDrawOccluder* set, size_t count, const AromaDrawOccluder* box)
+{
+    if (box->x1 <= box->x0 || box->y1 <= box->y0) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (set[i].x0 <= box->x0 && set[i].y0 <= box->y0 && box->x1 <= set[i].x1 && box->y1 <= set[i].y1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void __drawlist_intersect_box(AromaDrawOccluder* box, int x0, int y0, int x1, int y1)
+{
+    if (box->x0 < x0) box->x0 = x0;
+    if (box->y0 < y0) box->y0 = y0;
+    if (box->x1 > x1) box->x1 = x1;
+    if (box->y1 > y1) box->y1 = y1;
+}
+
+size_t aroma_drawlist_cull_occluded(AromaDrawList* list, int surface_width, int surface_height)
+{
+    if (!list) return 0;
+    list->occluded = 0;
+    list->occluded_pixels = 0;
+    list->painted_pixels = 0;
+    if (list->count == 0 ||
+        !__drawlist_grow_scratch((void**)&list->entries, &list->entry_capacity, list->count,
+                                 sizeof(AromaDrawBatchEntry))) {
+        return 0;
+    }
+
+    /* Front to back first, borrowing the batching scratch: the part of the
+       surface each command can reach, given the clip in effect. */
+    bool surface_known = surface_width > 0 && surface_height > 0;
+    AromaDrawOccluder surface = { INT_MIN / 2, INT_MIN / 2, INT_MAX / 2, INT_MAX / 2 };
+    if (surface_known) surface = (AromaDrawOccluder){ 0, 0, surface_width, surface_height };
+    AromaDrawClipRect clip = list->clip_base;
+    size_t n = 0;
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        if (header->type == AROMA_DRAW_CMD_CLIP) {
+            const AromaDrawClipCmd* cmd = (const AromaDrawClipCmd*)header;
+            clip = __drawlist_clip_rect(!(header->flags & AROMA_DRAW_FLAG_CLIP_OFF), cmd->x, cmd->y,
+                                        cmd->width, cmd->height);
+        }
+        AromaDrawBatchEntry* entry = &list->entries[n++];
+        entry->offset = (uint32_t)((uint8_t*)header - list->bytes);
+        entry->kind = clip.enabled;
+        entry->next = 0;
+        AromaDrawOccluder view = surface;
+        if (clip.enabled) __drawlist_intersect_box(&view, clip.x0, clip.y0, clip.x1, clip.y1);
+        entry->x0 = view.x0;
+        entry->y0 = view.y0;
+        entry->x1 = view.x1;
+        entry->y1 = view.y1;
+    }
+
+    /* Back to front: a command is dropped when something drawn later hides it. */
+    AromaDrawOccluder occluders[AROMA_DRAWLIST_MAX_OCCLUDERS];
+    size_t occluder_count = 0;
+    bool cleared_later = false;
+    for (size_t i = n; i-- > 0;) {
+        AromaDrawBatchEntry* entry = &list->entries[i];
+        const AromaDrawCmdHeader* header = (const AromaDrawCmdHeader*)(list->bytes + entry->offset);
+        if (header->type == AROMA_DRAW_CMD_CLIP) continue;
+
+        AromaDrawOccluder view = { entry->x0, entry->y0, entry->x1, entry->y1 };
+        AromaDrawOccluder box = view;
+        bool bounded = surface_known || entry->kind;
+        bool hidden;
+        if (header->type == AROMA_DRAW_CMD_CLEAR) {
+            /* Region replays skip clears, so a clear hides nothing but earlier
+               clears, and only when it is not clipped itself. */
+            hidden = cleared_later || (bounded && __drawlist_occluded(occluders, occluder_count, &box));
+            if (!entry->kind) cleared_later = true;
+        } else {
+            int x = 0, y = 0, width = 0, height = 0;
+            __drawlist_bounds(header, &x, &y, &width, &height);
+            __drawlist_intersect_box(&box, x, y, x + width, y + height);
+            /* Only the part that can reach the surface has to be hidden. */
+            hidden = (entry->kind && __drawlist_box_area(box.x0, box.y0, box.x1, box.y1) == 0) ||
+                     __drawlist_occluded(occluders, occluder_count, &box);
+            bounded = true;
+        }
+
+        size_t area = bounded ? (size_t)__drawlist_box_area(box.x0, box.y0, box.x1, box.y1) : 0;
+        if (hidden) {
+            if (header->type == AROMA_DRAW_CMD_TEXT && (header->flags & AROMA_DRAW_FLAG_TEXT_POOL)) {
+                AromaStr str;
+                memcpy(&str, ((const AromaDrawTextCmd*)header)->tail, sizeof(str));
+                aroma_str_release(&str);
+                list->pinned--;
+            }
+            entry->next = UINT32_MAX;
+            list->occluded++;
+            list->occluded_pixels += area;
+            continue;
+        }
+        list->painted_pixels += area;
+        if (header->type == AROMA_DRAW_CMD_FILL_RECT) {
+            __drawlist_add_fill_occluders(header, &view, occluders, &occluder_count);
+        }
+    }
+    if (list->occluded == 0) return 0;
+
+    /* The stream only shrinks, so survivors slide down in place. The hash
+       still names the recorded frame, which culling does not change. */
+    size_t used = 0;
+    for (size_t i = 0; i < n; i++) {
+        const AromaDrawBatchEntry* entry = &list->entries[i];
+        size_t size = ((const AromaDrawCmdHeader*)(list->bytes + entry->offset))->size;
+        if (entry->next != UINT32_MAX) {
+            if (used != entry->offset) memmove(list->bytes + used, list->bytes + entry->offset, size);
+            used += size;
+        }
+    }
+    list->used = used;
+    list->count -= list->occluded;
+    list->bin_count = 0;
+    return list->occluded;
+}
+
+/*
+ * Capture layout, all fields little-endian:
+ *   header   "ADLC", u16 version, u16 header bytes, i32 surface width and
+ *            height, u32 command, font and texture counts
+ *   fonts    i32 line height, ascender, descender
+ *   textures u32 id, i32 largest drawn width and height, u32 uses
+ *   commands u8 type, u8 flags, u16 payload bytes, payload
+ * Payloads hold plain 32-bit fields in the order of the cmd_* arguments;
+ * text ends with its length and bytes, images with a texture table index.
+ * Clips hold the absolute clip rectangle, or a flag when they lift it.
+ * Readers skip trailing payload bytes and unknown types, so later versions
+ * may append fields without breaking older tools.
+ */
+#define AROMA_DRAWLIST_CAPTURE_MAGIC "ADLC"
+#define AROMA_DRAWLIST_CAPTURE_HEADER_BYTES 28
+#define AROMA_DRAWLIST_CAPTURE_FLAG_ROUNDED 0x01
+#define AROMA_DRAWLIST_CAPTURE_FLAG_CLIP_OFF 0x02
+
+typedef struct AromaCaptureWriter {
+    uint8_t* out;
+    size_t capacity;
+    size_t length;
+} AromaCaptureWriter;
+
+typedef struct AromaCaptureReader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+} AromaCaptureReader;
+
+static void __capture_put(AromaCaptureWriter* writer, const void* bytes, size_t length)
+{
+    if (writer->out && writer->length + length <= writer->capacity) {
+        memcpy(writer->out + writer->length, bytes, length);
+    }
+    writer->length += length;
+}
+
+static void __capture_put_u8(AromaCaptureWriter* writer, uint8_t value)
+{
+    __capture_put(writer, &value, 1);
+}
+
+static void __capture_put_u16(AromaCaptureWriter* writer, uint16_t value)
+{
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    __capture_put(writer, bytes, sizeof(bytes));
+}
+
+static void __capture_put_u32(AromaCaptureWriter* writer, uint32_t value)
+{
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    __capture_put(writer, bytes, sizeof(bytes));
+}
+
+static void __capture_put_i32(AromaCaptureWriter* writer, int value)
+{
+    __capture_put_u32(writer, (uint32_t)(int32_t)value);
+}
+
+static void __capture_put_f32(AromaCaptureWriter* writer, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    __capture_put_u32(writer, bits);
+}
+
+static bool __capture_get(AromaCaptureReader* reader, void* bytes, size_t length)
+{
+    if (reader->size - reader->offset < length) return false;
+    if (bytes) memcpy(bytes, reader->data + reader->offset, length);
+    reader->offset += length;
+    return true;
+}
+
+static bool __capture_get_u16(AromaCaptureReader* reader, uint16_t* value)
+{
+    uint8_t bytes[2];
+    if (!__capture_get(reader, bytes, sizeof(bytes))) return false;
+    *value = (uint16_t)(bytes[0] | (bytes[1] << 8));
+    return true;
+}
+
+static bool __capture_get_u32(AromaCaptureReader* reader, uint32_t* value)
+{
+    uint8_t bytes[4];
+    if (!__capture_get(reader, bytes, sizeof(bytes))) return false;
+    *value = (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return true;
+}
+
+static bool __capture_get_i32(AromaCaptureReader* reader, int* value)
+{
+    uint32_t bits;
+    if (!__capture_get_u32(reader, &bits)) return false;
+    *value = (int32_t)bits;
+    return true;
+}
+
+static bool __capture_get_f32(AromaCaptureReader* reader, float* value)
+{
+    uint32_t bits;
+    if (!__capture_get_u32(reader, &bits)) return false;
+    memcpy(value, &bits, sizeof(bits));
+    return true;
+}
+
+/* Index of `key` in `keys`, appending it when `append` is set; -1 if absent or full. */
+static long __capture_table_index(uintptr_t* keys, size_t* count, size_t capacity, uintptr_t key, bool append)
+{
+    for (size_t i = 0; i < *count; i++) {
+        if (keys[i] == key) return (long)i;
+    }
+    if (!append || *count == capacity) return -1;
+    keys[*count] = key;
+    return (long)(*count)++;
+}
+
+size_t aroma_drawlist_serialize(const AromaDrawList* list, int surface_width, int surface_height,
+                                void* out, size_t capacity)
+{
+    if (!list) return 0;
+
+    /* Every command references at most one font or texture. */
+    size_t table_capacity = list->count ? list->count : 1;
+    uintptr_t* fonts = malloc(table_capacity * sizeof(uintptr_t));
+    uintptr_t* textures = malloc(table_capacity * sizeof(uintptr_t));
+    AromaDrawCaptureTexture* texture_meta = malloc(table_capacity * sizeof(AromaDrawCaptureTexture));
+    if (!fonts || !textures || !texture_meta) {
+        free(fonts);
+        free(textures);
+        free(texture_meta);
+        return 0;
+    }
+    size_t font_count = 0, texture_count = 0;
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        if (header->type == AROMA_DRAW_CMD_TEXT) {
+            const AromaDrawTextCmd* cmd = (const AromaDrawTextCmd*)header;
+            if (cmd->font) __capture_table_index(fonts, &font_count, table_capacity, (uintptr_t)cmd->font, true);
+        } else if (header->type == AROMA_DRAW_CMD_IMAGE) {
+            const AromaDrawImageCmd* cmd = (const AromaDrawImageCmd*)header;
+            size_t before = texture_count;
+            long index = __capture_table_index(textures, &texture_count, table_capacity, cmd->texture_id, true);
+            AromaDrawCaptureTexture* meta = &texture_meta[index];
+            if (texture_count != before) *meta = (AromaDrawCaptureTexture){ cmd->texture_id, 0, 0, 0 };
+            if (cmd->width > meta->width) meta->width = cmd->width;
+            if (cmd->height > meta->height) meta->height = cmd->height;
+            meta->uses++;
+        }
+    }
 
-    for (size_t i = 0; i < list->count; i++) {
-        AromaDrawCmd* cmd = &list->commands[i];
+    AromaCaptureWriter writer = { out, capacity, 0 };
+    __capture_put(&writer, AROMA_DRAWLIST_CAPTURE_MAGIC, 4);
+    __capture_put_u16(&writer, AROMA_DRAWLIST_CAPTURE_VERSION);
+    __capture_put_u16(&writer, AROMA_DRAWLIST_CAPTURE_HEADER_BYTES);
+    __capture_put_i32(&writer, surface_width);
+    __capture_put_i32(&writer, surface_height);
+    __capture_put_u32(&writer, (uint32_t)list->count);
+    __capture_put_u32(&writer, (uint32_t)font_count);
+    __capture_put_u32(&writer, (uint32_t)texture_count);
 
-        switch (cmd->type) {
+    for (size_t i = 0; i < font_count; i++) {
+        AromaFont* font = (AromaFont*)fonts[i];
+        __capture_put_i32(&writer, aroma_font_get_line_height(font));
+        __capture_put_i32(&writer, aroma_font_get_ascender(font));
+        __capture_put_i32(&writer, aroma_font_get_descender(font));
+    }
+    for (size_t i = 0; i < texture_count; i++) {
+        __capture_put_u32(&writer, texture_meta[i].texture_id);
+        __capture_put_i32(&writer, texture_meta[i].width);
+        __capture_put_i32(&writer, texture_meta[i].height);
+        __capture_put_u32(&writer, texture_meta[i].uses);
+    }
+
+    AROMA_DRAWLIST_FOREACH(list, header) {
+        uint8_t flags = (header->flags & AROMA_DRAW_FLAG_ROUNDED) ? AROMA_DRAWLIST_CAPTURE_FLAG_ROUNDED : 0;
+        if (header->type == AROMA_DRAW_CMD_CLIP && (header->flags & AROMA_DRAW_FLAG_CLIP_OFF)) {
+            flags = AROMA_DRAWLIST_CAPTURE_FLAG_CLIP_OFF;
+        }
+        __capture_put_u8(&writer, header->type);
+        __capture_put_u8(&writer, flags);
+        switch ((AromaDrawCmdType)header->type) {
+            case AROMA_DRAW_CMD_CLEAR: {
+                const AromaDrawClearCmd* cmd = (const AromaDrawClearCmd*)header;
+                __capture_put_u16(&writer, 4);
+                __capture_put_u32(&writer, __drawlist_unpack_color(cmd->color));
+                break;
+            }
             case AROMA_DRAW_CMD_FILL_RECT:
-                if (gfx->fill_rectangle &&
-                    rect_intersects(cmd->data.fill_rect.x,
-                                    cmd->data.fill_rect.y,
-                                    cmd->data.fill_rect.width,
-                                    cmd->data.fill_rect.height,
-                                    x, y, width, height)) {
-
-                    gfx->fill_rectangle(window_id,
-                                        cmd->data.fill_rect.x,
-                                        cmd->data.fill_rect.y,
-                                        cmd->data.fill_rect.width,
-                                        cmd->data.fill_rect.height,
-                                        cmd->data.fill_rect.color,
-                                        cmd->data.fill_rect.is_rounded,
-                                        cmd->data.fill_rect.corner_radius);
-                }
+            case AROMA_DRAW_CMD_HOLLOW_RECT: {
+                const AromaDrawRectCmd* cmd = (const AromaDrawRectCmd*)header;
+                __capture_put_u16(&writer, 28);
+                __capture_put_i32(&writer, cmd->x);
+                __capture_put_i32(&writer, cmd->y);
+                __capture_put_i32(&writer, cmd->width);
+                __capture_put_i32(&writer, cmd->height);
+                __capture_put_u32(&writer, __drawlist_unpack_color(cmd->color));
+                __capture_put_i32(&writer, cmd->border_width);
+                __capture_put_f32(&writer, cmd->corner_radius);
                 break;
-
-            case AROMA_DRAW_CMD_HOLLOW_RECT:
-                if (gfx->draw_hollow_rectangle &&
-                    rect_intersects(cmd->data.hollow_rect.x,
-                                    cmd->data.hollow_rect.y,
-                                    cmd->data.hollow_rect.width,
-                                    cmd->data.hollow_rect.height,
-                                    x, y, width, height)) {
-
-                    gfx->draw_hollow_rectangle(window_id,
-                                               cmd->data.hollow_rect.x,
-                                               cmd->data.hollow_rect.y,
-                                               cmd->data.hollow_rect.width,
-                                               cmd->data.hollow_rect.height,
-                                               cmd->data.hollow_rect.color,
-                                               cmd->data.hollow_rect.border_width,
-                                               cmd->data.hollow_rect.is_rounded,
-                                               cmd->data.hollow_rect.corner_radius);
-                }
+            }
+            case AROMA_DRAW_CMD_ARC: {
+                const AromaDrawArcCmd* cmd = (const AromaDrawArcCmd*)header;
+                __capture_put_u16(&writer, 28);
+                __capture_put_i32(&writer, cmd->cx);
+                __capture_put_i32(&writer, cmd->cy);
+                __capture_put_i32(&writer, cmd->radius);
+                __capture_put_f32(&writer, cmd->start_angle);
+                __capture_put_f32(&writer, cmd->end_angle);
+                __capture_put_u32(&writer, __drawlist_unpack_color(cmd->color));
+                __capture_put_i32(&writer, cmd->thickness);
                 break;
-
-            case AROMA_DRAW_CMD_ARC:
-                if (gfx->draw_arc &&
-                    rect_intersects(cmd->data.arc.cx - cmd->data.arc.radius,
-                                    cmd->data.arc.cy - cmd->data.arc.radius,
-                                    cmd->data.arc.radius * 2,
-                                    cmd->data.arc.radius * 2,
-                                    x, y, width, height)) {
-
-                    gfx->draw_arc(window_id,
-                                  cmd->data.arc.cx,
-                                  cmd->data.arc.cy,
-                                  cmd->data.arc.radius,
-                                  cmd->data.arc.start_angle,
-                                  cmd->data.arc.end_angle,
-                                  cmd->data.arc.color,
-                                  cmd->data.arc.thickness);
-                }
+            }
+            case AROMA_DRAW_CMD_TEXT: {
+                const AromaDrawTextCmd* cmd = (const AromaDrawTextCmd*)header;
+                const char* text = __drawlist_text(cmd);
+                size_t length = strlen(text);
+                if (length > UINT16_MAX - 24) length = UINT16_MAX - 24;
+                long font = cmd->font ? __capture_table_index(fonts, &font_count, table_capacity,
+                                                              (uintptr_t)cmd->font, false) : -1;
+                __capture_put_u16(&writer, (uint16_t)(24 + length));
+                __capture_put_i32(&writer, cmd->x);
+                __capture_put_i32(&writer, cmd->y);
+                __capture_put_u32(&writer, __drawlist_unpack_color(cmd->color));
+                __capture_put_f32(&writer, cmd->scale);
+                __capture_put_u32(&writer, (uint32_t)(font + 1));
+                __capture_put_u32(&writer, (uint32_t)length);
+                __capture_put(&writer, text, length);
                 break;
-
-        case AROMA_DRAW_CMD_TEXT: {
-               int text_top    = cmd->data.text.y - 14;
-                int text_bottom = text_top + 18;
-
-                if (gfx->render_text &&
-                    text_bottom >= y &&
-                    text_top <= (y + height)) {
-
-                    gfx->render_text(window_id,
-                                     cmd->data.text.font,
-                                     cmd->data.text.text ? cmd->data.text.text : "",
-                                     cmd->data.text.x,
-                                     cmd->data.text.y,
-                                     cmd->data.text.color,
-                                     cmd->data.text.scale);
-                }
+            }
+            case AROMA_DRAW_CMD_IMAGE: {
+                const AromaDrawImageCmd* cmd = (const AromaDrawImageCmd*)header;
+                __capture_put_u16(&writer, 20);
+                __capture_put_i32(&writer, cmd->x);
+                __capture_put_i32(&writer, cmd->y);
+                __capture_put_i32(&writer, cmd->width);
+                __capture_put_i32(&writer, cmd->height);
+                __capture_put_u32(&writer, (uint32_t)__capture_table_index(textures, &texture_count, table_capacity,
+                                                                           cmd->texture_id, false));
+                break;
+            }
+            case AROMA_DRAW_CMD_CLIP: {
+                const AromaDrawClipCmd* cmd = (const AromaDrawClipCmd*)header;
+                __capture_put_u16(&writer, 16);
+                __capture_put_i32(&writer, cmd->x);
+                __capture_put_i32(&writer, cmd->y);
+                __capture_put_i32(&writer, cmd->width);
+                __capture_put_i32(&writer, cmd->height);
                 break;
             }
-          
-            case AROMA_DRAW_CMD_IMAGE:
-                if (gfx->draw_image &&
-                    rect_intersects(cmd->data.image.x,
-                                    cmd->data.image.y,
-                                    cmd->data.image.width,
-                                    cmd->data.image.height,
-                                    x, y, width, height)) {
-
-                    gfx->draw_image(window_id,
-                                    cmd->data.image.x,
-                                    cmd->data.image.y,
-                                    cmd->data.image.width,
-                                    cmd->data.image.height,
-                                    cmd->data.image.texture_id);
-                }
+            default:
+                __capture_put_u16(&writer, 0);
                 break;
         }
     }
 
-    g_active_drawlist = previous;
+    free(fonts);
+    free(textures);
+    free(texture_meta);
+    return writer.length;
+}
+
+static bool __capture_read_command(AromaCaptureReader* reader, AromaDrawList* list, AromaFont** fonts,
+                                   uint32_t font_count, const unsigned int* textures, uint32_t texture_count)
+{
+    uint8_t type, flags;
+    uint16_t payload;
+    if (!__capture_get(reader, &type, 1) || !__capture_get(reader, &flags, 1) ||
+        !__capture_get_u16(reader, &payload) || reader->size - reader->offset < payload) {
+        return false;
+    }
+    AromaCaptureReader body = { reader->data + reader->offset, payload, 0 };
+    reader->offset += payload;
+    bool rounded = (flags & AROMA_DRAWLIST_CAPTURE_FLAG_ROUNDED) != 0;
+
+    switch (type) {
+        case AROMA_DRAW_CMD_CLEAR: {
+            uint32_t color;
+            if (!__capture_get_u32(&body, &color)) return false;
+            aroma_drawlist_cmd_clear(list, color);
+            return true;
+        }
+        case AROMA_DRAW_CMD_FILL_RECT:
+        case AROMA_DRAW_CMD_HOLLOW_RECT: {
+            int x, y, width, height, border_width;
+            uint32_t color;
+            float radius;
+            if (!__capture_get_i32(&body, &x) || !__capture_get_i32(&body, &y) ||
+                !__capture_get_i32(&body, &width) || !__capture_get_i32(&body, &height) ||
+                !__capture_get_u32(&body, &color) || !__capture_get_i32(&body, &border_width) ||
+                !__capture_get_f32(&body, &radius)) {
+                return false;
+            }
+            if (type == AROMA_DRAW_CMD_FILL_RECT) {
+                aroma_drawlist_cmd_fill_rect(list, x, y, width, height, color, rounded, radius);
+            } else {
+                aroma_drawlist_cmd_hollow_rect(list, x, y, width, height, color, border_width, rounded, radius);
+            }
+            return true;
+        }
+        case AROMA_DRAW_CMD_ARC: {
+            int cx, cy, radius, thickness;
+            float start_angle, end_angle;
+            uint32_t color;
+            if (!__capture_get_i32(&body, &cx) || !__capture_get_i32(&body, &cy) ||
+                !__capture_get_i32(&body, &radius) || !__capture_get_f32(&body, &start_angle) ||
+                !__capture_get_f32(&body, &end_angle) || !__capture_get_u32(&body, &color) ||
+                !__capture_get_i32(&body, &thickness)) {
+                return false;
+            }
+            aroma_drawlist_cmd_arc(list, cx, cy, radius, start_angle, end_angle, color, thickness);
+            return true;
+        }
+        case AROMA_DRAW_CMD_TEXT: {
+            int x, y;
+            uint32_t color, font, length;
+            float scale;
+            if (!__capture_get_i32(&body, &x) || !__capture_get_i32(&body, &y) ||
+                !__capture_get_u32(&body, &color) || !__capture_get_f32(&body, &scale) ||
+                !__capture_get_u32(&body, &font) || !__capture_get_u32(&body, &length) ||
+                font > font_count || body.size - body.offset < length) {
+                return false;
+            }
+            char* text = malloc((size_t)length + 1);
+            if (!text) return false;
+            __capture_get(&body, text, length);
+            text[length] = '\0';
+            aroma_drawlist_cmd_text(list, font ? fonts[font - 1] : NULL, text, x, y, color, scale);
+            free(text);
+            return true;
+        }
+        case AROMA_DRAW_CMD_IMAGE: {
+            int x, y, width, height;
+            uint32_t texture;
+            if (!__capture_get_i32(&body, &x) || !__capture_get_i32(&body, &y) ||
+                !__capture_get_i32(&body, &width) || !__capture_get_i32(&body, &height) ||
+                !__capture_get_u32(&body, &texture) || texture >= texture_count) {
+                return false;
+            }
+            aroma_drawlist_cmd_image(list, x, y, width, height, textures[texture]);
+            return true;
+        }
+        case AROMA_DRAW_CMD_CLIP: {
+            int x, y, width, height;
+            if (!__capture_get_i32(&body, &x) || !__capture_get_i32(&body, &y) ||
+                !__capture_get_i32(&body, &width) || !__capture_get_i32(&body, &height)) {
+                return false;
+            }
+            /* Clips are captured as absolute state, so they replace the clip in effect. */
+            aroma_drawlist_cmd_set_clip(list, !(flags & AROMA_DRAWLIST_CAPTURE_FLAG_CLIP_OFF), x, y, width, height);
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+AromaDrawList* aroma_drawlist_deserialize(const void* data, size_t size, const AromaDrawCaptureOptions* options,
+                                          AromaDrawCaptureInfo* info)
+{
+    if (!data) return NULL;
+    AromaCaptureReader reader = { data, size, 0 };
+    AromaDrawCaptureInfo header = {0};
+    char magic[4];
+    uint16_t header_bytes;
+    if (!__capture_get(&reader, magic, sizeof(magic)) || memcmp(magic, AROMA_DRAWLIST_CAPTURE_MAGIC, 4) != 0 ||
+        !__capture_get_u16(&reader, &header.version) || !__capture_get_u16(&reader, &header_bytes) ||
+        !__capture_get_i32(&reader, &header.surface_width) || !__capture_get_i32(&reader, &header.surface_height) ||
+        !__capture_get_u32(&reader, &header.command_count) || !__capture_get_u32(&reader, &header.font_count) ||
+        !__capture_get_u32(&reader, &header.texture_count)) {
+        LOG_ERROR("Not a drawlist capture");
+        return NULL;
+    }
+    if (header.version == 0 || header.version > AROMA_DRAWLIST_CAPTURE_VERSION ||
+        header_bytes < AROMA_DRAWLIST_CAPTURE_HEADER_BYTES || !__capture_get(&reader, NULL,
+                                                                             header_bytes - reader.offset)) {
+        LOG_ERROR("Unsupported drawlist capture version %u", (unsigned)header.version);
+        return NULL;
+    }
+    if (header.font_count > size / 12 || header.texture_count > size / 16) return NULL;
+
+    AromaFont** fonts = calloc(header.font_count ? header.font_count : 1, sizeof(AromaFont*));
+    unsigned int* textures = calloc(header.texture_count ? header.texture_count : 1, sizeof(unsigned int));
+    AromaDrawList* list = (fonts && textures) ? aroma_drawlist_create() : NULL;
+    bool ok = list != NULL;
+    if (ok && options) aroma_drawlist_set_text_measure(list, options->measure_gfx, options->measure_window);
+
+    for (uint32_t i = 0; ok && i < header.font_count; i++) {
+        AromaDrawCaptureFont font = { i, 0, 0, 0 };
+        ok = __capture_get_i32(&reader, &font.line_height) && __capture_get_i32(&reader, &font.ascender) &&
+             __capture_get_i32(&reader, &font.descender);
+        if (ok && options && options->map_font) fonts[i] = options->map_font(&font, options->user_data);
+    }
+    for (uint32_t i = 0; ok && i < header.texture_count; i++) {
+        AromaDrawCaptureTexture texture;
+        ok = __capture_get_u32(&reader, &texture.texture_id) && __capture_get_i32(&reader, &texture.width) &&
+             __capture_get_i32(&reader, &texture.height) && __capture_get_u32(&reader, &texture.uses);
+        if (!ok) break;
+        textures[i] = (options && options->map_texture) ? options->map_texture(&texture, options->user_data)
+                                                        : texture.texture_id;
+    }
+    for (uint32_t i = 0; ok && i < header.command_count; i++) {
+        ok = __capture_read_command(&reader, list, fonts, header.font_count, textures, header.texture_count);
+    }
+
+    free(fonts);
+    free(textures);
+    if (!ok) {
+        LOG_ERROR("Truncated or corrupt drawlist capture");
+        aroma_drawlist_destroy(list);
+        return NULL;
+    }
+    if (info) *info = header;
+    return list;
+}
+
+bool aroma_drawlist_save(const AromaDrawList* list, int surface_width, int surface_height, const char* path)
+{
+    if (!list || !path) return false;
+    size_t size = aroma_drawlist_serialize(list, surface_width, surface_height, NULL, 0);
+    uint8_t* bytes = malloc(size);
+    if (!bytes) return false;
+    aroma_drawlist_serialize(list, surface_width, surface_height, bytes, size);
+
+    FILE* file = fopen(path, "wb");
+    bool ok = file && fwrite(bytes, 1, size, file) == size;
+    if (file && fclose(file) != 0) ok = false;
+    free(bytes);
+    if (!ok) LOG_ERROR("Failed to write drawlist capture %s", path);
+    return ok;
+}
+
+AromaDrawList* aroma_drawlist_load(const char* path, const AromaDrawCaptureOptions* options,
+                                   AromaDrawCaptureInfo* info)
+{
+    if (!path) return NULL;
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        LOG_ERROR("Failed to open drawlist capture %s", path);
+        return NULL;
+    }
+    uint8_t* bytes = NULL;
+    size_t size = 0, capacity = 0;
+    for (;;) {
+        if (size == capacity) {
+            capacity = capacity ? capacity * 2 : 16384;
+            uint8_t* next = realloc(bytes, capacity);
+            if (!next) break;
+            bytes = next;
+        }
+        size_t read = fread(bytes + size, 1, capacity - size, file);
+        if (read == 0) break;
+        size += read;
+    }
+    fclose(file);
+    AromaDrawList* list = aroma_drawlist_deserialize(bytes, size, options, info);
+    free(bytes);
+    return list;
 }
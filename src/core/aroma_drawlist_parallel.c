@@ -0,0 +1,166 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_drawlist.h"
+#include "core/aroma_logger.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+/* Worker i records chunk i + 1; the calling thread takes chunk 0. */
+typedef struct AromaRecordWorker {
+    pthread_t thread;
+    AromaDrawList* list;
+    uint32_t chunk;
+    uint64_t seen;      /* last generation handled; jobs from before the spawn are not ours */
+} AromaRecordWorker;
+
+static AromaRecordWorker g_workers[AROMA_DRAWLIST_MAX_RECORD_THREADS - 1];
+static uint32_t g_worker_count = 0;
+static pthread_mutex_t g_record_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_record_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_record_done = PTHREAD_COND_INITIALIZER;
+static uint64_t g_record_generation = 0;
+static uint32_t g_record_pending = 0;
+static bool g_record_stopping = false;
+
+/* The job of the current generation. */
+static AromaDrawRecordFn g_job_record = NULL;
+static void* g_job_user_data = NULL;
+static size_t g_job_window = 0;
+static uint32_t g_job_chunks = 0;
+/* Clip of `list` when the job started; chunks record under it. */
+static bool g_job_clipped = false;
+static int g_job_clip[4] = {0};
+
+static void* __record_worker_main(void* arg)
+{
+    AromaRecordWorker* worker = arg;
+
+    pthread_mutex_lock(&g_record_mutex);
+    uint64_t seen = worker->seen;
+    for (;;) {
+        while (!g_record_stopping && g_record_generation == seen) {
+            pthread_cond_wait(&g_record_wake, &g_record_mutex);
+        }
+        if (g_record_stopping) break;
+        seen = g_record_generation;
+        if (worker->chunk >= g_job_chunks) continue;
+
+        AromaDrawRecordFn record = g_job_record;
+        void* user_data = g_job_user_data;
+        uint32_t chunks = g_job_chunks;
+        size_t window_id = g_job_window;
+        bool clipped = g_job_clipped;
+        int clip[4] = { g_job_clip[0], g_job_clip[1], g_job_clip[2], g_job_clip[3] };
+        pthread_mutex_unlock(&g_record_mutex);
+
+        aroma_drawlist_reset(worker->list);
+        aroma_drawlist_set_base_clip(worker->list, clipped, clip[0], clip[1], clip[2], clip[3]);
+        aroma_drawlist_set_text_measure(worker->list, NULL, window_id);
+        aroma_drawlist_begin_worker(worker->list);
+        record(worker->chunk, chunks, user_data);
+        aroma_drawlist_end();
+
+        pthread_mutex_lock(&g_record_mutex);
+        if (--g_record_pending == 0) pthread_cond_signal(&g_record_done);
+    }
+    pthread_mutex_unlock(&g_record_mutex);
+    return NULL;
+}
+
+static void __record_workers_stop(void)
+{
+    pthread_mutex_lock(&g_record_mutex);
+    g_record_stopping = true;
+    pthread_cond_broadcast(&g_record_wake);
+    pthread_mutex_unlock(&g_record_mutex);
+
+    for (uint32_t i = 0; i < g_worker_count; i++) {
+        pthread_join(g_workers[i].thread, NULL);
+        aroma_drawlist_destroy(g_workers[i].list);
+        g_workers[i].list = NULL;
+    }
+    g_worker_count = 0;
+    g_record_stopping = false;
+}
+
+bool aroma_drawlist_set_record_threads(uint32_t threads)
+{
+    if (threads == 0) threads = 1;
+    if (threads > AROMA_DRAWLIST_MAX_RECORD_THREADS) threads = AROMA_DRAWLIST_MAX_RECORD_THREADS;
+    if (threads == g_worker_count + 1) return true;
+
+    __record_workers_stop();
+    for (uint32_t i = 0; i + 1 < threads; i++) {
+        AromaRecordWorker* worker = &g_workers[i];
+        worker->chunk = i + 1;
+        worker->seen = g_record_generation;
+        worker->list = aroma_drawlist_create();
+        if (!worker->list || pthread_create(&worker->thread, NULL, __record_worker_main, worker) != 0) {
+            aroma_drawlist_destroy(worker->list);
+            worker->list = NULL;
+            LOG_WARNING("Started %u of %u recording threads", g_worker_count + 1, threads);
+            return false;
+        }
+        g_worker_count++;
+    }
+    return true;
+}
+
+uint32_t aroma_drawlist_get_record_threads(void)
+{
+    return g_worker_count + 1;
+}
+
+void aroma_drawlist_record_parallel(AromaDrawList* list, size_t window_id, uint32_t max_chunks,
+                                    AromaDrawRecordFn record, void* user_data)
+{
+    if (!list || !record || max_chunks == 0) return;
+    uint32_t chunks = g_worker_count + 1;
+    if (chunks > max_chunks) chunks = max_chunks;
+
+    pthread_mutex_lock(&g_record_mutex);
+    g_job_record = record;
+    g_job_user_data = user_data;
+    g_job_window = window_id;
+    g_job_chunks = chunks;
+    g_job_clipped = aroma_drawlist_get_clip(list, &g_job_clip[0], &g_job_clip[1], &g_job_clip[2], &g_job_clip[3]);
+    g_record_pending = chunks - 1;
+    g_record_generation++;
+    if (chunks > 1) pthread_cond_broadcast(&g_record_wake);
+    pthread_mutex_unlock(&g_record_mutex);
+
+    AromaDrawList* previous = aroma_drawlist_get_active();
+    aroma_drawlist_begin(list);
+    record(0, chunks, user_data);
+
+    pthread_mutex_lock(&g_record_mutex);
+    while (g_record_pending > 0) pthread_cond_wait(&g_record_done, &g_record_mutex);
+    pthread_mutex_unlock(&g_record_mutex);
+
+    /* Appending in chunk order keeps the z-order of one sequential pass. */
+    for (uint32_t i = 0; i + 1 < chunks; i++) {
+        aroma_drawlist_append(list, g_workers[i].list);
+        aroma_drawlist_reset(g_workers[i].list);
+    }
+    if (previous) aroma_drawlist_begin(previous);
+    else aroma_drawlist_end();
+}
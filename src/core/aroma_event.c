@@ -78,6 +78,9 @@ static struct {
     uint64_t hovered_node_id;
 } g_mouse_state = {-1, -1, false, 0};
 
+static AromaEventObserver g_dispatch_observer = NULL;
+static AromaEventObserver g_task_hook = NULL;
+
 #ifdef AROMA_THREAD_SAFE
     #define EVENT_LOCK() pthread_mutex_lock(&g_event_system.mutex)
     #define EVENT_UNLOCK() pthread_mutex_unlock(&g_event_system.mutex)
@@ -352,6 +355,9 @@ bool aroma_event_dispatch(AromaEvent* event) {
         return false;
     }
 
+    if (g_task_hook) g_task_hook(event);
+    if (g_dispatch_observer) g_dispatch_observer(event);
+
     AromaNode* current = event->target_node;
 
     while (current && !event->consumed) {
@@ -378,6 +384,14 @@ bool aroma_event_dispatch(AromaEvent* event) {
     return event->consumed;
 }
 
+void aroma_event_set_dispatch_observer(AromaEventObserver observer) {
+    g_dispatch_observer = observer;
+}
+
+void __event_set_task_hook(AromaEventObserver hook) {
+    g_task_hook = hook;
+}
+
 bool aroma_event_queue(AromaEvent* event) {
     if (!event || !g_event_system.initialized || g_event_system.shutting_down) {
         if (event) aroma_event_destroy(event);
@@ -0,0 +1,170 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_frame_arena.h"
+#include "core/aroma_memory.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct AromaFrameArenaChunk {
+    struct AromaFrameArenaChunk* next;
+    size_t size;
+    size_t used;
+    _Alignas(AROMA_FRAME_ARENA_ALIGNMENT) unsigned char data[];
+} AromaFrameArenaChunk;
+
+struct AromaFrameArena {
+    AromaFrameArenaChunk* head;
+    AromaFrameArenaChunk* current;
+    size_t used;
+    size_t capacity;
+    size_t peak_used;
+    size_t chunk_allocs;
+    uint64_t resets;
+};
+
+static size_t __arena_align(size_t value) {
+    return (value + (AROMA_FRAME_ARENA_ALIGNMENT - 1)) & ~(size_t)(AROMA_FRAME_ARENA_ALIGNMENT - 1);
+}
+
+static AromaFrameArenaChunk* __arena_new_chunk(AromaFrameArena* arena, size_t min_size) {
+    size_t size = AROMA_FRAME_ARENA_CHUNK_SIZE;
+    while (size < min_size) size *= 2;
+    AromaFrameArenaChunk* chunk = malloc(sizeof(AromaFrameArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    arena->capacity += size;
+    arena->chunk_allocs++;
+    aroma_memory_track(AROMA_MEMORY_FRAME_ARENA, (ptrdiff_t)(sizeof(AromaFrameArenaChunk) + size), 0);
+    return chunk;
+}
+
+AromaFrameArena* aroma_frame_arena_create(void) {
+    AromaFrameArena* arena = calloc(1, sizeof(AromaFrameArena));
+    if (arena) aroma_memory_track(AROMA_MEMORY_FRAME_ARENA, (ptrdiff_t)sizeof(AromaFrameArena), 0);
+    return arena;
+}
+
+void aroma_frame_arena_destroy(AromaFrameArena* arena) {
+    if (!arena) return;
+    AromaFrameArenaChunk* chunk = arena->head;
+    while (chunk) {
+        AromaFrameArenaChunk* next = chunk->next;
+        aroma_memory_track(AROMA_MEMORY_FRAME_ARENA, -(ptrdiff_t)(sizeof(AromaFrameArenaChunk) + chunk->size), 0);
+        free(chunk);
+        chunk = next;
+    }
+    aroma_memory_track(AROMA_MEMORY_FRAME_ARENA, -(ptrdiff_t)sizeof(AromaFrameArena), 0);
+    free(arena);
+}
+
+void* aroma_frame_arena_alloc(AromaFrameArena* arena, size_t size) {
+    if (!arena) return NULL;
+    size = __arena_align(size ? size : 1);
+
+    AromaFrameArenaChunk* chunk = arena->current;
+    /* Walk chunks kept from earlier frames before asking for a new one. */
+    while (chunk && chunk->used + size > chunk->size) {
+        if (!chunk->next) break;
+        chunk = chunk->next;
+        chunk->used = 0;
+    }
+    if (!chunk || chunk->used + size > chunk->size) {
+        AromaFrameArenaChunk* fresh = __arena_new_chunk(arena, size);
+        if (!fresh) return NULL;
+        if (chunk) chunk->next = fresh;
+        else arena->head = fresh;
+        chunk = fresh;
+    }
+    arena->current = chunk;
+
+    void* ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->used += size;
+    if (arena->used > arena->peak_used) arena->peak_used = arena->used;
+    return ptr;
+}
+
+char* aroma_frame_arena_strndup(AromaFrameArena* arena, const char* text, size_t length) {
+    if (!text) return NULL;
+    char* copy = aroma_frame_arena_alloc(arena, length + 1);
+    if (!copy) return NULL;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+char* aroma_frame_arena_strdup(AromaFrameArena* arena, const char* text) {
+    if (!text) return NULL;
+    return aroma_frame_arena_strndup(arena, text, strlen(text));
+}
+
+void aroma_frame_arena_reset(AromaFrameArena* arena) {
+    if (!arena) return;
+    if (arena->head) arena->head->used = 0;
+    arena->current = arena->head;
+    arena->used = 0;
+    arena->resets++;
+}
+
+AromaFrameArenaMark aroma_frame_arena_mark(const AromaFrameArena* arena) {
+    AromaFrameArenaMark mark = {0};
+    if (!arena || !arena->current) return mark;
+    mark.chunk = arena->current;
+    mark.used = arena->current->used;
+    return mark;
+}
+
+void aroma_frame_arena_rewind(AromaFrameArena* arena, AromaFrameArenaMark mark) {
+    if (!arena) return;
+    if (!mark.chunk) {
+        /* Marked before the first chunk existed: nothing survives. */
+        if (arena->head) arena->head->used = 0;
+        arena->current = arena->head;
+        arena->used = 0;
+        return;
+    }
+    /* Recount from the head so `used` stays exact across chunk boundaries. */
+    size_t used = 0;
+    for (AromaFrameArenaChunk* chunk = arena->head; chunk; chunk = chunk->next) {
+        if (chunk == (AromaFrameArenaChunk*)mark.chunk) {
+            chunk->used = mark.used;
+            used += mark.used;
+            break;
+        }
+        used += chunk->used;
+    }
+    arena->current = (AromaFrameArenaChunk*)mark.chunk;
+    arena->used = used;
+}
+
+AromaFrameArenaStats aroma_frame_arena_get_stats(const AromaFrameArena* arena) {
+    AromaFrameArenaStats stats = {0};
+    if (!arena) return stats;
+    stats.used = arena->used;
+    stats.capacity = arena->capacity;
+    stats.peak_used = arena->peak_used;
+    stats.chunk_allocs = arena->chunk_allocs;
+    stats.resets = arena->resets;
+    return stats;
+}
@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_FRAME_ARENA_H
+#define AROMA_CORE_FRAME_ARENA_H
+
+#include <aroma_frame_arena.h>
+
+#endif
@@ -60,6 +60,8 @@ void aroma_graphics_load_font_for_window(size_t window_id, AromaFont* font)
 
 void aroma_graphics_swap_buffers(size_t window_id)
 {
+    /* The back buffer was not redrawn; the screen already shows this frame. */
+    if (aroma_ui_frame_was_skipped(window_id)) return;
     AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
     if (platform && platform->swap_buffers) {
         platform->swap_buffers(window_id);
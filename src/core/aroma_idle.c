@@ -0,0 +1,151 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_idle.h"
+#include "core/aroma_time.h"
+#include <string.h>
+
+typedef struct AromaIdleTask {
+    AromaIdleFn fn;
+    void* ctx;
+    uint32_t deferred_runs;
+    uint32_t last_run;
+} AromaIdleTask;
+
+static AromaIdleTask g_idle_queue[AROMA_MAX_IDLE_TASKS];
+static size_t g_idle_head = 0;
+static size_t g_idle_count = 0;
+static size_t g_idle_running = 0;
+static uint32_t g_idle_run_serial = 0;
+static AromaIdleStats g_idle_stats = {0};
+static uint64_t (*g_idle_now)(void) = aroma_time_now_ms;
+
+void aroma_idle_init(void) {
+    memset(g_idle_queue, 0, sizeof(g_idle_queue));
+    g_idle_head = 0;
+    g_idle_count = 0;
+    g_idle_running = 0;
+    g_idle_run_serial = 0;
+    memset(&g_idle_stats, 0, sizeof(g_idle_stats));
+}
+
+void aroma_idle_shutdown(void) {
+    aroma_idle_init();
+    g_idle_now = aroma_time_now_ms;
+}
+
+void aroma_idle_set_clock(uint64_t (*now_fn)(void)) {
+    g_idle_now = now_fn ? now_fn : aroma_time_now_ms;
+}
+
+/* A running task keeps its slot so it can always be requeued if it yields. */
+static bool __idle_push(const AromaIdleTask* task) {
+    if (g_idle_count + g_idle_running >= AROMA_MAX_IDLE_TASKS) return false;
+    g_idle_queue[(g_idle_head + g_idle_count) % AROMA_MAX_IDLE_TASKS] = *task;
+    g_idle_count++;
+    return true;
+}
+
+static AromaIdleTask __idle_pop(void) {
+    AromaIdleTask task = g_idle_queue[g_idle_head];
+    g_idle_head = (g_idle_head + 1) % AROMA_MAX_IDLE_TASKS;
+    g_idle_count--;
+    return task;
+}
+
+bool aroma_idle_post(AromaIdleFn fn, void* ctx) {
+    if (!fn) return false;
+    AromaIdleTask task = { .fn = fn, .ctx = ctx, .deferred_runs = 0, .last_run = g_idle_run_serial };
+    if (!__idle_push(&task)) {
+        g_idle_stats.dropped++;
+        return false;
+    }
+    g_idle_stats.posted++;
+    return true;
+}
+
+size_t aroma_idle_pending(void) {
+    return g_idle_count;
+}
+
+uint32_t aroma_idle_time_remaining(const AromaIdleDeadline* deadline) {
+    if (!deadline) return 0;
+    uint64_t now = g_idle_now();
+    if (now >= deadline->deadline_ms) return 0;
+    uint64_t remaining = deadline->deadline_ms - now;
+    return remaining > UINT32_MAX ? UINT32_MAX : (uint32_t)remaining;
+}
+
+size_t aroma_idle_run(uint64_t deadline_ms) {
+    if (g_idle_count == 0) return 0;
+
+    uint32_t serial = ++g_idle_run_serial;
+    size_t budget = g_idle_count;
+    size_t ran = 0;
+
+    /* Each queued task gets at most one slice per run; yielded tasks go to
+       the back so one long job cannot monopolise the slack. */
+    while (budget-- > 0 && g_idle_count > 0) {
+        AromaIdleTask* front = &g_idle_queue[g_idle_head];
+        bool starving = front->deferred_runs >= AROMA_IDLE_STARVATION_RUNS;
+        if (g_idle_now() >= deadline_ms && !starving) break;
+
+        AromaIdleTask task = __idle_pop();
+        AromaIdleDeadline deadline = { .deadline_ms = deadline_ms, .forced = starving };
+        g_idle_running++;
+        AromaIdleResult result = task.fn(task.ctx, &deadline);
+        g_idle_running--;
+        ran++;
+        g_idle_stats.executed++;
+
+        if (result == AROMA_IDLE_YIELD) {
+            task.deferred_runs = 0;
+            task.last_run = serial;
+            if (__idle_push(&task)) {
+                g_idle_stats.yielded++;
+            } else {
+                g_idle_stats.dropped++;
+            }
+        } else {
+            g_idle_stats.completed++;
+        }
+    }
+
+    for (size_t i = 0; i < g_idle_count; i++) {
+        AromaIdleTask* task = &g_idle_queue[(g_idle_head + i) % AROMA_MAX_IDLE_TASKS];
+        if (task->last_run == serial) continue;
+        task->deferred_runs++;
+        g_idle_stats.deferred++;
+        if (task->deferred_runs == AROMA_IDLE_STARVATION_RUNS) g_idle_stats.starved++;
+    }
+
+    return ran;
+}
+
+AromaIdleStats aroma_idle_get_stats(void) {
+    AromaIdleStats stats = g_idle_stats;
+    stats.pending = g_idle_count;
+    return stats;
+}
+
+void aroma_idle_reset_stats(void) {
+    memset(&g_idle_stats, 0, sizeof(g_idle_stats));
+}
@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_IDLE_H
+#define AROMA_CORE_IDLE_H
+
+#include <aroma_idle.h>
+
+#endif
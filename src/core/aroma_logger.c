@@ -1,5 +1,6 @@
 
 #include "aroma_logger.h"
+#include "aroma_memory.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -37,6 +38,7 @@ void add_log_entry(const char *log_message)
             perror("Failed to allocate memory for log entries");
             exit(EXIT_FAILURE);
         }
+        aroma_memory_track(AROMA_MEMORY_LOGGER, (ptrdiff_t)((new_capacity - log_capacity) * sizeof(LogEntry)), 0);
         log_entries = new_entries;
         log_capacity = new_capacity;
     }
@@ -47,15 +49,19 @@ void add_log_entry(const char *log_message)
         perror("Failed to allocate memory for log message");
         exit(EXIT_FAILURE);
     }
+    aroma_memory_track(AROMA_MEMORY_LOGGER, (ptrdiff_t)(strlen(log_message) + 1), 0);
     log_count++;
 }
 
 void free_log_entries()
 {
+    size_t bytes = log_capacity * sizeof(LogEntry);
     for (size_t i = 0; i < log_count; i++)
     {
+        bytes += strlen(log_entries[i].message) + 1;
         free(log_entries[i].message);
     }
+    aroma_memory_track(AROMA_MEMORY_LOGGER, -(ptrdiff_t)bytes, 0);
     free(log_entries);
     log_entries = NULL;
     log_capacity = log_count = 0;
@@ -0,0 +1,189 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_memory.h"
+#include "core/aroma_slab_alloc.h"
+#include "core/aroma_logger.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define AROMA_MEMORY_DOMAIN_COUNT 2
+#define AROMA_MEMORY_TARGET_COUNT (AROMA_MEMORY_SUBSYSTEM_COUNT + 1)
+
+static atomic_size_t g_usage[AROMA_MEMORY_SUBSYSTEM_COUNT][AROMA_MEMORY_DOMAIN_COUNT];
+static atomic_size_t g_peak[AROMA_MEMORY_SUBSYSTEM_COUNT][AROMA_MEMORY_DOMAIN_COUNT];
+static atomic_size_t g_budget[AROMA_MEMORY_TARGET_COUNT][AROMA_MEMORY_DOMAIN_COUNT];
+static atomic_bool g_over_budget[AROMA_MEMORY_TARGET_COUNT][AROMA_MEMORY_DOMAIN_COUNT];
+static atomic_uint g_budgets_set = 0;
+
+static pthread_mutex_t g_callback_mutex = PTHREAD_MUTEX_INITIALIZER;
+static AromaMemoryBudgetCallback g_budget_callback = NULL;
+static void* g_budget_user_data = NULL;
+/* A callback that logs or frees memory re-enters tracking; don't recurse. */
+static _Thread_local bool t_in_callback = false;
+
+static const char* const g_subsystem_names[AROMA_MEMORY_TARGET_COUNT] = {
+    [AROMA_MEMORY_SLAB] = "slab",
+    [AROMA_MEMORY_DRAWLIST] = "drawlist",
+    [AROMA_MEMORY_FRAME_ARENA] = "frame arena",
+    [AROMA_MEMORY_STRINGS] = "strings",
+    [AROMA_MEMORY_TEXTURES] = "textures",
+    [AROMA_MEMORY_GLYPHS] = "glyphs",
+    [AROMA_MEMORY_LOGGER] = "logger",
+    [AROMA_MEMORY_TOTAL] = "total",
+};
+
+const char* aroma_memory_subsystem_name(AromaMemorySubsystem subsystem) {
+    if ((int)subsystem < 0 || subsystem > AROMA_MEMORY_TOTAL) return "unknown";
+    return g_subsystem_names[subsystem];
+}
+
+static void __memory_raise_peak(atomic_size_t* peak, size_t value) {
+    size_t current = atomic_load_explicit(peak, memory_order_relaxed);
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(peak, &current, value,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static size_t __memory_total(AromaMemoryDomain domain) {
+    size_t total = 0;
+    for (int i = 0; i < AROMA_MEMORY_SUBSYSTEM_COUNT; i++) {
+        total += atomic_load_explicit(&g_usage[i][domain], memory_order_relaxed);
+    }
+    return total;
+}
+
+/* Edge-triggered: fires when usage crosses the budget, re-arms below it. */
+static bool __memory_check(int target, AromaMemoryDomain domain, size_t usage) {
+    size_t budget = atomic_load_explicit(&g_budget[target][domain], memory_order_relaxed);
+    bool over = budget != 0 && usage > budget;
+    if (!over) {
+        atomic_store_explicit(&g_over_budget[target][domain], false, memory_order_relaxed);
+        return false;
+    }
+    if (atomic_exchange(&g_over_budget[target][domain], true) || t_in_callback) return true;
+
+    pthread_mutex_lock(&g_callback_mutex);
+    AromaMemoryBudgetCallback callback = g_budget_callback;
+    void* user_data = g_budget_user_data;
+    pthread_mutex_unlock(&g_callback_mutex);
+
+    t_in_callback = true;
+    if (callback) {
+        callback((AromaMemorySubsystem)target, domain, usage, budget, user_data);
+    } else {
+        LOG_WARNING("Memory budget exceeded: %s %s %zu > %zu bytes", g_subsystem_names[target],
+                    domain == AROMA_MEMORY_DOMAIN_GPU ? "GPU" : "CPU", usage, budget);
+    }
+    t_in_callback = false;
+    return true;
+}
+
+static void __memory_update(AromaMemorySubsystem subsystem, AromaMemoryDomain domain, ptrdiff_t delta) {
+    size_t usage = atomic_fetch_add_explicit(&g_usage[subsystem][domain], (size_t)delta,
+                                             memory_order_relaxed) + (size_t)delta;
+    if (delta > 0) __memory_raise_peak(&g_peak[subsystem][domain], usage);
+    __memory_check(subsystem, domain, usage);
+    __memory_check(AROMA_MEMORY_TOTAL, domain, __memory_total(domain));
+}
+
+void aroma_memory_track(AromaMemorySubsystem subsystem, ptrdiff_t cpu_delta, ptrdiff_t gpu_delta) {
+    if ((int)subsystem < 0 || subsystem >= AROMA_MEMORY_SUBSYSTEM_COUNT) return;
+    if (cpu_delta) __memory_update(subsystem, AROMA_MEMORY_DOMAIN_CPU, cpu_delta);
+    if (gpu_delta) __memory_update(subsystem, AROMA_MEMORY_DOMAIN_GPU, gpu_delta);
+}
+
+/* The slab allocator is sampled rather than tracked so its hot path stays
+   free of shared atomics. */
+static void __memory_sample_slab(void) {
+    AromaMemoryStats stats = aroma_memory_system_get_stats();
+    size_t bytes = stats.node_pool.pages * stats.node_pool.page_size + stats.large_object_bytes +
+                   stats.scene_arena_bytes;
+    for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
+        bytes += stats.widget_pools[i].pages * stats.widget_pools[i].page_size;
+    }
+    atomic_store_explicit(&g_usage[AROMA_MEMORY_SLAB][AROMA_MEMORY_DOMAIN_CPU], bytes, memory_order_relaxed);
+    __memory_raise_peak(&g_peak[AROMA_MEMORY_SLAB][AROMA_MEMORY_DOMAIN_CPU], bytes);
+}
+
+AromaMemoryReport aroma_memory_report(void) {
+    AromaMemoryReport report = {0};
+    __memory_sample_slab();
+    for (int i = 0; i < AROMA_MEMORY_SUBSYSTEM_COUNT; i++) {
+        AromaMemoryUsage* usage = &report.subsystems[i];
+        usage->cpu_bytes = atomic_load_explicit(&g_usage[i][AROMA_MEMORY_DOMAIN_CPU], memory_order_relaxed);
+        usage->gpu_bytes = atomic_load_explicit(&g_usage[i][AROMA_MEMORY_DOMAIN_GPU], memory_order_relaxed);
+        usage->peak_cpu_bytes = atomic_load_explicit(&g_peak[i][AROMA_MEMORY_DOMAIN_CPU], memory_order_relaxed);
+        usage->peak_gpu_bytes = atomic_load_explicit(&g_peak[i][AROMA_MEMORY_DOMAIN_GPU], memory_order_relaxed);
+        report.total_cpu_bytes += usage->cpu_bytes;
+        report.total_gpu_bytes += usage->gpu_bytes;
+    }
+    return report;
+}
+
+void aroma_memory_report_print(void) {
+    AromaMemoryReport report = aroma_memory_report();
+    LOG_INFO("Memory report (current / peak bytes):");
+    for (int i = 0; i < AROMA_MEMORY_SUBSYSTEM_COUNT; i++) {
+        const AromaMemoryUsage* usage = &report.subsystems[i];
+        LOG_INFO("  %-12s CPU %10zu / %10zu  GPU %10zu / %10zu", g_subsystem_names[i],
+                 usage->cpu_bytes, usage->peak_cpu_bytes, usage->gpu_bytes, usage->peak_gpu_bytes);
+    }
+    LOG_INFO("  %-12s CPU %10zu  GPU %10zu", "total", report.total_cpu_bytes, report.total_gpu_bytes);
+}
+
+void aroma_memory_set_budget(AromaMemorySubsystem subsystem, AromaMemoryDomain domain, size_t bytes) {
+    if ((int)subsystem < 0 || subsystem > AROMA_MEMORY_TOTAL || domain > AROMA_MEMORY_DOMAIN_GPU) return;
+    size_t previous = atomic_exchange(&g_budget[subsystem][domain], bytes);
+    if (!previous && bytes) atomic_fetch_add(&g_budgets_set, 1);
+    if (previous && !bytes) atomic_fetch_sub(&g_budgets_set, 1);
+    atomic_store_explicit(&g_over_budget[subsystem][domain], false, memory_order_relaxed);
+}
+
+size_t aroma_memory_get_budget(AromaMemorySubsystem subsystem, AromaMemoryDomain domain) {
+    if ((int)subsystem < 0 || subsystem > AROMA_MEMORY_TOTAL || domain > AROMA_MEMORY_DOMAIN_GPU) return 0;
+    return atomic_load_explicit(&g_budget[subsystem][domain], memory_order_relaxed);
+}
+
+void aroma_memory_set_budget_callback(AromaMemoryBudgetCallback callback, void* user_data) {
+    pthread_mutex_lock(&g_callback_mutex);
+    g_budget_callback = callback;
+    g_budget_user_data = user_data;
+    pthread_mutex_unlock(&g_callback_mutex);
+}
+
+size_t aroma_memory_check_budgets(void) {
+    if (atomic_load_explicit(&g_budgets_set, memory_order_relaxed) == 0) return 0;
+    __memory_sample_slab();
+    size_t exceeded = 0;
+    for (int d = 0; d < AROMA_MEMORY_DOMAIN_COUNT; d++) {
+        for (int i = 0; i < AROMA_MEMORY_SUBSYSTEM_COUNT; i++) {
+            if (__memory_check(i, (AromaMemoryDomain)d, atomic_load_explicit(&g_usage[i][d], memory_order_relaxed))) {
+                exceeded++;
+            }
+        }
+        if (__memory_check(AROMA_MEMORY_TOTAL, (AromaMemoryDomain)d, __memory_total((AromaMemoryDomain)d))) {
+            exceeded++;
+        }
+    }
+    return exceeded;
+}
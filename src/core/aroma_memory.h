@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_MEMORY_H
+#define AROMA_CORE_MEMORY_H
+
+#include <aroma_memory.h>
+
+#endif
@@ -23,6 +23,8 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_event.h"
 #include "core/aroma_slab_alloc.h"
+#include "core/aroma_animation.h"
+#include "core/aroma_alloc_profile.h"
 #include <inttypes.h>
 #include <stdatomic.h>
 #include <string.h>
@@ -34,6 +36,10 @@ static atomic_uint_fast64_t global_node_id_counter = 1;
 static AromaNode* g_dirty_nodes[AROMA_MAX_DIRTY_NODES];
 static size_t g_dirty_count = 0;
 
+static AromaRect g_dirty_region = {0};
+static bool g_dirty_region_valid = false;
+static bool g_dirty_region_full = false;
+
 uint64_t __generate_node_id(void) {
     return atomic_fetch_add(&global_node_id_counter, 1);
 }
@@ -58,6 +64,27 @@ void __node_system_destroy(void) {
     LOG_INFO("Node system destroyed.");
 }
 
+/* The arena that carves a new child of `parent` on this thread, if any. */
+static AromaSceneArena* __scene_arena_for(const AromaNode* parent) {
+    AromaSceneArena* arena = aroma_scene_arena_current();
+    if (!arena || !parent) return NULL;
+    if (parent->scene_arena == arena) return arena;
+    return aroma_scene_arena_get_root(arena) ? NULL : arena;
+}
+
+void* (aroma_widget_alloc_under)(AromaNode* parent, size_t size) {
+    void* widget = aroma_scene_arena_alloc(__scene_arena_for(parent), size);
+    return widget ? widget : (aroma_widget_alloc)(size);
+}
+
+#ifdef AROMA_ALLOC_PROFILE
+void* aroma_widget_alloc_under_at(AromaNode* parent, size_t size, const char* file, int line) {
+    void* widget = (aroma_widget_alloc_under)(parent, size);
+    if (widget) aroma_alloc_profile_record_alloc(widget, size, file, line);
+    return widget;
+}
+#endif
+
 AromaNode* __create_node(AromaNodeType node_type, AromaNode* parent_node, void* node_widget_ptr) {
 
     if (node_type == NODE_TYPE_ROOT && parent_node != NULL) {
@@ -80,7 +107,14 @@ AromaNode* __create_node(AromaNodeType node_type, AromaNode* parent_node, void*
         return NULL;
     }
 
-    AromaNode* new_node = (AromaNode*)__slab_pool_alloc(&global_memory_system.node_pool);
+    AromaSceneArena* arena = __scene_arena_for(parent_node);
+    AromaNode* new_node = (AromaNode*)aroma_scene_arena_alloc(arena, sizeof(AromaNode));
+    if (new_node) {
+        if (!aroma_scene_arena_get_root(arena)) aroma_scene_arena_set_root(arena, new_node);
+    } else {
+        arena = NULL;
+        new_node = (AromaNode*)__slab_pool_alloc(&global_memory_system.node_pool);
+    }
     if (!new_node) {
         LOG_CRITICAL("Failed to allocate memory for new node.");
         return NULL;
@@ -96,11 +130,20 @@ AromaNode* __create_node(AromaNodeType node_type, AromaNode* parent_node, void*
     new_node->is_dirty = false;  
     new_node->is_hidden = false;
     new_node->propagate_dirty = true;
+    new_node->scene_arena = arena;
+    AROMA_ALLOC_PROFILE_TAG(new_node, node_type);
+    AROMA_ALLOC_PROFILE_TAG(node_widget_ptr, node_type);
 
     for (uint64_t i = 0; i < AROMA_MAX_CHILD_NODES; i++) {
         new_node->child_nodes[i] = NULL;
     }
 
+    /* A pool node under a carved parent outlives the arena's chunks, so the
+       scene's teardown has to find it. */
+    if (parent_node && parent_node->scene_arena && !arena) {
+        aroma_scene_arena_track(parent_node->scene_arena, AROMA_SCENE_ARENA_GUESTS, new_node);
+    }
+
     LOG_INFO("Created node ID: %llu, type: %d", new_node->node_id, node_type);
     return new_node;
 }
@@ -129,6 +172,12 @@ AromaNode* __add_child_node(AromaNodeType node_type, AromaNode* parent_node, voi
     return new_node;
 }
 
+static void __scene_untrack_guest(AromaNode* parent_node, AromaNode* node) {
+    if (parent_node && parent_node->scene_arena && !node->scene_arena) {
+        aroma_scene_arena_untrack(parent_node->scene_arena, AROMA_SCENE_ARENA_GUESTS, node);
+    }
+}
+
 AromaNode* __remove_child_node(AromaNode* parent_node, uint64_t node_id) {
     if (!parent_node) {
         LOG_ERROR("Parent node is NULL.");
@@ -145,6 +194,8 @@ AromaNode* __remove_child_node(AromaNode* parent_node, uint64_t node_id) {
 
             parent_node->child_nodes[parent_node->child_count - 1] = NULL;
             parent_node->child_count--;
+            __scene_untrack_guest(parent_node, removed_node);
+            removed_node->parent_node = NULL;
 
             LOG_INFO("Removed child node ID: %llu from parent ID: %llu", 
                       node_id, parent_node->node_id);
@@ -169,7 +220,15 @@ void __destroy_node(AromaNode* node) {
         }
     }
 
+    aroma_animation_cancel_node(node);
+
+    if (node->scene_arena && node->destroy_cb) {
+        aroma_scene_arena_untrack(node->scene_arena, AROMA_SCENE_ARENA_HOOKS, node);
+    }
+    __scene_untrack_guest(node->parent_node, node);
+
     if (node->node_widget_ptr) {
+        if (node->destroy_cb) node->destroy_cb(node);
         aroma_widget_free(node->node_widget_ptr);
     }
 
@@ -188,6 +247,29 @@ void __destroy_node_tree(AromaNode* root_node) {
     LOG_INFO("Destroyed entire node tree");
 }
 
+void aroma_node_destroy_scene(AromaNode* scene_root, AromaSceneArena* arena) {
+    if (scene_root && scene_root->parent_node) {
+        __remove_child_node(scene_root->parent_node, scene_root->node_id);
+    }
+    if (scene_root && scene_root->scene_arena != arena) {
+        /* Built outside the arena: nothing to skip. */
+        __destroy_node(scene_root);
+    } else if (arena) {
+        /* Carved nodes need no freeing, so only what the scene holds outside
+           its chunks is visited: subtrees attached from the pools, then the
+           destroy hooks, latest first so children go before their parents. */
+        aroma_animation_cancel_scene(arena);
+        AromaNode* node;
+        while ((node = aroma_scene_arena_pop(arena, AROMA_SCENE_ARENA_GUESTS))) {
+            __destroy_node(node);
+        }
+        while ((node = aroma_scene_arena_pop(arena, AROMA_SCENE_ARENA_HOOKS))) {
+            if (node->node_widget_ptr) node->destroy_cb(node);
+        }
+    }
+    aroma_scene_arena_destroy(arena);
+}
+
 AromaNode* __find_node_by_id(AromaNode* root, uint64_t node_id) {
     if (!root) return NULL;
 
@@ -276,6 +358,7 @@ void aroma_node_invalidate(AromaNode* node) {
 
     node->is_dirty = true;
     aroma_dirty_list_add(node);
+    aroma_dirty_region_mark_full();
 
     if (node->propagate_dirty && node->parent_node) {
         aroma_node_invalidate(node->parent_node);
@@ -294,6 +377,15 @@ void aroma_node_invalidate_tree(AromaNode* root) {
     }
 }
 
+void aroma_node_invalidate_rect(AromaNode* node, int x, int y, int width, int height) {
+    if (!node || width <= 0 || height <= 0) return;
+
+    /* Damage stays local to the rect: the node is queued for redraw but the
+       dirty flag is not propagated to ancestors. */
+    aroma_dirty_list_add(node);
+    aroma_dirty_region_add(x, y, width, height);
+}
+
 bool aroma_node_is_dirty(AromaNode* node) {
     return node ? node->is_dirty : false;
 }
@@ -313,6 +405,14 @@ AromaNodeDrawFn aroma_node_get_draw_cb(AromaNode* node) {
     return node ? node->draw_cb : NULL;
 }
 
+void aroma_node_set_destroy_cb(AromaNode* node, AromaNodeDestroyFn destroy_cb) {
+    if (!node) return;
+    AromaSceneArena* arena = node->scene_arena;
+    if (arena && !node->destroy_cb && destroy_cb) aroma_scene_arena_track(arena, AROMA_SCENE_ARENA_HOOKS, node);
+    if (arena && node->destroy_cb && !destroy_cb) aroma_scene_arena_untrack(arena, AROMA_SCENE_ARENA_HOOKS, node);
+    node->destroy_cb = destroy_cb;
+}
+
 void aroma_node_set_hidden(AromaNode* node, bool hidden) {
     if (!node) return;
     if (node->is_hidden != hidden) {
@@ -331,6 +431,8 @@ bool aroma_node_is_hidden(AromaNode* node) {
 void aroma_dirty_list_init(void) {
     g_dirty_count = 0;
     memset(g_dirty_nodes, 0, sizeof(g_dirty_nodes));
+    g_dirty_region_valid = false;
+    g_dirty_region_full = false;
 }
 
 void aroma_dirty_list_clear(void) {
@@ -340,6 +442,8 @@ void aroma_dirty_list_clear(void) {
         }
     }
     g_dirty_count = 0;
+    g_dirty_region_valid = false;
+    g_dirty_region_full = false;
 }
 
 AromaNode** aroma_dirty_list_get(size_t* count) {
@@ -358,3 +462,31 @@ void aroma_dirty_list_add(AromaNode* node) {
 
     g_dirty_nodes[g_dirty_count++] = node;
 }
+
+void aroma_dirty_region_add(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+
+    if (!g_dirty_region_valid) {
+        g_dirty_region = (AromaRect){ x, y, width, height };
+        g_dirty_region_valid = true;
+        return;
+    }
+
+    int x0 = g_dirty_region.x < x ? g_dirty_region.x : x;
+    int y0 = g_dirty_region.y < y ? g_dirty_region.y : y;
+    int x1 = g_dirty_region.x + g_dirty_region.width;
+    int y1 = g_dirty_region.y + g_dirty_region.height;
+    if (x + width > x1) x1 = x + width;
+    if (y + height > y1) y1 = y + height;
+    g_dirty_region = (AromaRect){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+void aroma_dirty_region_mark_full(void) {
+    g_dirty_region_full = true;
+}
+
+bool aroma_dirty_region_get(AromaRect* out_rect) {
+    if (g_dirty_region_full || !g_dirty_region_valid) return false;
+    if (out_rect) *out_rect = g_dirty_region;
+    return true;
+}
@@ -0,0 +1,146 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_post.h"
+#include "core/aroma_node.h"
+#include <pthread.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t node_id;
+    AromaPostApplyFn apply;
+    AromaPostValue value;
+} AromaPostedUpdate;
+
+typedef struct {
+    AromaPostedUpdate updates[AROMA_MAX_POSTED_UPDATES];
+    size_t count;
+} AromaPostBuffer;
+
+/* Producers fill one buffer while the UI thread drains the other, so the
+   lock is never held while widgets are being updated. */
+static AromaPostBuffer g_post_buffers[2];
+static int g_post_back = 0;
+static AromaPostStats g_post_stats = {0};
+static pthread_mutex_t g_post_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+void aroma_post_init(void) {
+    pthread_mutex_lock(&g_post_mutex);
+    memset(g_post_buffers, 0, sizeof(g_post_buffers));
+    g_post_back = 0;
+    memset(&g_post_stats, 0, sizeof(g_post_stats));
+    pthread_mutex_unlock(&g_post_mutex);
+}
+
+void aroma_post_shutdown(void) {
+    aroma_post_init();
+}
+
+bool aroma_post_update(uint64_t node_id, AromaPostApplyFn apply, const AromaPostValue* value) {
+    if (node_id == AROMA_NODE_ID_INVALID || !apply || !value) return false;
+
+    pthread_mutex_lock(&g_post_mutex);
+    AromaPostBuffer* buffer = &g_post_buffers[g_post_back];
+    AromaPostedUpdate* slot = NULL;
+    for (size_t i = 0; i < buffer->count; i++) {
+        if (buffer->updates[i].node_id == node_id && buffer->updates[i].apply == apply) {
+            slot = &buffer->updates[i];
+            g_post_stats.coalesced++;
+            break;
+        }
+    }
+    if (!slot) {
+        if (buffer->count >= AROMA_MAX_POSTED_UPDATES) {
+            g_post_stats.dropped++;
+            pthread_mutex_unlock(&g_post_mutex);
+            return false;
+        }
+        slot = &buffer->updates[buffer->count++];
+        slot->node_id = node_id;
+        slot->apply = apply;
+    }
+    slot->value = *value;
+    g_post_stats.posted++;
+    pthread_mutex_unlock(&g_post_mutex);
+    return true;
+}
+
+bool aroma_post_text(uint64_t node_id, AromaPostApplyFn apply, const char* text) {
+    if (!text) return false;
+    AromaPostValue value;
+    strncpy(value.text, text, AROMA_POST_TEXT_MAX - 1);
+    value.text[AROMA_POST_TEXT_MAX - 1] = '\0';
+    return aroma_post_update(node_id, apply, &value);
+}
+
+bool aroma_post_float(uint64_t node_id, AromaPostApplyFn apply, float f) {
+    AromaPostValue value;
+    value.f = f;
+    return aroma_post_update(node_id, apply, &value);
+}
+
+size_t aroma_post_flush(AromaPostResolveFn resolve) {
+    pthread_mutex_lock(&g_post_mutex);
+    AromaPostBuffer* front = &g_post_buffers[g_post_back];
+    g_post_back ^= 1;
+    g_post_buffers[g_post_back].count = 0;
+    pthread_mutex_unlock(&g_post_mutex);
+
+    size_t applied = 0;
+    size_t stale = 0;
+    for (size_t i = 0; i < front->count; i++) {
+        AromaPostedUpdate* update = &front->updates[i];
+        AromaNode* node = resolve ? resolve(update->node_id) : NULL;
+        if (!node) {
+            stale++;
+            continue;
+        }
+        update->apply(node, &update->value);
+        applied++;
+    }
+    front->count = 0;
+
+    pthread_mutex_lock(&g_post_mutex);
+    g_post_stats.applied += applied;
+    g_post_stats.stale += stale;
+    pthread_mutex_unlock(&g_post_mutex);
+    return applied;
+}
+
+size_t aroma_post_pending(void) {
+    pthread_mutex_lock(&g_post_mutex);
+    size_t pending = g_post_buffers[g_post_back].count;
+    pthread_mutex_unlock(&g_post_mutex);
+    return pending;
+}
+
+AromaPostStats aroma_post_get_stats(void) {
+    pthread_mutex_lock(&g_post_mutex);
+    AromaPostStats stats = g_post_stats;
+    pthread_mutex_unlock(&g_post_mutex);
+    return stats;
+}
+
+void aroma_post_reset_stats(void) {
+    pthread_mutex_lock(&g_post_mutex);
+    memset(&g_post_stats, 0, sizeof(g_post_stats));
+    pthread_mutex_unlock(&g_post_mutex);
+}
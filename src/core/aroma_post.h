@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_POST_H
+#define AROMA_CORE_POST_H
+
+#include <aroma_post.h>
+
+#endif
@@ -21,17 +21,252 @@
 
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_logger.h"
+#include "core/aroma_alloc_profile.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/* Keeps the cross-thread and refill paths out of the owner's inlined fast path. */
+#if defined(__GNUC__)
+#define AROMA_SLAB_COLD __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define AROMA_SLAB_COLD __declspec(noinline)
+#else
+#define AROMA_SLAB_COLD
+#endif
+
+static const size_t WIDGET_BUCKET_SIZES[AROMA_WIDGET_BUCKET_COUNT] = AROMA_WIDGET_BUCKET_SIZES;
+static const size_t WIDGET_PAGE_SIZES[AROMA_WIDGET_BUCKET_COUNT] = AROMA_WIDGET_PAGE_SIZES;
+#define AROMA_SLAB_CLASS_COUNT (AROMA_WIDGET_BUCKET_COUNT + 1)
 
-static const size_t WIDGET_BUCKET_SIZES[AROMA_WIDGET_BUCKET_COUNT] = {32, 64, 128, 256, 512, 1024, 2048};
 AromaMemorySystem global_memory_system = {0};
 
-void __slab_pool_init(AromaSlabAllocator* pool, size_t object_size) {
+static _Alignas(AROMA_GENERIC_PAGE_SIZE) uint8_t g_preallocated_pages[AROMA_MAX_PAGES][AROMA_GENERIC_PAGE_SIZE];
+
+/* Pools of a thread other than the owner of global_memory_system. The
+   owning thread publishes `published` under the depot lock whenever its page
+   count changes or it flushes, so readers never touch the live counters. */
+struct AromaSlabThreadHeap {
+    AromaSlabAllocator node_pool;
+    AromaSlabAllocator widget_pools[AROMA_WIDGET_BUCKET_COUNT];
+    AromaSlabPoolStats published[AROMA_SLAB_CLASS_COUNT];
+    unsigned generation;
+    bool orphaned;
+    struct AromaSlabThreadHeap* next;
+};
+
+/* Cross-thread frees waiting to be handed to the depot, one per size class. */
+typedef struct AromaSlabMagazine {
+    AromaSlabAllocator* pool;
+    AromaFreeSlot* head;
+    AromaFreeSlot* tail;
+    uint32_t count;
+} AromaSlabMagazine;
+
+/*
+ * The depot lock guards every pool's remote_frees, the heap registry and the
+ * large-object list; the page lock guards the preallocated-page bitmap. The
+ * depot lock may be held while taking the page lock, never the other way.
+ */
+static pthread_mutex_t g_depot_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_page_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t g_heap_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_heap_key;
+static AromaSlabThreadHeap* g_thread_heaps = NULL;
+static atomic_bool g_remote_pending = false;
+/* Bumped by init and destroy; thread-local state from an older generation
+   belongs to a torn-down memory system and is discarded. */
+static atomic_uint g_generation = 1;
+static AromaSlabThreadHeap g_foreign_thread;
+/* Each init and each thread heap draws a fresh key, so a key left behind in
+   a thread's storage never matches a pool of a later memory system. */
+static atomic_uint g_next_owner_key = 1;
+
+#define AROMA_SLAB_NO_OWNER_KEY UINT_MAX
+
+/* The key of the pools this thread may touch without locking. */
+static _Thread_local unsigned t_owner_key = AROMA_SLAB_NO_OWNER_KEY;
+static _Thread_local AromaSlabThreadHeap* t_heap = NULL;
+static _Thread_local unsigned t_magazine_generation = 0;
+static _Thread_local bool t_exit_hooked = false;
+static _Thread_local AromaSlabMagazine t_magazines[AROMA_SLAB_CLASS_COUNT];
+static _Thread_local AromaSceneArena* t_scene_arena = NULL;
+
+typedef struct AromaSceneArenaTracked {
+    void** objects;
+    size_t count;
+    size_t capacity;
+} AromaSceneArenaTracked;
+
+struct AromaSceneArena {
+    AromaSlabAllocatorPage* chunks;   /* newest first, linked through next_page */
+    uint8_t* cursor;
+    uint8_t* limit;
+    void* root;                       /* see aroma_scene_arena_set_root */
+    AromaSceneArenaTracked tracked[AROMA_SCENE_ARENA_LIST_COUNT];
+    AromaSceneArenaStats stats;
+};
+
+static atomic_size_t g_scene_arena_chunks = 0;
+
+static inline size_t __slab_align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static void* __slab_aligned_alloc(size_t alignment, size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    return aligned_alloc(alignment, __slab_align_up(size, alignment));
+#endif
+}
+
+static void __slab_aligned_free(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+static inline int __slab_ctz32(uint32_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (int)index;
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+static AromaSlabAllocatorPage* __slab_claim_preallocated_page(void) {
+    pthread_mutex_lock(&g_page_mutex);
+    for (int w = 0; w < AROMA_PAGE_BITMAP_WORDS; w++) {
+        uint32_t free_bits = ~global_memory_system.page_used_bitmap[w];
+        if (w == AROMA_PAGE_BITMAP_WORDS - 1 && AROMA_MAX_PAGES % 32)
+            free_bits &= (1u << (AROMA_MAX_PAGES % 32)) - 1;
+        if (!free_bits) continue;
+
+        int bit = __slab_ctz32(free_bits);
+        global_memory_system.page_used_bitmap[w] |= 1u << bit;
+        pthread_mutex_unlock(&g_page_mutex);
+        return (AromaSlabAllocatorPage*)g_preallocated_pages[w * 32 + bit];
+    }
+    pthread_mutex_unlock(&g_page_mutex);
+    return NULL;
+}
+
+static void __slab_page_init(AromaSlabAllocatorPage* page, AromaSlabAllocator* pool, size_t page_size,
+                             uint8_t is_stack_page) {
+    memset(page, 0, sizeof(*page));
+    page->magic = AROMA_SLAB_PAGE_MAGIC;
+    page->is_stack_page = is_stack_page;
+    page->page_size = page_size;
+    page->pool = pool;
+    page->self = page;
+}
+
+static void __slab_page_release(AromaSlabAllocatorPage* page) {
+    page->magic = 0;
+    page->self = NULL;
+    if (page->is_stack_page) {
+        size_t index = (size_t)((uint8_t (*)[AROMA_GENERIC_PAGE_SIZE])page - g_preallocated_pages);
+        pthread_mutex_lock(&g_page_mutex);
+        global_memory_system.page_used_bitmap[index / 32] &= ~(1u << (index % 32));
+        pthread_mutex_unlock(&g_page_mutex);
+    } else {
+        __slab_aligned_free(page);
+    }
+}
+
+AromaSlabAllocatorPage* __slab_page_from_ptr(const void* object) {
+    if (!object) return NULL;
+    uintptr_t addr = (uintptr_t)object;
+    /* Probe the smallest alignment first: those probes always stay inside
+       the page that owns the object, so nothing unmapped is ever read. Pages
+       never overlap, so a live header at the probe owns the object. */
+    for (size_t align = AROMA_GENERIC_PAGE_SIZE; align <= AROMA_SLAB_MAX_PAGE_SIZE; align <<= 1) {
+        AromaSlabAllocatorPage* page = (AromaSlabAllocatorPage*)(addr & ~(uintptr_t)(align - 1));
+        if (page->magic == AROMA_SLAB_PAGE_MAGIC && page->self == page) {
+            return addr - (uintptr_t)page < page->page_size ? page : NULL;
+        }
+    }
+    return NULL;
+}
+
+static void __slab_list_unlink(AromaSlabAllocator* pool, AromaSlabAllocatorPage* page) {
+    if (page->prev_page) page->prev_page->next_page = page->next_page;
+    else pool->pages = page->next_page;
+    if (page->next_page) page->next_page->prev_page = page->prev_page;
+    else pool->pages_tail = page->prev_page;
+    page->prev_page = NULL;
+    page->next_page = NULL;
+}
+
+static void __slab_list_push_head(AromaSlabAllocator* pool, AromaSlabAllocatorPage* page) {
+    page->prev_page = NULL;
+    page->next_page = pool->pages;
+    if (pool->pages) pool->pages->prev_page = page;
+    else pool->pages_tail = page;
+    pool->pages = page;
+}
+
+static void __slab_list_push_tail(AromaSlabAllocator* pool, AromaSlabAllocatorPage* page) {
+    page->next_page = NULL;
+    page->prev_page = pool->pages_tail;
+    if (pool->pages_tail) pool->pages_tail->next_page = page;
+    else pool->pages = page;
+    pool->pages_tail = page;
+}
+
+/* Objects follow the header and a per-slot table of requested sizes, which
+   keeps fragmentation accounting exact without a per-object header. */
+static inline uint16_t* __slab_page_slot_sizes(AromaSlabAllocatorPage* page) {
+    return (uint16_t*)((uint8_t*)page + AROMA_SLAB_HEADER_SIZE);
+}
+
+static inline size_t __slab_slot_index(const AromaSlabAllocator* pool, const AromaSlabAllocatorPage* page,
+                                       const void* object) {
+    size_t offset = (size_t)((const uint8_t*)object - (const uint8_t*)page - pool->objects_offset);
+    return pool->object_shift ? offset >> pool->object_shift : offset / pool->object_size;
+}
+
+static size_t __slab_objects_offset(size_t capacity) {
+    return __slab_align_up(AROMA_SLAB_HEADER_SIZE + capacity * sizeof(uint16_t), AROMA_SLAB_ALIGNMENT);
+}
+
+void __slab_pool_init(AromaSlabAllocator* pool, size_t object_size, size_t page_size) {
     if (!pool) return;
     memset(pool, 0, sizeof(AromaSlabAllocator));
-    pool->object_size = object_size;
-    
+    pool->class_index = AROMA_SLAB_CLASS_NONE;
+    pool->requested_size = object_size;
+    pool->object_size = __slab_align_up(object_size, AROMA_SLAB_ALIGNMENT);
+    if ((pool->object_size & (pool->object_size - 1)) == 0) {
+        while (((size_t)1 << pool->object_shift) < pool->object_size) pool->object_shift++;
+    }
+    /* A page always holds at least one whole object after its header. */
+    size_t min_page_size = pool->object_size + __slab_objects_offset(1);
+    pool->page_size = page_size < AROMA_GENERIC_PAGE_SIZE ? AROMA_GENERIC_PAGE_SIZE : page_size;
+    while (pool->page_size < min_page_size) pool->page_size <<= 1;
+    if (pool->page_size > AROMA_SLAB_MAX_PAGE_SIZE) {
+        LOG_ERROR("Slab page size %zu exceeds AROMA_SLAB_MAX_PAGE_SIZE", pool->page_size);
+    }
+
+    size_t capacity = (pool->page_size - AROMA_SLAB_HEADER_SIZE) / (pool->object_size + sizeof(uint16_t));
+    while (capacity > 1 && __slab_objects_offset(capacity) + capacity * pool->object_size > pool->page_size) {
+        capacity--;
+    }
+    pool->page_capacity = (uint32_t)capacity;
+    pool->objects_offset = __slab_objects_offset(capacity);
 }
 
 void __slab_pool_destroy(AromaSlabAllocator* pool) {
@@ -40,144 +275,822 @@ void __slab_pool_destroy(AromaSlabAllocator* pool) {
     AromaSlabAllocatorPage* page = pool->pages;
     while (page) {
         AromaSlabAllocatorPage* next = page->next_page;
-        if (!page->is_stack_page) {
-            free(page);
-        }
+        __slab_page_release(page);
         page = next;
     }
     
-    pool->free_list = NULL;
-    pool->pages = NULL;
     memset(pool, 0, sizeof(AromaSlabAllocator));
 }
 
-void* __slab_pool_alloc(AromaSlabAllocator* pool) {
-    if (!pool) return NULL;
+static AromaSlabAllocatorPage* __slab_pool_grow(AromaSlabAllocator* pool) {
+    AromaSlabAllocatorPage* page = NULL;
+    
+    /* Only generic-sized pages come from the preallocated set. */
+    if (pool->page_size == AROMA_GENERIC_PAGE_SIZE) {
+        page = __slab_claim_preallocated_page();
+        if (page) __slab_page_init(page, pool, pool->page_size, 1);
+    }
+    
+    if (!page) {
+        page = __slab_aligned_alloc(pool->page_size, pool->page_size);
+        if (!page) return NULL;
+        __slab_page_init(page, pool, pool->page_size, 0);
+        pool->malloc_fallbacks++;
+    }
 
-    if (!pool->free_list) {
-        AromaSlabAllocatorPage* new_page = NULL;
-        
-        for (int i = 0; i < AROMA_MAX_PAGES; i++) {
-            if (!global_memory_system.page_used[i]) {
-                new_page = &global_memory_system.preallocated_pages[i];
-                global_memory_system.page_used[i] = 1;
-                new_page->is_stack_page = 1;
-                new_page->next_page = NULL;
-                break;
-            }
-        }
-        
-        if (!new_page) {
-            new_page = malloc(sizeof(AromaSlabAllocatorPage));
-            if (!new_page) return NULL;
-            new_page->is_stack_page = 0;
-            new_page->next_page = NULL;
+    page->capacity = pool->page_capacity;
+
+    /* Thread the slots so the lowest address is handed out first. */
+    uint8_t* current = (uint8_t*)page + pool->objects_offset + (size_t)page->capacity * pool->object_size;
+    for (uint32_t i = 0; i < page->capacity; i++) {
+        current -= pool->object_size;
+        AromaFreeSlot* slot = (AromaFreeSlot*)current;
+        slot->next = page->free_list;
+        page->free_list = slot;
+    }
+
+    __slab_list_push_head(pool, page);
+    pool->total_pages++;
+    pool->empty_pages++;
+    if (pool->total_pages > pool->peak_pages) pool->peak_pages = pool->total_pages;
+    return page;
+}
+
+static size_t __slab_pool_drain_remote(AromaSlabAllocator* pool);
+static void __slab_pool_publish(AromaSlabAllocator* pool);
+
+static AROMA_SLAB_COLD AromaSlabAllocatorPage* __slab_pool_refill(AromaSlabAllocator* pool) {
+    /* Objects other threads gave back may fill the gap without a new page. */
+    AromaSlabAllocatorPage* page = __slab_pool_drain_remote(pool) ? pool->pages : NULL;
+    if (page && page->free_list) return page;
+    page = __slab_pool_grow(pool);
+    __slab_pool_publish(pool);
+    return page;
+}
+
+static inline void* __slab_pool_alloc_sized(AromaSlabAllocator* pool, size_t size) {
+    AromaSlabAllocatorPage* page = pool->pages;
+    if (!page || !page->free_list) {
+        page = __slab_pool_refill(pool);
+        if (!page) return NULL;
+    }
+
+    AromaFreeSlot* object = page->free_list;
+    page->free_list = object->next;
+    if (page->live_count++ == 0) pool->empty_pages--;
+    if (!page->free_list) {
+        __slab_list_unlink(pool, page);
+        __slab_list_push_tail(pool, page);
+    }
+    __slab_page_slot_sizes(page)[__slab_slot_index(pool, page, object)] = (uint16_t)size;
+    pool->requested_bytes += size;
+    pool->total_allocated++;
+    if (++pool->in_use > pool->peak_in_use) pool->peak_in_use = pool->in_use;
+    return object;
+}
+
+static inline void __slab_page_free_object(AromaSlabAllocatorPage* page, void* object) {
+    AromaSlabAllocator* pool = page->pool;
+    bool was_full = page->free_list == NULL;
+
+    pool->requested_bytes -= __slab_page_slot_sizes(page)[__slab_slot_index(pool, page, object)];
+    AromaFreeSlot* slot = (AromaFreeSlot*)object;
+    slot->next = page->free_list;
+    page->free_list = slot;
+    page->live_count--;
+    pool->in_use--;
+    pool->total_freed++;
+
+    if (page->live_count == 0) {
+        /* Empty pages are only handed back by the next trim, so a screen
+           rebuilt within the same frame reuses them. */
+        pool->empty_pages++;
+        if (pool->empty_pages > AROMA_SLAB_EMPTY_PAGES_KEPT) pool->trim_pending = true;
+    }
+    if (was_full) {
+        __slab_list_unlink(pool, page);
+        __slab_list_push_head(pool, page);
+    }
+}
+
+static inline bool __slab_is_local_pool(const AromaSlabAllocator* pool) {
+    return pool->owner_key == t_owner_key;
+}
+
+static inline bool __slab_is_owner_thread(void) {
+    return __slab_is_local_pool(&global_memory_system.node_pool);
+}
+
+static unsigned __slab_next_owner_key(void) {
+    unsigned key;
+    do {
+        key = atomic_fetch_add_explicit(&g_next_owner_key, 1, memory_order_relaxed);
+    } while (key == 0 || key == AROMA_SLAB_NO_OWNER_KEY);
+    return key;
+}
+
+static void __slab_heap_pools_init(AromaSlabAllocator* node_pool, AromaSlabAllocator* widget_pools,
+                                   AromaSlabThreadHeap* owner, unsigned owner_key) {
+    __slab_pool_init(node_pool, sizeof(AromaNode), AROMA_GENERIC_PAGE_SIZE);
+    node_pool->class_index = 0;
+    node_pool->owner = owner;
+    node_pool->owner_key = owner_key;
+    for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
+        __slab_pool_init(&widget_pools[i], WIDGET_BUCKET_SIZES[i], WIDGET_PAGE_SIZES[i]);
+        widget_pools[i].class_index = (uint8_t)(i + 1);
+        widget_pools[i].owner = owner;
+        widget_pools[i].owner_key = owner_key;
+    }
+}
+
+static void __slab_heap_pools_destroy(AromaSlabAllocator* node_pool, AromaSlabAllocator* widget_pools) {
+    for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) __slab_pool_destroy(&widget_pools[i]);
+    __slab_pool_destroy(node_pool);
+}
+
+static inline AromaSlabAllocator* __slab_heap_pool(AromaSlabAllocator* node_pool, AromaSlabAllocator* widget_pools,
+                                                   int class_index) {
+    return class_index == 0 ? node_pool : &widget_pools[class_index - 1];
+}
+
+static void __slab_thread_exit(void* arg);
+
+static void __slab_heap_key_create(void) {
+    pthread_key_create(&g_heap_key, __slab_thread_exit);
+}
+
+static AROMA_SLAB_COLD AromaSlabThreadHeap* __slab_thread_heap(void) {
+    unsigned generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    if (t_heap && t_heap->generation == generation) return t_heap;
+    /* A heap from before the last destroy already lost its pages. */
+    free(t_heap);
+    t_heap = NULL;
+
+    pthread_once(&g_heap_key_once, __slab_heap_key_create);
+    AromaSlabThreadHeap* heap = calloc(1, sizeof(AromaSlabThreadHeap));
+    if (!heap) return NULL;
+    __slab_heap_pools_init(&heap->node_pool, heap->widget_pools, heap, __slab_next_owner_key());
+    heap->generation = generation;
+
+    pthread_mutex_lock(&g_depot_mutex);
+    heap->next = g_thread_heaps;
+    g_thread_heaps = heap;
+    pthread_mutex_unlock(&g_depot_mutex);
+
+    pthread_setspecific(g_heap_key, heap);
+    t_heap = heap;
+    t_owner_key = heap->node_pool.owner_key;
+    t_exit_hooked = true;
+    return heap;
+}
+
+/* Heap the calling thread may touch without locking; NULL is the owner's. */
+static inline AromaSlabThreadHeap* __slab_current_owner(void) {
+    if (__slab_is_owner_thread()) return NULL;
+    unsigned generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    return (t_heap && t_heap->generation == generation) ? t_heap : &g_foreign_thread;
+}
+
+/* Maps one of the global pools onto the calling thread's copy of it. */
+static AromaSlabAllocator* __slab_thread_pool(AromaSlabAllocator* pool) {
+    if (__slab_is_local_pool(pool) || pool->owner || pool->class_index == AROMA_SLAB_CLASS_NONE) return pool;
+    AromaSlabThreadHeap* heap = __slab_thread_heap();
+    if (!heap) return NULL;
+    return __slab_heap_pool(&heap->node_pool, heap->widget_pools, pool->class_index);
+}
+
+static AromaSlabMagazine* __slab_thread_magazines(void) {
+    unsigned generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    if (t_magazine_generation != generation) {
+        /* Anything still queued belonged to a memory system that is gone. */
+        memset(t_magazines, 0, sizeof(t_magazines));
+        t_magazine_generation = generation;
+    }
+    return t_magazines;
+}
+
+static void __slab_magazine_flush(AromaSlabMagazine* magazine) {
+    if (!magazine->count) return;
+    pthread_mutex_lock(&g_depot_mutex);
+    /* Resolved under the lock: adoption may have moved the pages since. */
+    AromaSlabAllocator* pool = __slab_page_from_ptr(magazine->head)->pool;
+    magazine->tail->next = pool->remote_frees;
+    pool->remote_frees = magazine->head;
+    pool->remote_count += magazine->count;
+    atomic_store_explicit(&g_remote_pending, true, memory_order_relaxed);
+    pthread_mutex_unlock(&g_depot_mutex);
+    memset(magazine, 0, sizeof(*magazine));
+}
+
+static AROMA_SLAB_COLD void __slab_magazine_push(AromaSlabAllocator* pool, void* object) {
+    if (!t_exit_hooked) {
+        /* Threads that only free still hand their last partial magazines
+           back when they exit. */
+        pthread_once(&g_heap_key_once, __slab_heap_key_create);
+        pthread_setspecific(g_heap_key, &g_foreign_thread);
+        t_exit_hooked = true;
+    }
+    AromaSlabMagazine* magazine = &__slab_thread_magazines()[pool->class_index];
+    if (magazine->pool != pool) __slab_magazine_flush(magazine);
+    AromaFreeSlot* slot = (AromaFreeSlot*)object;
+    slot->next = magazine->head;
+    magazine->head = slot;
+    if (!magazine->tail) magazine->tail = slot;
+    magazine->pool = pool;
+    if (++magazine->count >= AROMA_SLAB_MAGAZINE_SIZE) __slab_magazine_flush(magazine);
+}
+
+static inline void __slab_free_object(AromaSlabAllocatorPage* page, void* object) {
+    AromaSlabAllocator* pool = page->pool;
+    if (__slab_is_local_pool(pool) || pool->class_index == AROMA_SLAB_CLASS_NONE) {
+        __slab_page_free_object(page, object);
+    } else {
+        __slab_magazine_push(pool, object);
+    }
+}
+
+/* Copies a worker pool's counters to where aroma_memory_system_get_stats reads
+   them; the owner's pools are read in place. */
+static void __slab_pool_publish(AromaSlabAllocator* pool) {
+    AromaSlabThreadHeap* heap = pool->owner;
+    if (!heap || heap == &g_foreign_thread) return;
+    AromaSlabPoolStats stats = aroma_slab_pool_get_stats(pool);
+    pthread_mutex_lock(&g_depot_mutex);
+    heap->published[pool->class_index] = stats;
+    pthread_mutex_unlock(&g_depot_mutex);
+}
+
+static size_t __slab_pool_drain_remote(AromaSlabAllocator* pool) {
+    pthread_mutex_lock(&g_depot_mutex);
+    AromaFreeSlot* slot = pool->remote_frees;
+    pool->remote_frees = NULL;
+    pool->remote_count = 0;
+    pthread_mutex_unlock(&g_depot_mutex);
+
+    size_t drained = 0;
+    while (slot) {
+        AromaFreeSlot* next = slot->next;
+        __slab_free_object(__slab_page_from_ptr(slot), slot);
+        drained++;
+        slot = next;
+    }
+    return drained;
+}
+
+static void* __scene_arena_alloc(AromaSceneArena* arena, size_t size) {
+    size = __slab_align_up(size, AROMA_SLAB_ALIGNMENT);
+    if (size > AROMA_SCENE_ARENA_CHUNK_SIZE - AROMA_SLAB_HEADER_SIZE) {
+        arena->stats.fallback_allocs++;
+        return NULL;
+    }
+    if (!arena->cursor || (size_t)(arena->limit - arena->cursor) < size) {
+        AromaSlabAllocatorPage* chunk = __slab_aligned_alloc(AROMA_SCENE_ARENA_CHUNK_SIZE, AROMA_SCENE_ARENA_CHUNK_SIZE);
+        if (!chunk) {
+            arena->stats.fallback_allocs++;
+            return NULL;
         }
+        __slab_page_init(chunk, NULL, AROMA_SCENE_ARENA_CHUNK_SIZE, 0);
+        chunk->scene_arena = arena;
+        chunk->next_page = arena->chunks;
+        arena->chunks = chunk;
+        arena->cursor = (uint8_t*)chunk + AROMA_SLAB_HEADER_SIZE;
+        arena->limit = (uint8_t*)chunk + AROMA_SCENE_ARENA_CHUNK_SIZE;
+        arena->stats.chunks++;
+        arena->stats.bytes_reserved += AROMA_SCENE_ARENA_CHUNK_SIZE;
+        atomic_fetch_add_explicit(&g_scene_arena_chunks, 1, memory_order_relaxed);
+    }
+    void* object = arena->cursor;
+    arena->cursor += size;
+    arena->stats.bytes_used += size;
+    arena->stats.objects++;
+    return object;
+}
+
+AromaSceneArena* aroma_scene_arena_create(void) {
+    return calloc(1, sizeof(AromaSceneArena));
+}
+
+void aroma_scene_arena_destroy(AromaSceneArena* arena) {
+    if (!arena) return;
+    if (t_scene_arena == arena) t_scene_arena = NULL;
+    AromaSlabAllocatorPage* chunk = arena->chunks;
+    while (chunk) {
+        AromaSlabAllocatorPage* next = chunk->next_page;
+        __slab_page_release(chunk);
+        chunk = next;
+    }
+    atomic_fetch_sub_explicit(&g_scene_arena_chunks, arena->stats.chunks, memory_order_relaxed);
+    for (int i = 0; i < AROMA_SCENE_ARENA_LIST_COUNT; i++) free(arena->tracked[i].objects);
+    free(arena);
+}
+
+AromaSceneArena* aroma_scene_arena_begin(AromaSceneArena* arena) {
+    AromaSceneArena* previous = t_scene_arena;
+    t_scene_arena = arena;
+    return previous;
+}
+
+void aroma_scene_arena_end(AromaSceneArena* previous) {
+    t_scene_arena = previous;
+}
 
-        size_t objects_per_page = AROMA_GENERIC_PAGE_SIZE / pool->object_size;
-        if (objects_per_page == 0) objects_per_page = 1;
+AromaSceneArena* aroma_scene_arena_current(void) {
+    return t_scene_arena;
+}
+
+bool aroma_scene_arena_owns(const void* object) {
+    return aroma_scene_arena_of(object) != NULL;
+}
+
+AromaSceneArena* aroma_scene_arena_of(const void* object) {
+    AromaSlabAllocatorPage* page = __slab_page_from_ptr(object);
+    return page ? page->scene_arena : NULL;
+}
+
+void* aroma_scene_arena_alloc(AromaSceneArena* arena, size_t size) {
+    return arena && size ? __scene_arena_alloc(arena, size) : NULL;
+}
+
+void* aroma_scene_arena_get_root(const AromaSceneArena* arena) {
+    return arena ? arena->root : NULL;
+}
+
+void aroma_scene_arena_set_root(AromaSceneArena* arena, void* root) {
+    if (arena) arena->root = root;
+}
 
-        uint8_t* current = new_page->data;
-        for (size_t i = 0; i < objects_per_page; i++) {
-            AromaFreeSlot* slot = (AromaFreeSlot*)current;
-            slot->next = pool->free_list;
-            pool->free_list = slot;
-            current += pool->object_size;
+bool aroma_scene_arena_track(AromaSceneArena* arena, AromaSceneArenaList list, void* object) {
+    if (!arena || !object || list >= AROMA_SCENE_ARENA_LIST_COUNT) return false;
+    AromaSceneArenaTracked* tracked = &arena->tracked[list];
+    if (tracked->count == tracked->capacity) {
+        size_t capacity = tracked->capacity ? tracked->capacity * 2 : 32;
+        void** objects = realloc(tracked->objects, capacity * sizeof(void*));
+        if (!objects) {
+            LOG_ERROR("Scene arena lost track of %p; its teardown will skip it", object);
+            return false;
         }
+        tracked->objects = objects;
+        tracked->capacity = capacity;
+    }
+    tracked->objects[tracked->count++] = object;
+    return true;
+}
 
-        new_page->next_page = pool->pages;
-        pool->pages = new_page;
-        pool->total_pages++;
+void aroma_scene_arena_untrack(AromaSceneArena* arena, AromaSceneArenaList list, void* object) {
+    if (!arena || list >= AROMA_SCENE_ARENA_LIST_COUNT) return;
+    AromaSceneArenaTracked* tracked = &arena->tracked[list];
+    /* Recent objects are the likeliest to go early. */
+    for (size_t i = tracked->count; i-- > 0;) {
+        if (tracked->objects[i] == object) {
+            memmove(&tracked->objects[i], &tracked->objects[i + 1], (tracked->count - i - 1) * sizeof(void*));
+            tracked->count--;
+            return;
+        }
     }
+}
 
-    void* object = pool->free_list;
-    pool->free_list = pool->free_list->next;
-    pool->total_allocated++;
+void* aroma_scene_arena_pop(AromaSceneArena* arena, AromaSceneArenaList list) {
+    if (!arena || list >= AROMA_SCENE_ARENA_LIST_COUNT) return NULL;
+    AromaSceneArenaTracked* tracked = &arena->tracked[list];
+    return tracked->count ? tracked->objects[--tracked->count] : NULL;
+}
+
+AromaSceneArenaStats aroma_scene_arena_get_stats(const AromaSceneArena* arena) {
+    AromaSceneArenaStats stats = {0};
+    if (arena) stats = arena->stats;
+    return stats;
+}
+
+void* (__slab_pool_alloc)(AromaSlabAllocator* pool) {
+    if (!pool) return NULL;
+    pool = __slab_thread_pool(pool);
+    if (!pool) return NULL;
+    return __slab_pool_alloc_sized(pool, pool->requested_size);
+}
+
+#ifdef AROMA_ALLOC_PROFILE
+void* __slab_pool_alloc_at(AromaSlabAllocator* pool, const char* file, int line) {
+    void* object = (__slab_pool_alloc)(pool);
+    if (object) aroma_alloc_profile_record_alloc(object, pool->requested_size, file, line);
     return object;
 }
+#endif
 
 void __slab_pool_free(AromaSlabAllocator* pool, void* object) {
     if (!pool || !object) return;
-    AromaFreeSlot* slot = (AromaFreeSlot*)object;
-    slot->next = pool->free_list;
-    pool->free_list = slot;
-    pool->total_freed++;
+    AromaSlabAllocatorPage* page = __slab_page_from_ptr(object);
+    if (page && page->scene_arena) {
+#ifdef AROMA_ALLOC_PROFILE
+        aroma_alloc_profile_record_free(object);
+#endif
+        return;
+    }
+    /* Any thread's copy of a pool accepts objects of the same class. */
+    bool same_class = page && page->pool && pool->class_index != AROMA_SLAB_CLASS_NONE &&
+                      page->pool->class_index == pool->class_index;
+    if (!page || (page->pool != pool && !same_class)) {
+        LOG_ERROR("__slab_pool_free: %p does not belong to this pool", object);
+        return;
+    }
+#ifdef AROMA_ALLOC_PROFILE
+    aroma_alloc_profile_record_free(object);
+#endif
+    __slab_free_object(page, object);
 }
 
-static uint8_t __find_bucket_index(size_t size) {
-    for (uint8_t i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
+static int __find_bucket_index(size_t size) {
+    for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
         if (size <= WIDGET_BUCKET_SIZES[i]) {
             return i;
         }
     }
-    return AROMA_WIDGET_BUCKET_COUNT - 1;
+    return -1;
+}
+
+static AROMA_SLAB_COLD void* __large_object_alloc(size_t size) {
+    /* Aligned to the smallest page size so the first masking probe finds it. */
+    size_t span = AROMA_SLAB_HEADER_SIZE + size;
+    AromaSlabAllocatorPage* page = __slab_aligned_alloc(AROMA_GENERIC_PAGE_SIZE, span);
+    if (!page) return NULL;
+    __slab_page_init(page, NULL, span, 0);
+
+    pthread_mutex_lock(&g_depot_mutex);
+    page->next_page = global_memory_system.large_objects;
+    if (page->next_page) page->next_page->prev_page = page;
+    global_memory_system.large_objects = page;
+    global_memory_system.large_object_count++;
+    global_memory_system.large_object_bytes += size;
+    if (global_memory_system.large_object_bytes > global_memory_system.peak_large_object_bytes)
+        global_memory_system.peak_large_object_bytes = global_memory_system.large_object_bytes;
+    pthread_mutex_unlock(&g_depot_mutex);
+    return (uint8_t*)page + AROMA_SLAB_HEADER_SIZE;
 }
 
-void* aroma_widget_alloc(size_t size) {
+static AROMA_SLAB_COLD void __large_object_free(AromaSlabAllocatorPage* page) {
+    pthread_mutex_lock(&g_depot_mutex);
+    if (page->prev_page) page->prev_page->next_page = page->next_page;
+    else global_memory_system.large_objects = page->next_page;
+    if (page->next_page) page->next_page->prev_page = page->prev_page;
+    global_memory_system.large_object_count--;
+    global_memory_system.large_object_bytes -= page->page_size - AROMA_SLAB_HEADER_SIZE;
+    pthread_mutex_unlock(&g_depot_mutex);
+    __slab_page_release(page);
+}
+
+void* (aroma_widget_alloc)(size_t size) {
     if (size == 0) return NULL;
-    uint8_t bucket_index = __find_bucket_index(size);
-    size_t bucket_size = WIDGET_BUCKET_SIZES[bucket_index];
-    void* allocation = __slab_pool_alloc(&global_memory_system.widget_pools[bucket_index]);
-    if (!allocation) return NULL;
-    uint8_t* tagged_ptr = (uint8_t*)allocation;
-    *tagged_ptr = bucket_index;
-    void* widget_ptr = tagged_ptr + 1;
-    return widget_ptr;
+    int bucket_index = __find_bucket_index(size);
+    if (bucket_index < 0) return __large_object_alloc(size);
+    AromaSlabAllocator* pools = global_memory_system.widget_pools;
+    if (!__slab_is_local_pool(&pools[0])) {
+        AromaSlabThreadHeap* heap = __slab_thread_heap();
+        if (!heap) return NULL;
+        pools = heap->widget_pools;
+    }
+    return __slab_pool_alloc_sized(&pools[bucket_index], size);
+}
+
+#ifdef AROMA_ALLOC_PROFILE
+void* aroma_widget_alloc_at(size_t size, const char* file, int line) {
+    void* widget = (aroma_widget_alloc)(size);
+    if (widget) aroma_alloc_profile_record_alloc(widget, size, file, line);
+    return widget;
 }
+#endif
 
 void aroma_widget_free(void* widget) {
     if (!widget) return;
-    uint8_t* tagged_ptr = (uint8_t*)widget - 1;
-    uint8_t bucket_index = *tagged_ptr;
-    if (bucket_index >= AROMA_WIDGET_BUCKET_COUNT) return;
-    __slab_pool_free(&global_memory_system.widget_pools[bucket_index], tagged_ptr);
+    AromaSlabAllocatorPage* page = __slab_page_from_ptr(widget);
+    if (!page) {
+        LOG_ERROR("aroma_widget_free: %p is not a widget allocation", widget);
+        return;
+    }
+#ifdef AROMA_ALLOC_PROFILE
+    aroma_alloc_profile_record_free(widget);
+#endif
+    /* Reclaimed with the whole arena. */
+    if (page->scene_arena) return;
+    if (!page->pool) {
+        __large_object_free(page);
+        return;
+    }
+    __slab_free_object(page, widget);
+}
+
+void aroma_memory_thread_flush(void) {
+    AromaSlabMagazine* magazines = __slab_thread_magazines();
+    for (int i = 0; i < AROMA_SLAB_CLASS_COUNT; i++) __slab_magazine_flush(&magazines[i]);
+    AromaSlabThreadHeap* heap = __slab_current_owner();
+    if (!heap) return;
+    for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+        __slab_pool_publish(__slab_heap_pool(&heap->node_pool, heap->widget_pools, c));
+    }
+}
+
+static bool __slab_thread_magazines_empty(void) {
+    AromaSlabMagazine* magazines = __slab_thread_magazines();
+    for (int i = 0; i < AROMA_SLAB_CLASS_COUNT; i++) {
+        if (magazines[i].count) return false;
+    }
+    return true;
+}
+
+/* Caller holds the depot lock, so frees queued meanwhile re-resolve to `into`. */
+static void __slab_pool_merge(AromaSlabAllocator* into, AromaSlabAllocator* from) {
+    AromaSlabAllocatorPage* page = from->pages;
+    while (page) {
+        AromaSlabAllocatorPage* next = page->next_page;
+        page->pool = into;
+        if (page->free_list) __slab_list_push_head(into, page);
+        else __slab_list_push_tail(into, page);
+        page = next;
+    }
+    if (from->remote_frees) {
+        AromaFreeSlot* tail = from->remote_frees;
+        while (tail->next) tail = tail->next;
+        tail->next = into->remote_frees;
+        into->remote_frees = from->remote_frees;
+        into->remote_count += from->remote_count;
+    }
+    into->total_pages += from->total_pages;
+    into->empty_pages += from->empty_pages;
+    into->in_use += from->in_use;
+    into->requested_bytes += from->requested_bytes;
+    into->malloc_fallbacks += from->malloc_fallbacks;
+    into->total_allocated += from->total_allocated;
+    into->total_freed += from->total_freed;
+    if (into->total_pages > into->peak_pages) into->peak_pages = into->total_pages;
+    if (into->in_use > into->peak_in_use) into->peak_in_use = into->in_use;
+    if (into->empty_pages > AROMA_SLAB_EMPTY_PAGES_KEPT) into->trim_pending = true;
+    memset(from, 0, sizeof(AromaSlabAllocator));
+}
+
+/* Takes over the pools of exited threads that still had live objects. */
+static void __slab_adopt_orphans(void) {
+    AromaSlabThreadHeap* adopted = NULL;
+    pthread_mutex_lock(&g_depot_mutex);
+    AromaSlabThreadHeap** link = &g_thread_heaps;
+    while (*link) {
+        AromaSlabThreadHeap* heap = *link;
+        if (!heap->orphaned) {
+            link = &heap->next;
+            continue;
+        }
+        *link = heap->next;
+        for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+            __slab_pool_merge(__slab_heap_pool(&global_memory_system.node_pool, global_memory_system.widget_pools, c),
+                              __slab_heap_pool(&heap->node_pool, heap->widget_pools, c));
+        }
+        heap->next = adopted;
+        adopted = heap;
+    }
+    pthread_mutex_unlock(&g_depot_mutex);
+
+    while (adopted) {
+        AromaSlabThreadHeap* next = adopted->next;
+        free(adopted);
+        adopted = next;
+    }
+}
+
+static void __slab_thread_exit(void* arg) {
+    AromaSlabThreadHeap* heap = (AromaSlabThreadHeap*)arg;
+    unsigned generation = atomic_load_explicit(&g_generation, memory_order_relaxed);
+    if (t_magazine_generation == generation) aroma_memory_thread_flush();
+    t_heap = NULL;
+    if (heap == &g_foreign_thread) return;
+    if (heap->generation != generation) {
+        free(heap);
+        return;
+    }
+
+    bool empty = true;
+    for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+        AromaSlabAllocator* pool = __slab_heap_pool(&heap->node_pool, heap->widget_pools, c);
+        __slab_pool_drain_remote(pool);
+        if (pool->in_use) empty = false;
+    }
+
+    /* With nothing live no other thread can still queue frees to this heap. */
+    pthread_mutex_lock(&g_depot_mutex);
+    if (empty) {
+        AromaSlabThreadHeap** link = &g_thread_heaps;
+        while (*link && *link != heap) link = &(*link)->next;
+        if (*link) *link = heap->next;
+    } else {
+        heap->orphaned = true;
+        atomic_store_explicit(&g_remote_pending, true, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&g_depot_mutex);
+
+    if (empty) {
+        __slab_heap_pools_destroy(&heap->node_pool, heap->widget_pools);
+        free(heap);
+    }
+}
+
+size_t aroma_memory_system_trim(void) {
+    AromaSlabAllocator* pools[AROMA_SLAB_CLASS_COUNT];
+    AromaSlabAllocator* node_pool = &global_memory_system.node_pool;
+    AromaSlabAllocator* widget_pools = global_memory_system.widget_pools;
+    if (__slab_is_owner_thread()) {
+        /* Cleared before draining so frees queued meanwhile re-arm it. */
+        atomic_store_explicit(&g_remote_pending, false, memory_order_relaxed);
+        aroma_memory_thread_flush();
+        __slab_adopt_orphans();
+    } else {
+        AromaSlabThreadHeap* owner = __slab_current_owner();
+        if (owner == &g_foreign_thread) return 0;
+        aroma_memory_thread_flush();
+        node_pool = &owner->node_pool;
+        widget_pools = owner->widget_pools;
+    }
+    for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) pools[c] = __slab_heap_pool(node_pool, widget_pools, c);
+
+    size_t released = 0;
+    for (int i = 0; i < AROMA_SLAB_CLASS_COUNT; i++) {
+        AromaSlabAllocator* pool = pools[i];
+        __slab_pool_drain_remote(pool);
+        if (pool->trim_pending) {
+            pool->trim_pending = false;
+
+            AromaSlabAllocatorPage* page = pool->pages;
+            while (page && pool->empty_pages > AROMA_SLAB_EMPTY_PAGES_KEPT) {
+                AromaSlabAllocatorPage* next = page->next_page;
+                if (page->live_count == 0) {
+                    __slab_list_unlink(pool, page);
+                    pool->empty_pages--;
+                    pool->total_pages--;
+                    __slab_page_release(page);
+                    released++;
+                }
+                page = next;
+            }
+        }
+        __slab_pool_publish(pool);
+    }
+    return released;
+}
+
+bool aroma_memory_system_trim_pending(void) {
+    AromaSlabAllocator* node_pool = &global_memory_system.node_pool;
+    AromaSlabAllocator* widget_pools = global_memory_system.widget_pools;
+    if (__slab_is_owner_thread()) {
+        if (atomic_load_explicit(&g_remote_pending, memory_order_relaxed)) return true;
+    } else {
+        AromaSlabThreadHeap* owner = __slab_current_owner();
+        if (owner == &g_foreign_thread) return false;
+        node_pool = &owner->node_pool;
+        widget_pools = owner->widget_pools;
+    }
+    if (!__slab_thread_magazines_empty()) return true;
+    for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+        if (__slab_heap_pool(node_pool, widget_pools, c)->trim_pending) return true;
+    }
+    return false;
 }
 
 void aroma_memory_system_init(void) {
+    /* Re-initialising must not strand heap pages from a previous session. */
+    aroma_memory_system_destroy();
+    unsigned key = __slab_next_owner_key();
+    __slab_heap_pools_init(&global_memory_system.node_pool, global_memory_system.widget_pools, NULL, key);
+    t_owner_key = key;
+}
+
+/* Must not race with allocation on other threads. Their heaps lose their
+   pages here; each thread drops its stale heap on next use or at exit. */
+void aroma_memory_system_destroy(void) {
+    atomic_fetch_add_explicit(&g_generation, 1, memory_order_relaxed);
+    pthread_mutex_lock(&g_depot_mutex);
+    AromaSlabThreadHeap* heap = g_thread_heaps;
+    g_thread_heaps = NULL;
+    pthread_mutex_unlock(&g_depot_mutex);
+    while (heap) {
+        AromaSlabThreadHeap* next = heap->next;
+        __slab_heap_pools_destroy(&heap->node_pool, heap->widget_pools);
+        if (heap->orphaned) free(heap);
+        heap = next;
+    }
+    atomic_store_explicit(&g_remote_pending, false, memory_order_relaxed);
+
+    __slab_heap_pools_destroy(&global_memory_system.node_pool, global_memory_system.widget_pools);
+    while (global_memory_system.large_objects) {
+        AromaSlabAllocatorPage* next = global_memory_system.large_objects->next_page;
+        __slab_page_release(global_memory_system.large_objects);
+        global_memory_system.large_objects = next;
+    }
     memset(&global_memory_system, 0, sizeof(AromaMemorySystem));
-    __slab_pool_init(&global_memory_system.node_pool, sizeof(AromaNode));
+}
+
+AromaSlabPoolStats aroma_slab_pool_get_stats(const AromaSlabAllocator* pool) {
+    AromaSlabPoolStats stats = {0};
+    if (!pool) return stats;
+    stats.object_size = pool->object_size;
+    stats.page_size = pool->page_size;
+    stats.in_use = pool->in_use;
+    stats.peak_in_use = pool->peak_in_use;
+    stats.available = pool->total_pages * pool->page_capacity - pool->in_use;
+    stats.pages = pool->total_pages;
+    stats.peak_pages = pool->peak_pages;
+    stats.empty_pages = pool->empty_pages;
+    stats.requested_bytes = pool->requested_bytes;
+    stats.fragmentation_bytes = pool->in_use * pool->object_size - pool->requested_bytes;
+    stats.overhead_bytes = pool->total_pages * (pool->page_size - (size_t)pool->page_capacity * pool->object_size);
+    stats.malloc_fallbacks = pool->malloc_fallbacks;
+    stats.total_allocated = pool->total_allocated;
+    stats.total_freed = pool->total_freed;
+    return stats;
+}
+
+static void __slab_pool_stats_add(AromaSlabPoolStats* into, const AromaSlabPoolStats* from) {
+    into->in_use += from->in_use;
+    into->peak_in_use += from->peak_in_use;
+    into->available += from->available;
+    into->pages += from->pages;
+    into->peak_pages += from->peak_pages;
+    into->empty_pages += from->empty_pages;
+    into->requested_bytes += from->requested_bytes;
+    into->fragmentation_bytes += from->fragmentation_bytes;
+    into->overhead_bytes += from->overhead_bytes;
+    into->malloc_fallbacks += from->malloc_fallbacks;
+    into->total_allocated += from->total_allocated;
+    into->total_freed += from->total_freed;
+}
+
+AromaMemoryStats aroma_memory_system_get_stats(void) {
+    AromaMemoryStats stats = {0};
+    stats.node_pool = aroma_slab_pool_get_stats(&global_memory_system.node_pool);
     for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
-        __slab_pool_init(&global_memory_system.widget_pools[i], WIDGET_BUCKET_SIZES[i] + 1);
+        stats.widget_pools[i] = aroma_slab_pool_get_stats(&global_memory_system.widget_pools[i]);
     }
-}
 
-void aroma_memory_system_destroy(void) {
+    /* Live workers' counters are never read here, only what they last
+       published (on a new page, a trim or a flush); exited workers' heaps
+       are no longer written, so they are read directly. Peaks are summed. */
+    pthread_mutex_lock(&g_depot_mutex);
+    for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+        stats.remote_frees_pending +=
+            __slab_heap_pool(&global_memory_system.node_pool, global_memory_system.widget_pools, c)->remote_count;
+    }
+    for (AromaSlabThreadHeap* heap = g_thread_heaps; heap; heap = heap->next) {
+        stats.thread_heaps++;
+        for (int c = 0; c < AROMA_SLAB_CLASS_COUNT; c++) {
+            AromaSlabAllocator* pool = __slab_heap_pool(&heap->node_pool, heap->widget_pools, c);
+            AromaSlabPoolStats pool_stats = heap->orphaned ? aroma_slab_pool_get_stats(pool) : heap->published[c];
+            __slab_pool_stats_add(c == 0 ? &stats.node_pool : &stats.widget_pools[c - 1], &pool_stats);
+            stats.remote_frees_pending += pool->remote_count;
+        }
+    }
+    stats.large_objects = global_memory_system.large_object_count;
+    stats.large_object_bytes = global_memory_system.large_object_bytes;
+    stats.peak_large_object_bytes = global_memory_system.peak_large_object_bytes;
+    pthread_mutex_unlock(&g_depot_mutex);
+
     for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
-        __slab_pool_destroy(&global_memory_system.widget_pools[i]);
+        stats.widgets_in_use += stats.widget_pools[i].in_use;
+        stats.widget_requested_bytes += stats.widget_pools[i].requested_bytes;
+        stats.fragmentation_bytes += stats.widget_pools[i].fragmentation_bytes;
+        stats.malloc_fallbacks += stats.widget_pools[i].malloc_fallbacks;
     }
-    __slab_pool_destroy(&global_memory_system.node_pool);
-    memset(&global_memory_system, 0, sizeof(AromaMemorySystem));
+    stats.fragmentation_bytes += stats.node_pool.fragmentation_bytes;
+    stats.malloc_fallbacks += stats.node_pool.malloc_fallbacks;
+    pthread_mutex_lock(&g_page_mutex);
+    for (int w = 0; w < AROMA_PAGE_BITMAP_WORDS; w++) {
+        for (uint32_t bits = global_memory_system.page_used_bitmap[w]; bits; bits &= bits - 1) {
+            stats.preallocated_pages_used++;
+        }
+    }
+    pthread_mutex_unlock(&g_page_mutex);
+    stats.scene_arena_chunks = atomic_load_explicit(&g_scene_arena_chunks, memory_order_relaxed);
+    stats.scene_arena_bytes = stats.scene_arena_chunks * AROMA_SCENE_ARENA_CHUNK_SIZE;
+    return stats;
+}
+
+static void __log_pool_stats(const char* indent, const AromaSlabPoolStats* stats) {
+    LOG_INFO("%sIn Use: %zu (peak %zu), Available: %zu", indent, stats->in_use, stats->peak_in_use, stats->available);
+    LOG_INFO("%sPages: %zu (peak %zu, empty %zu, malloc %zu)", indent, stats->pages, stats->peak_pages,
+             stats->empty_pages, stats->malloc_fallbacks);
+    LOG_INFO("%sFragmentation: %zu bytes, Page Overhead: %zu bytes", indent, stats->fragmentation_bytes,
+             stats->overhead_bytes);
+    LOG_INFO("%sTotal Allocated: %zu, Total Freed: %zu", indent, stats->total_allocated, stats->total_freed);
 }
 
 void aroma_memory_system_stats(void) {
+    AromaMemoryStats stats = aroma_memory_system_get_stats();
     LOG_INFO("=== Memory System Statistics ===");
-    AromaSlabAllocator* node_pool = &global_memory_system.node_pool;
-    LOG_INFO("Node Pool:");
-    LOG_INFO("  Object Size: %zu bytes", node_pool->object_size);
-    LOG_INFO("  Total Pages: %zu", node_pool->total_pages);
-    LOG_INFO("  Total Allocated: %zu", node_pool->total_allocated);
-    LOG_INFO("  Total Freed: %zu", node_pool->total_freed);
-    size_t available_nodes = 0;
-    AromaFreeSlot* slot = node_pool->free_list;
-    while (slot) {
-        available_nodes++;
-        slot = slot->next;
-    }
-    LOG_INFO("  Available Nodes: %zu", available_nodes);
+    LOG_INFO("Node Pool (%zu-byte objects):", stats.node_pool.object_size);
+    __log_pool_stats("  ", &stats.node_pool);
     LOG_INFO("Widget Pools:");
     for (int i = 0; i < AROMA_WIDGET_BUCKET_COUNT; i++) {
-        AromaSlabAllocator* pool = &global_memory_system.widget_pools[i];
-        LOG_INFO("  Bucket %d (%zu bytes):", i, WIDGET_BUCKET_SIZES[i]);
-        LOG_INFO("    Total Pages: %zu", pool->total_pages);
-        LOG_INFO("    Total Allocated: %zu", pool->total_allocated);
-        LOG_INFO("    Total Freed: %zu", pool->total_freed);
-        size_t available_widgets = 0;
-        slot = pool->free_list;
-        while (slot) {
-            available_widgets++;
-            slot = slot->next;
-        }
-        LOG_INFO("    Available Widgets: %zu", available_widgets);
+        LOG_INFO("  Bucket %d (%zu bytes, %zu-byte pages):", i, WIDGET_BUCKET_SIZES[i], stats.widget_pools[i].page_size);
+        __log_pool_stats("    ", &stats.widget_pools[i]);
     }
+    LOG_INFO("Large Objects:");
+    LOG_INFO("  Live Objects: %zu", stats.large_objects);
+    LOG_INFO("  Live Bytes: %zu (peak %zu)", stats.large_object_bytes, stats.peak_large_object_bytes);
+    LOG_INFO("Preallocated Pages Used: %zu/%d", stats.preallocated_pages_used, AROMA_MAX_PAGES);
+    LOG_INFO("Thread Heaps: %zu, Remote Frees Pending: %zu", stats.thread_heaps, stats.remote_frees_pending);
+    LOG_INFO("Scene Arena Chunks: %zu (%zu bytes)", stats.scene_arena_chunks, stats.scene_arena_bytes);
     LOG_INFO("=== End Statistics ===");
 }
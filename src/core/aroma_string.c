@@ -0,0 +1,184 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_string.h"
+#include "core/aroma_memory.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct AromaStrEntry {
+    AromaStrEntry* next;
+    uint32_t hash;
+    uint32_t length;
+    atomic_uint refcount;
+    char text[];
+};
+
+/*
+ * Entries are immutable once published, so reading a handle needs no lock.
+ * The mutex guards the table. Holders of a reference copy it with a plain
+ * atomic increment. A release drops its reference without the lock and only
+ * takes it to unlink the entry once the count hits zero, which leaves a
+ * window where a dying entry is still in its bucket: lookups therefore only
+ * revive entries through __string_ref_if_live, never with a plain increment.
+ */
+static pthread_mutex_t g_string_mutex = PTHREAD_MUTEX_INITIALIZER;
+static AromaStrEntry* g_string_buckets[AROMA_STRING_POOL_BUCKETS];
+static AromaStringPoolStats g_string_stats = {0};
+
+static inline AromaStrEntry* __string_entry(const AromaStr* str) {
+    return (AromaStrEntry*)(str->data.ref.text - offsetof(AromaStrEntry, text));
+}
+
+static uint32_t __string_hash(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)text[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Takes a reference unless the last one is already gone. Zero is final:
+   whoever dropped the count there unlinks and frees the entry. */
+static bool __string_ref_if_live(AromaStrEntry* entry) {
+    unsigned count = atomic_load_explicit(&entry->refcount, memory_order_relaxed);
+    while (count > 0) {
+        if (atomic_compare_exchange_weak_explicit(&entry->refcount, &count, count + 1,
+                                                  memory_order_relaxed, memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+static AromaStrEntry* __string_intern(const char* text, size_t length) {
+    uint32_t hash = __string_hash(text, length);
+    AromaStrEntry** bucket = &g_string_buckets[hash & (AROMA_STRING_POOL_BUCKETS - 1)];
+
+    pthread_mutex_lock(&g_string_mutex);
+    g_string_stats.lookups++;
+    for (AromaStrEntry* entry = *bucket; entry; entry = entry->next) {
+        if (entry->hash == hash && entry->length == length && memcmp(entry->text, text, length) == 0 &&
+            __string_ref_if_live(entry)) {
+            g_string_stats.hits++;
+            pthread_mutex_unlock(&g_string_mutex);
+            return entry;
+        }
+    }
+
+    AromaStrEntry* entry = malloc(sizeof(AromaStrEntry) + length + 1);
+    if (entry) {
+        memcpy(entry->text, text, length);
+        entry->text[length] = '\0';
+        entry->hash = hash;
+        entry->length = (uint32_t)length;
+        atomic_init(&entry->refcount, 1);
+        entry->next = *bucket;
+        *bucket = entry;
+        g_string_stats.entries++;
+        g_string_stats.bytes += sizeof(AromaStrEntry) + length + 1;
+    }
+    pthread_mutex_unlock(&g_string_mutex);
+    if (entry) aroma_memory_track(AROMA_MEMORY_STRINGS, (ptrdiff_t)(sizeof(AromaStrEntry) + length + 1), 0);
+    return entry;
+}
+
+static void __string_unref(AromaStrEntry* entry) {
+    if (atomic_fetch_sub_explicit(&entry->refcount, 1, memory_order_acq_rel) != 1) return;
+
+    pthread_mutex_lock(&g_string_mutex);
+    AromaStrEntry** link = &g_string_buckets[entry->hash & (AROMA_STRING_POOL_BUCKETS - 1)];
+    while (*link && *link != entry) link = &(*link)->next;
+    if (*link) *link = entry->next;
+    g_string_stats.entries--;
+    g_string_stats.bytes -= sizeof(AromaStrEntry) + entry->length + 1;
+    pthread_mutex_unlock(&g_string_mutex);
+    aroma_memory_track(AROMA_MEMORY_STRINGS, -(ptrdiff_t)(sizeof(AromaStrEntry) + entry->length + 1), 0);
+    free(entry);
+}
+
+void aroma_str_set_n(AromaStr* str, const char* text, size_t length) {
+    if (!str) return;
+    if (!text) length = 0;
+    /* Build the new value first: `text` may point into the old one. */
+    AromaStr next;
+    memset(&next, 0, sizeof(next));
+    if (length <= AROMA_STR_INLINE_CAPACITY) {
+        if (length) memcpy(next.data.inline_text, text, length);
+    } else {
+        AromaStrEntry* entry = __string_intern(text, length);
+        if (entry) {
+            next.data.ref.text = entry->text;
+            next.data.ref.is_interned = 1;
+        }
+    }
+    aroma_str_release(str);
+    *str = next;
+}
+
+void aroma_str_set(AromaStr* str, const char* text) {
+    aroma_str_set_n(str, text, text ? strlen(text) : 0);
+}
+
+void aroma_str_copy(AromaStr* dst, const AromaStr* src) {
+    if (!dst || !src || dst == src) return;
+    if (aroma_str_is_interned(src)) {
+        atomic_fetch_add_explicit(&__string_entry(src)->refcount, 1, memory_order_relaxed);
+    }
+    AromaStr copy = *src;
+    aroma_str_release(dst);
+    *dst = copy;
+}
+
+void aroma_str_release(AromaStr* str) {
+    if (!str) return;
+    if (aroma_str_is_interned(str)) __string_unref(__string_entry(str));
+    memset(str, 0, sizeof(*str));
+}
+
+size_t aroma_str_length(const AromaStr* str) {
+    if (!str) return 0;
+    if (aroma_str_is_interned(str)) return __string_entry(str)->length;
+    return strlen(str->data.inline_text);
+}
+
+bool aroma_str_equals(const AromaStr* str, const char* text) {
+    if (!str || !text) return false;
+    return strcmp(aroma_str_get(str), text) == 0;
+}
+
+AromaStringPoolStats aroma_string_pool_get_stats(void) {
+    pthread_mutex_lock(&g_string_mutex);
+    AromaStringPoolStats stats = g_string_stats;
+    stats.references = 0;
+    stats.shared_bytes_saved = 0;
+    for (size_t i = 0; i < AROMA_STRING_POOL_BUCKETS; i++) {
+        for (AromaStrEntry* entry = g_string_buckets[i]; entry; entry = entry->next) {
+            uint32_t refs = atomic_load_explicit(&entry->refcount, memory_order_relaxed);
+            stats.references += refs;
+            if (refs > 1) stats.shared_bytes_saved += (size_t)(refs - 1) * (entry->length + 1);
+        }
+    }
+    pthread_mutex_unlock(&g_string_mutex);
+    return stats;
+}
@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_STRING_H
+#define AROMA_CORE_STRING_H
+
+#include <aroma_string.h>
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "core/aroma_task.h"
+#include "core/aroma_logger.h"
+#include <string.h>
+
+static AromaTask g_tasks[AROMA_MAX_TASKS];
+static uint64_t g_task_now = 0;
+static uint32_t g_task_frame = 0;
+
+static void __task_on_event(const AromaEvent* event) {
+    for (int i = 0; i < AROMA_MAX_TASKS; i++) {
+        AromaTask* task = &g_tasks[i];
+        if (!task->active || task->wait != AROMA_TASK_WAIT_EVENT) continue;
+        if (task->wait_event_type != event->event_type) continue;
+        if (task->wait_node_id != 0 && task->wait_node_id != event->target_node_id) continue;
+
+        task->event = *event;
+        task->wait = AROMA_TASK_WAIT_NONE;
+    }
+}
+
+void aroma_task_init(void) {
+    memset(g_tasks, 0, sizeof(g_tasks));
+    g_task_now = 0;
+    g_task_frame = 0;
+    __event_set_task_hook(__task_on_event);
+}
+
+void aroma_task_shutdown(void) {
+    __event_set_task_hook(NULL);
+    memset(g_tasks, 0, sizeof(g_tasks));
+}
+
+AromaTask* aroma_task_spawn(AromaTaskFn fn, void* ctx) {
+    if (!fn) return NULL;
+    for (int i = 0; i < AROMA_MAX_TASKS; i++) {
+        AromaTask* task = &g_tasks[i];
+        if (task->active) continue;
+
+        memset(task, 0, sizeof(*task));
+        task->fn = fn;
+        task->ctx = ctx;
+        task->active = true;
+        /* Parked on the current frame so it first runs on the next tick,
+           even when spawned from inside another task. */
+        aroma_task_wait_frame(task);
+        return task;
+    }
+    LOG_ERROR("No free task slots (max %d)", AROMA_MAX_TASKS);
+    return NULL;
+}
+
+void aroma_task_set_on_done(AromaTask* task, AromaTaskDoneCallback cb) {
+    if (task) task->on_done = cb;
+}
+
+void aroma_task_cancel(AromaTask* task) {
+    if (task) task->active = false;
+}
+
+bool aroma_task_is_active(const AromaTask* task) {
+    return task && task->active;
+}
+
+uint32_t aroma_task_active_count(void) {
+    uint32_t count = 0;
+    for (int i = 0; i < AROMA_MAX_TASKS; i++) {
+        if (g_tasks[i].active) count++;
+    }
+    return count;
+}
+
+void aroma_task_wait_sleep(AromaTask* task, uint32_t ms) {
+    task->wait = AROMA_TASK_WAIT_SLEEP;
+    task->wake_ms = g_task_now + ms;
+}
+
+void aroma_task_wait_frame(AromaTask* task) {
+    task->wait = AROMA_TASK_WAIT_FRAME;
+    task->wake_frame = g_task_frame;
+}
+
+void aroma_task_wait_event(AromaTask* task, uint64_t node_id, AromaEventType event_type) {
+    task->wait = AROMA_TASK_WAIT_EVENT;
+    task->wait_node_id = node_id;
+    task->wait_event_type = event_type;
+}
+
+void aroma_task_wait_asset(AromaTask* task, const AromaAsset* asset) {
+    task->wait = AROMA_TASK_WAIT_ASSET;
+    task->wait_asset = asset;
+}
+
+static bool __task_ready(const AromaTask* task) {
+    switch (task->wait) {
+        case AROMA_TASK_WAIT_NONE:  return true;
+        case AROMA_TASK_WAIT_SLEEP: return g_task_now >= task->wake_ms;
+        case AROMA_TASK_WAIT_FRAME: return g_task_frame != task->wake_frame;
+        case AROMA_TASK_WAIT_EVENT: return false;
+        case AROMA_TASK_WAIT_ASSET: return !aroma_asset_is_pending(task->wait_asset);
+    }
+    return false;
+}
+
+void aroma_task_tick(uint64_t now_ms) {
+    g_task_now = now_ms;
+    g_task_frame++;
+
+    for (int i = 0; i < AROMA_MAX_TASKS; i++) {
+        AromaTask* task = &g_tasks[i];
+        if (!task->active || !__task_ready(task)) continue;
+
+        task->wait = AROMA_TASK_WAIT_NONE;
+        if (task->fn(task, task->ctx) != AROMA_TASK_DONE) continue;
+
+        /* The body may have cancelled itself; don't report completion then. */
+        if (!task->active) continue;
+        task->active = false;
+        if (task->on_done) task->on_done(task, task->ctx);
+    }
+}
+
+bool aroma_task_next_deadline(uint64_t* out_ms) {
+    bool found = false;
+    uint64_t earliest = 0;
+    for (int i = 0; i < AROMA_MAX_TASKS; i++) {
+        const AromaTask* task = &g_tasks[i];
+        if (!task->active || task->wait != AROMA_TASK_WAIT_SLEEP) continue;
+        if (!found || task->wake_ms < earliest) {
+            earliest = task->wake_ms;
+            found = true;
+        }
+    }
+    if (found && out_ms) *out_ms = earliest;
+    return found;
+}
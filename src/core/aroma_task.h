@@ -0,0 +1,6 @@
+#ifndef AROMA_CORE_TASK_H
+#define AROMA_CORE_TASK_H
+
+#include <aroma_task.h>
+
+#endif
@@ -29,6 +29,7 @@ struct AromaTimer {
     uint64_t next_fire;
     bool repeat;
     bool active;
+    bool paused;
     AromaTimerCallback cb;
     void* user_data;
 };
@@ -51,6 +52,7 @@ AromaTimer* aroma_timer_create(uint32_t period_ms, bool repeat, AromaTimerCallba
             g_timers[i].next_fire = 0;
             g_timers[i].repeat = repeat;
             g_timers[i].active = true;
+            g_timers[i].paused = false;
             g_timers[i].cb = cb;
             g_timers[i].user_data = user_data;
             return &g_timers[i];
@@ -64,9 +66,20 @@ void aroma_timer_cancel(AromaTimer* timer) {
     timer->active = false;
 }
 
+void aroma_timer_reset(AromaTimer* timer) {
+    if (!timer) return;
+    timer->next_fire = 0;
+}
+
+void aroma_timer_set_paused(AromaTimer* timer, bool paused) {
+    if (!timer || timer->paused == paused) return;
+    timer->paused = paused;
+    if (!paused) timer->next_fire = 0;
+}
+
 void aroma_timer_tick(uint64_t now_ms) {
     for (size_t i = 0; i < AROMA_MAX_TIMERS; i++) {
-        if (!g_timers[i].active) continue;
+        if (!g_timers[i].active || g_timers[i].paused) continue;
         if (g_timers[i].next_fire == 0) {
             g_timers[i].next_fire = now_ms + g_timers[i].period_ms;
         }
@@ -80,3 +93,15 @@ void aroma_timer_tick(uint64_t now_ms) {
         }
     }
 }
+
+bool aroma_timer_next_deadline(uint64_t* out_ms) {
+    bool found = false;
+    uint64_t earliest = UINT64_MAX;
+    for (size_t i = 0; i < AROMA_MAX_TIMERS; i++) {
+        if (!g_timers[i].active || g_timers[i].paused || g_timers[i].next_fire == 0) continue;
+        if (g_timers[i].next_fire < earliest) earliest = g_timers[i].next_fire;
+        found = true;
+    }
+    if (found && out_ms) *out_ms = earliest;
+    return found;
+}
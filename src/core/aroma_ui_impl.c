@@ -27,12 +27,22 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_drawlist.h"
+#include "core/aroma_frame_arena.h"
+#include "core/aroma_timer.h"
+#include "core/aroma_animation.h"
+#include "core/aroma_idle.h"
+#include "core/aroma_asset.h"
+#include "core/aroma_task.h"
+#include "core/aroma_post.h"
+#include "core/aroma_memory.h"
 #include "widgets/aroma_window.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include "backends/platforms/aroma_platform_interface.h"
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
 
 #ifdef ESP32
 #include <Arduino.h>
@@ -45,7 +55,44 @@ int g_window_count = 0;
 AromaNode* g_focused_node = NULL;
 static bool g_immediate_mode = false;
 static AromaDrawList* g_window_drawlists[AROMA_MAX_WINDOWS] = {0};
+static AromaFrameArena* g_window_arenas[AROMA_MAX_WINDOWS] = {0};
+
+/* What each window last put on screen, so an identical frame can be dropped. */
+typedef struct AromaWindowPresent {
+    uint64_t hash;
+    bool valid;
+    bool skipped;   /* the current frame matched and was neither flushed nor swapped */
+    bool open;      /* between begin_frame and the end_frame that owns it */
+} AromaWindowPresent;
+
+static AromaWindowPresent g_window_presents[AROMA_MAX_WINDOWS] = {0};
+static AromaFrameStats g_frame_stats = {0};
+static char g_capture_path[256] = {0};
+static uint32_t g_capture_remaining = 0;
+static uint32_t g_capture_index = 0;
+static uint64_t g_frame_clock_ms = 0;
+static AromaRect g_frame_damage = {0};
+static bool g_frame_damage_partial = false;
+static bool g_idle_throttled = false;
+
+static void __window_render_state_create(int idx) {
+    if (!g_window_drawlists[idx]) g_window_drawlists[idx] = aroma_drawlist_create();
+    if (!g_window_arenas[idx]) g_window_arenas[idx] = aroma_frame_arena_create();
+    aroma_drawlist_set_arena(g_window_drawlists[idx], g_window_arenas[idx]);
+    aroma_drawlist_set_text_measure(g_window_drawlists[idx], NULL, g_windows[idx].window_id);
+    g_window_presents[idx] = (AromaWindowPresent){0};
+}
 
+static void __window_render_state_destroy(int idx) {
+    if (g_window_drawlists[idx]) {
+        aroma_drawlist_destroy(g_window_drawlists[idx]);
+        g_window_drawlists[idx] = NULL;
+    }
+    if (g_window_arenas[idx]) {
+        aroma_frame_arena_destroy(g_window_arenas[idx]);
+        g_window_arenas[idx] = NULL;
+    }
+}
 
 static inline int __draw_task_compare(const void* a, const void* b) {
     const AromaDrawTask* ta = (const AromaDrawTask*)a;
@@ -95,9 +142,21 @@ bool aroma_ui_init_impl(void) {
     AromaTheme default_theme = aroma_theme_create_default();
     aroma_theme_set_global(&default_theme);
     aroma_dirty_list_clear();
+    aroma_timer_init();
+    aroma_animation_init();
+    aroma_idle_init();
+    aroma_asset_init();
+    aroma_task_init();
+    aroma_post_init();
 
     if (getenv("AROMA_UI_IMMEDIATE") && getenv("AROMA_UI_IMMEDIATE")[0] == '1')
         aroma_ui_set_immediate_mode(true);
+    if (getenv("AROMA_UI_RECORD_THREADS"))
+        aroma_drawlist_set_record_threads((uint32_t)strtoul(getenv("AROMA_UI_RECORD_THREADS"), NULL, 10));
+    if (getenv("AROMA_UI_CAPTURE") && getenv("AROMA_UI_CAPTURE")[0] != '\0') {
+        const char* frames = getenv("AROMA_UI_CAPTURE_FRAMES");
+        aroma_ui_capture_frames(getenv("AROMA_UI_CAPTURE"), frames ? (uint32_t)strtoul(frames, NULL, 10) : 1);
+    }
 
     g_ui_initialized = true;
     LOG_INFO("Aroma UI initialized successfully");
@@ -112,6 +171,34 @@ void aroma_ui_request_redraw(void* user_data) {
     if (g_main_window) aroma_node_invalidate(g_main_window);
 }
 
+static void __update_caret_blink(const AromaWindowHandle* handle) {
+    aroma_textbox_set_caret_blink_paused(handle->window_id, !handle->has_focus || g_idle_throttled);
+}
+
+void aroma_ui_set_window_focused(size_t window_id, bool focused) {
+    int idx = __find_window_index_by_id(window_id);
+    if (idx < 0 || g_windows[idx].has_focus == focused) return;
+    g_windows[idx].has_focus = focused;
+    __update_caret_blink(&g_windows[idx]);
+}
+
+bool aroma_ui_is_node_window_focused(const AromaNode* node) {
+    if (!node) return true;
+    while (node->parent_node) node = node->parent_node;
+    for (int i = 0; i < g_window_count; ++i)
+        if (g_windows[i].root_node == node) return g_windows[i].has_focus;
+    return true;
+}
+
+void aroma_ui_set_idle_throttled(bool throttled) {
+    if (g_idle_throttled == throttled) return;
+    g_idle_throttled = throttled;
+    for (int i = 0; i < g_window_count; ++i)
+        __update_caret_blink(&g_windows[i]);
+}
+
+bool aroma_ui_is_idle_throttled(void) { return g_idle_throttled; }
+
 bool aroma_ui_consume_redraw(void) {
     if (aroma_ui_is_immediate_mode()) return true;
     size_t dirty_count = 0;
@@ -125,21 +212,65 @@ void aroma_ui_shutdown_impl(void) {
         platform->shutdown();
         LOG_INFO("Platform backend shutdown");
     }
+    aroma_post_shutdown();
+    aroma_task_shutdown();
+    aroma_asset_shutdown();
+    aroma_idle_shutdown();
+    aroma_animation_shutdown();
+    aroma_timer_shutdown();
     aroma_event_system_shutdown();
     __node_system_destroy();
 
-    for (int i = 0; i < g_window_count; ++i) {
-        if (g_window_drawlists[i]) {
-            aroma_drawlist_destroy(g_window_drawlists[i]);
-            g_window_drawlists[i] = NULL;
-        }
-    }
+    aroma_drawlist_set_record_threads(1);
+    for (int i = 0; i < g_window_count; ++i)
+        __window_render_state_destroy(i);
     g_focused_node = NULL;
     g_ui_initialized = false;
     g_main_window = NULL;
     LOG_INFO("Aroma UI shutdown complete");
 }
 
+static AromaNode* __resolve_posted_node(uint64_t node_id) {
+    for (int i = 0; i < g_window_count; ++i) {
+        AromaNode* node = __find_node_by_id(g_windows[i].root_node, node_id);
+        if (node) return node;
+    }
+    return NULL;
+}
+
+void aroma_ui_tick_impl(uint64_t now_ms) {
+    /* Cross-thread mutations land first so this frame reflects the latest
+       posted values, however many arrived since the last one. */
+    aroma_post_flush(__resolve_posted_node);
+
+    /* One clock sample per loop iteration drives timers and animations alike,
+       so everything that lands in the next frame agrees on its timestamp. */
+    g_frame_clock_ms = now_ms;
+    aroma_timer_tick(g_frame_clock_ms);
+    aroma_animation_tick(g_frame_clock_ms);
+    aroma_task_tick(g_frame_clock_ms);
+}
+
+void aroma_ui_run_idle_impl(void) {
+    /* Pages emptied during this frame survive it, so a screen torn down and
+       rebuilt in one frame reuses them instead of bouncing off malloc. */
+    if (aroma_memory_system_trim_pending()) aroma_memory_system_trim();
+    aroma_memory_check_budgets();
+
+    if (aroma_idle_pending() == 0) return;
+
+    /* Slack ends at whichever comes first: the next vsync-paced frame or the
+       next timer that might schedule one. */
+    uint64_t frame_start = g_frame_clock_ms ? g_frame_clock_ms : aroma_time_now_ms();
+    uint64_t deadline = frame_start + AROMA_IDLE_FRAME_INTERVAL_MS;
+    uint64_t timer_deadline = 0;
+    if (aroma_timer_next_deadline(&timer_deadline) && timer_deadline < deadline)
+        deadline = timer_deadline;
+    if (aroma_task_next_deadline(&timer_deadline) && timer_deadline < deadline)
+        deadline = timer_deadline;
+    aroma_idle_run(deadline);
+}
+
 bool aroma_ui_is_running_impl(void) {
     AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
     return (platform && platform->run_event_loop) ? platform->run_event_loop() : false;
@@ -172,7 +303,7 @@ void aroma_ui_render_all_windows_impl(void) {
 static void __window_update_callback(size_t window_id, void* data) {
     (void)data;
     if (!aroma_ui_consume_redraw()) {
-      
+        aroma_ui_run_idle_impl();
         return;
     }
 
@@ -185,7 +316,7 @@ static void __window_update_callback(size_t window_id, void* data) {
     #ifndef ESP32
     aroma_graphics_swap_buffers(window_id);
     #endif
-   
+    aroma_ui_run_idle_impl();
 }
 
 AromaWindow* aroma_ui_create_window_impl(const char* title, int width, int height) {
@@ -204,8 +335,9 @@ AromaWindow* aroma_ui_create_window_impl(const char* title, int width, int heigh
     struct AromaWindow* window_data = (struct AromaWindow*)window->node_widget_ptr;
     if (window_data) g_windows[idx].window_id = window_data->window_id;
     g_windows[idx].is_active = true;
+    g_windows[idx].has_focus = true;
     g_window_count++;
-    g_window_drawlists[idx] = aroma_drawlist_create();
+    __window_render_state_create(idx);
     aroma_event_set_root(window);
     if (!g_main_window) g_main_window = window;
     LOG_INFO("Window %d created: title='%s', size=%dx%d", idx, title, width, height);
@@ -225,15 +357,17 @@ void aroma_ui_destroy_window_impl(AromaWindow* window) {
     for (int i = 0; i < g_window_count; ++i) {
         if (g_windows[i].window == window) {
             __destroy_node(g_windows[i].root_node);
-            if (g_window_drawlists[i]) {
-                aroma_drawlist_destroy(g_window_drawlists[i]);
-                g_window_drawlists[i] = NULL;
-            }
+            __window_render_state_destroy(i);
             g_focused_node = NULL;
             for (int j = i; j < g_window_count - 1; ++j) {
                 g_windows[j] = g_windows[j + 1];
                 g_window_drawlists[j] = g_window_drawlists[j + 1];
+                g_window_arenas[j] = g_window_arenas[j + 1];
+                g_window_presents[j] = g_window_presents[j + 1];
             }
+            g_window_drawlists[g_window_count - 1] = NULL;
+            g_window_arenas[g_window_count - 1] = NULL;
+            g_window_presents[g_window_count - 1] = (AromaWindowPresent){0};
             --g_window_count;
             if ((AromaNode*)window == g_main_window)
                 g_main_window = (g_window_count > 0) ? g_windows[0].root_node : NULL;
@@ -247,46 +381,170 @@ AromaDrawList* aroma_ui_begin_frame(size_t window_id) {
        g_frame_cleared = false;
     int idx = __find_window_index_by_id(window_id);
     if (idx < 0) return NULL;
+    if (!g_window_drawlists[idx] || !g_window_arenas[idx]) __window_render_state_create(idx);
     AromaDrawList* list = g_window_drawlists[idx];
-    if (!list) g_window_drawlists[idx] = list = aroma_drawlist_create();
+    if (!list) return NULL;
+    /* The list drops its pointers into the arena before the arena rewinds. */
     aroma_drawlist_reset(list);
+    aroma_frame_arena_reset(g_window_arenas[idx]);
+    g_window_presents[idx].skipped = false;
+    g_window_presents[idx].open = true;
     aroma_drawlist_begin(list);
     return list;
 }
 
-void aroma_ui_end_frame(size_t window_id) {
+AromaFrameArena* aroma_ui_get_frame_arena(size_t window_id) {
     int idx = __find_window_index_by_id(window_id);
-    if (idx < 0) return;
+    if (idx < 0) return NULL;
+    return g_window_arenas[idx];
+}
+
+/* The command hash plus whatever else decides the pixels of the frame. */
+static uint64_t __frame_present_hash(AromaDrawList* list, size_t window_id) {
+    uint64_t hash = aroma_drawlist_get_hash(list);
+    int width = 0, height = 0;
+    AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
+    if (platform && platform->get_window_size) platform->get_window_size(window_id, &width, &height);
+    int extra[6] = { width, height, 0, 0, 0, 0 };
+#ifdef ESP32
+    if (g_frame_damage_partial) {
+        extra[2] = g_frame_damage.x;
+        extra[3] = g_frame_damage.y;
+        extra[4] = g_frame_damage.width;
+        extra[5] = g_frame_damage.height;
+    }
+#endif
+    for (size_t i = 0; i < sizeof(extra) / sizeof(extra[0]); ++i)
+        hash = (hash ^ (uint32_t)extra[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+bool aroma_ui_capture_frames(const char* path, uint32_t frames) {
+    if (!path || strlen(path) >= sizeof(g_capture_path)) return false;
+    snprintf(g_capture_path, sizeof(g_capture_path), "%s", path);
+    g_capture_remaining = frames;
+    g_capture_index = 0;
+    return true;
+}
+
+static void __capture_frame(AromaDrawList* list, size_t window_id) {
+    char path[sizeof(g_capture_path) + 16];
+    const char* slot = strstr(g_capture_path, "%u");
+    if (slot) {
+        snprintf(path, sizeof(path), "%.*s%u%s", (int)(slot - g_capture_path), g_capture_path,
+                 (unsigned)g_capture_index, slot + 2);
+    } else {
+        snprintf(path, sizeof(path), "%s", g_capture_path);
+    }
+
+    int width = 0, height = 0;
+    AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
+    if (platform && platform->get_window_size) platform->get_window_size(window_id, &width, &height);
+    if (aroma_drawlist_save(list, width, height, path)) {
+        LOG_INFO("Captured frame %u of window %zu to %s", (unsigned)g_capture_index, window_id, path);
+    }
+    g_capture_index++;
+    g_capture_remaining--;
+}
+
+bool aroma_ui_end_frame(size_t window_id) {
+    int idx = __find_window_index_by_id(window_id);
+    if (idx < 0) return false;
 
     AromaDrawList* list = g_window_drawlists[idx];
-    if (!list) return;
+    AromaWindowPresent* present = &g_window_presents[idx];
+    /* A second end_frame would hash and present the list the first one reset. */
+    if (!list || !present->open) return false;
+    present->open = false;
 
     aroma_drawlist_end();
 
+    uint64_t hash = __frame_present_hash(list, window_id);
+    if (present->valid && present->hash == hash) {
+        aroma_drawlist_reset(list);
+        present->skipped = true;
+        g_frame_stats.frames_skipped++;
+        return false;
+    }
+    present->hash = hash;
+    present->valid = true;
+    present->skipped = false;
+    g_frame_stats.frames_presented++;
+    if (g_capture_remaining) __capture_frame(list, window_id);
+
+    int surface_width = 0, surface_height = 0;
+    AromaPlatformInterface* surface = aroma_backend_abi.get_platform_interface();
+    if (surface && surface->get_window_size) surface->get_window_size(window_id, &surface_width, &surface_height);
+    aroma_drawlist_cull_occluded(list, surface_width, surface_height);
+    AromaDrawListStats culled = aroma_drawlist_get_stats(list);
+    g_frame_stats.commands_occluded += culled.occluded;
+    g_frame_stats.pixels_occluded += culled.occluded_pixels;
+    g_frame_stats.commands_clipped += culled.clipped;
+
 #ifndef ESP32
     aroma_drawlist_flush(list, window_id);
 #else
     AromaPlatformInterface* platform = aroma_backend_abi.get_platform_interface();
     if (platform && platform->call_flush_function_ptr) {
+        if (platform->tft_mark_tiles_dirty) {
+            if (g_frame_damage_partial) {
+                platform->tft_mark_tiles_dirty(g_frame_damage.y, g_frame_damage.height);
+            } else {
+                int width = 0, height = 0;
+                if (platform->get_window_size) platform->get_window_size(window_id, &width, &height);
+                platform->tft_mark_tiles_dirty(0, height > 0 ? height : 1);
+            }
+        }
         platform->call_flush_function_ptr(aroma_drawlist_smart_flush, list);
         aroma_drawlist_reset(list); 
     }
 #endif
+    return true;
+}
+
+bool aroma_ui_frame_was_skipped(size_t window_id) {
+    int idx = __find_window_index_by_id(window_id);
+    return idx >= 0 && g_window_presents[idx].skipped;
+}
+
+void aroma_ui_force_present(size_t window_id) {
+    int idx = __find_window_index_by_id(window_id);
+    if (idx >= 0) g_window_presents[idx].valid = false;
+}
+
+AromaFrameStats aroma_ui_get_frame_stats(void) {
+    return g_frame_stats;
+}
+
+/* Below this many tasks per chunk, waking workers costs more than it saves. */
+#define AROMA_PARALLEL_RECORD_MIN_TASKS 16
+
+typedef struct AromaRecordJob {
+    const AromaDrawTask* tasks;
+    size_t count;
+    size_t window_id;
+} AromaRecordJob;
+
+/* Chunks are contiguous runs of the z-sorted tasks. */
+static void __record_task_chunk(uint32_t chunk, uint32_t chunk_count, void* user_data) {
+    const AromaRecordJob* job = user_data;
+    size_t begin = job->count * chunk / chunk_count;
+    size_t end = job->count * (chunk + 1) / chunk_count;
+    for (size_t i = begin; i < end; ++i)
+        job->tasks[i].draw_cb(job->tasks[i].node, job->window_id);
 }
 
 void aroma_ui_render_dirty_window(size_t window_id, uint32_t clear_color) {
     size_t dirty_count = 0;
     AromaNode** dirty_nodes = aroma_dirty_list_get(&dirty_count);
+    g_frame_damage_partial = aroma_dirty_region_get(&g_frame_damage);
     #ifdef ESP32
         aroma_dirty_list_clear();
     #endif
     if (dirty_count == 0 && !aroma_ui_is_immediate_mode()) return;
 
-    #ifndef ESP32
+    /* When the caller opened the frame, its end_frame presents it. */
     bool frame_active = aroma_drawlist_is_active();
-    #else
-    bool frame_active = false;
-    #endif
     if (!frame_active) {
         AromaDrawList* list = aroma_ui_begin_frame(window_id);
         if (!list) return;
@@ -301,7 +559,9 @@ void aroma_ui_render_dirty_window(size_t window_id, uint32_t clear_color) {
     int backend_type = aroma_backend_abi.get_graphics_backend_type ?
         aroma_backend_abi.get_graphics_backend_type() : -1;
 
-    if (backend_type == GRAPHICS_BACKEND_GLES3) {
+    /* Partial damage repaints everything under the damaged area, so siblings
+       overlapping the animated node have to be recorded as well. */
+    if (backend_type == GRAPHICS_BACKEND_GLES3 || g_frame_damage_partial) {
         for (int i = 0; i < g_window_count; ++i) {
             if (g_windows[i].window_id == window_id && g_windows[i].root_node) {
                 __collect_draw_tasks(g_windows[i].root_node, tasks, &task_count, AROMA_MAX_DIRTY_NODES);
@@ -321,8 +581,15 @@ void aroma_ui_render_dirty_window(size_t window_id, uint32_t clear_color) {
     if (task_count > 1)
         qsort(tasks, task_count, sizeof(AromaDrawTask), __draw_task_compare);
 
-    for (size_t i = 0; i < task_count; ++i)
-        tasks[i].draw_cb(tasks[i].node, window_id);
+    AromaDrawList* list = aroma_drawlist_get_active();
+    if (list && task_count >= AROMA_PARALLEL_RECORD_MIN_TASKS && aroma_drawlist_get_record_threads() > 1) {
+        AromaRecordJob job = { tasks, task_count, window_id };
+        aroma_drawlist_record_parallel(list, window_id, (uint32_t)(task_count / AROMA_PARALLEL_RECORD_MIN_TASKS),
+                                       __record_task_chunk, &job);
+    } else {
+        for (size_t i = 0; i < task_count; ++i)
+            tasks[i].draw_cb(tasks[i].node, window_id);
+    }
 
     if (!frame_active)
         aroma_ui_end_frame(window_id);
@@ -78,7 +78,7 @@ AromaNode* aroma_button_create(AromaNode* parent, const char* label, int x, int
         return NULL;
     }
 
-    AromaButton* button = (AromaButton*)aroma_widget_alloc(sizeof(AromaButton));
+    AromaButton* button = (AromaButton*)aroma_widget_alloc_under(parent, sizeof(AromaButton));
     if (!button)
     {
         LOG_ERROR("Failed to allocate memory for button");
@@ -79,7 +79,7 @@ static bool __card_handle_event(AromaEvent* event, void* user_data)
 
 AromaNode* aroma_card_create(AromaNode* parent, int x, int y, int width, int height, AromaCardType type) {
     if (!parent) return NULL;
-    AromaCard* card = (AromaCard*)aroma_widget_alloc(sizeof(AromaCard));
+    AromaCard* card = (AromaCard*)aroma_widget_alloc_under(parent, sizeof(AromaCard));
     if (!card) return NULL;
 
     card->rect.x = x;
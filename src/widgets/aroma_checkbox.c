@@ -73,7 +73,7 @@ AromaNode* aroma_checkbox_create(AromaNode* parent, const char* label,
         return NULL;
     }
 
-    AromaCheckbox* data = (AromaCheckbox*)aroma_widget_alloc(sizeof(AromaCheckbox));
+    AromaCheckbox* data = (AromaCheckbox*)aroma_widget_alloc_under(parent, sizeof(AromaCheckbox));
     if (!data) {
         LOG_ERROR("Failed to allocate checkbox");
         return NULL;
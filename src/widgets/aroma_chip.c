@@ -98,7 +98,7 @@ static void __chip_update_layout(AromaChip* chip)
 
 AromaNode* aroma_chip_create(AromaNode* parent, int x, int y, const char* label, AromaChipType type) {
     if (!parent) return NULL;
-    AromaChip* chip = (AromaChip*)aroma_widget_alloc(sizeof(AromaChip));
+    AromaChip* chip = (AromaChip*)aroma_widget_alloc_under(parent, sizeof(AromaChip));
     if (!chip) return NULL;
 
     chip->rect.x = x;
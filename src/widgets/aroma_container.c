@@ -15,7 +15,7 @@ AromaNode* aroma_container_create(AromaNode* parent, int x, int y, int width, in
         return NULL;
     }
 
-    AromaContainer* container = (AromaContainer*)aroma_widget_alloc(sizeof(AromaContainer));
+    AromaContainer* container = (AromaContainer*)aroma_widget_alloc_under(parent, sizeof(AromaContainer));
     if (!container) {
         LOG_ERROR("Failed to allocate memory for container");
         return NULL;
@@ -26,6 +26,7 @@
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_style.h"
 #include "backends/aroma_abi.h"
+#include "aroma_ui.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <string.h>
 #define _POSIX_C_SOURCE 200809L
@@ -55,7 +56,7 @@ static float __time_diff_sec(struct timespec a, struct timespec b)
 AromaNode* aroma_debug_overlay_create(AromaNode* parent, int x, int y)
 {
     if (!parent) return NULL;
-    AromaDebugOverlay* overlay = (AromaDebugOverlay*)aroma_widget_alloc(sizeof(AromaDebugOverlay));
+    AromaDebugOverlay* overlay = (AromaDebugOverlay*)aroma_widget_alloc_under(parent, sizeof(AromaDebugOverlay));
     if (!overlay) return NULL;
 
     memset(overlay, 0, sizeof(AromaDebugOverlay));
@@ -167,14 +168,18 @@ void aroma_debug_overlay_draw(AromaNode* overlay_node, size_t window_id)
             }
             count_nodes(root);
         }
-        snprintf(line4, sizeof(line4), "fps: %.1f", overlay->fps);
-        snprintf(line5, sizeof(line5), "dirty: %zu", dirty_count);
+        AromaFrameStats frames = aroma_ui_get_frame_stats();
+        snprintf(line4, sizeof(line4), "fps: %.1f, skipped %llu", overlay->fps,
+                 (unsigned long long)frames.frames_skipped);
+        snprintf(line5, sizeof(line5), "dirty: %zu, occluded %llu", dirty_count,
+                 (unsigned long long)frames.commands_occluded);
         snprintf(line6, sizeof(line6), "nodes: %zu", node_count);
 
-        extern AromaMemorySystem global_memory_system;
-        size_t total_alloc = global_memory_system.widget_pools[0].total_allocated;
-        size_t total_free = global_memory_system.widget_pools[0].total_freed;
-        snprintf(line7, sizeof(line7), "mem: %zu/%zu", total_alloc, total_free);
+        AromaMemoryStats mem = aroma_memory_system_get_stats();
+        snprintf(line7, sizeof(line7), "mem: %zu w, %zuK, frag %zuK",
+                 mem.widgets_in_use + mem.large_objects,
+                 (mem.widget_requested_bytes + mem.large_object_bytes) / 1024,
+                 mem.fragmentation_bytes / 1024);
 
         extern AromaNode* g_focused_node;
         snprintf(line8, sizeof(line8), "focus: %llu", g_focused_node ? (unsigned long long)g_focused_node->node_id : 0ULL);
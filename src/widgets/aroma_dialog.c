@@ -159,7 +159,7 @@ AromaNode* aroma_dialog_create(
         return NULL;
 
     AromaDialog* dlg =
-        (AromaDialog*)aroma_widget_alloc(sizeof(AromaDialog));
+        (AromaDialog*)aroma_widget_alloc_under(parent, sizeof(AromaDialog));
 
     if (!dlg) return NULL;
     memset(dlg, 0, sizeof(AromaDialog));
@@ -44,7 +44,7 @@ AromaNode* aroma_divider_create(
 {
     if (!parent || length <= 0) return NULL;
 
-    AromaDivider* divider = aroma_widget_alloc(sizeof(AromaDivider));
+    AromaDivider* divider = aroma_widget_alloc_under(parent, sizeof(AromaDivider));
     if (!divider) return NULL;
 
     memset(divider, 0, sizeof(*divider));
@@ -73,7 +73,7 @@ AromaNode* aroma_dropdown_create(AromaNode* parent, int x, int y, int width, int
         return NULL;
     }
 
-    AromaDropdown* dd = (AromaDropdown*)aroma_widget_alloc(sizeof(AromaDropdown));
+    AromaDropdown* dd = (AromaDropdown*)aroma_widget_alloc_under(parent, sizeof(AromaDropdown));
     if (!dd) {
         LOG_ERROR("Failed to allocate dropdown");
         return NULL;
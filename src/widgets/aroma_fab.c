@@ -103,7 +103,7 @@ static void __fab_update_layout(AromaFAB* fab)
 
 AromaNode* aroma_fab_create(AromaNode* parent, int x, int y, AromaFABSize size, const char* icon_text) {
     if (!parent) return NULL;
-    AromaFAB* fab = (AromaFAB*)aroma_widget_alloc(sizeof(AromaFAB));
+    AromaFAB* fab = (AromaFAB*)aroma_widget_alloc_under(parent, sizeof(AromaFAB));
     if (!fab) return NULL;
 
     int fab_size = get_fab_size(size);
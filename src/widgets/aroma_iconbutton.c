@@ -88,7 +88,7 @@ AromaNode* aroma_iconbutton_create(AromaNode* parent, const char* icon_text, int
 {
     if (!parent || size <= 0) return NULL;
 
-    AromaIconButton* btn = (AromaIconButton*)aroma_widget_alloc(sizeof(AromaIconButton));
+    AromaIconButton* btn = (AromaIconButton*)aroma_widget_alloc_under(parent, sizeof(AromaIconButton));
     if (!btn) return NULL;
 
     AromaTheme theme = aroma_theme_get_global();
@@ -27,14 +27,14 @@
 #include "backends/graphics/aroma_graphics_interface.h"
 #include "backends/platforms/aroma_platform_interface.h"
 #include "core/aroma_common.h"
+#include "core/aroma_string.h"
 #include <string.h>
 
-#define AROMA_IMAGE_PATH_MAX 1024
 
 typedef struct AromaImage {
     AromaRect rect;
     unsigned int texture_id;
-    char image_path[AROMA_IMAGE_PATH_MAX];
+    AromaStr image_path;
     bool owns_texture; 
 } AromaImage;
 
@@ -49,6 +49,12 @@ static void __image_destroy_texture(AromaImage* image)
     }
 }
 
+static void __image_release(AromaNode* image_node)
+{
+    AromaImage* image = (AromaImage*)image_node->node_widget_ptr;
+    if (image) aroma_str_release(&image->image_path);
+}
+
 static unsigned int __image_load_texture(const char* image_path)
 {
     if (!image_path || strlen(image_path) == 0) {
@@ -111,7 +117,7 @@ AromaNode* aroma_image_create(AromaNode* parent, const char* image_path, int x,
         return NULL;
     }
 
-    AromaImage* image = (AromaImage*)aroma_widget_alloc(sizeof(AromaImage));
+    AromaImage* image = (AromaImage*)aroma_widget_alloc_under(parent, sizeof(AromaImage));
     if (!image) {
         LOG_ERROR("Failed to allocate memory for image widget");
         return NULL;
@@ -126,7 +132,7 @@ AromaNode* aroma_image_create(AromaNode* parent, const char* image_path, int x,
     image->owns_texture = true;
     
     if (image_path) {
-        strncpy(image->image_path, image_path, AROMA_IMAGE_PATH_MAX - 1);
+        aroma_str_set(&image->image_path, image_path);
         image->texture_id = __image_load_texture(image_path);
         if (image->texture_id == 0) {
             LOG_WARNING("Failed to load image: %s", image_path);
@@ -136,12 +142,14 @@ AromaNode* aroma_image_create(AromaNode* parent, const char* image_path, int x,
     AromaNode* node = __add_child_node(NODE_TYPE_WIDGET, parent, image);
     if (!node) {
         __image_destroy_texture(image);
+        aroma_str_release(&image->image_path);
         aroma_widget_free(image);
         LOG_ERROR("Failed to create node for image widget");
         return NULL;
     }
 
     aroma_node_set_draw_cb(node, aroma_image_draw);
+    aroma_node_set_destroy_cb(node, __image_release);
     
     LOG_INFO("Created image widget at (%d, %d) size %dx%d, texture ID: %u", 
               x, y, width, height, image->texture_id);
@@ -161,7 +169,7 @@ AromaNode* aroma_image_create_from_memory(AromaNode* parent, unsigned char* data
         return NULL;
     }
 
-    AromaImage* image = (AromaImage*)aroma_widget_alloc(sizeof(AromaImage));
+    AromaImage* image = (AromaImage*)aroma_widget_alloc_under(parent, sizeof(AromaImage));
     if (!image) {
         LOG_ERROR("Failed to allocate memory for image widget");
         return NULL;
@@ -173,7 +181,6 @@ AromaNode* aroma_image_create_from_memory(AromaNode* parent, unsigned char* data
     image->rect.width = width;
     image->rect.height = height;
     image->owns_texture = true;
-    image->image_path[0] = '\0'; 
 
     AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
     if (gfx && gfx->load_image_from_memory) {
@@ -194,6 +201,7 @@ AromaNode* aroma_image_create_from_memory(AromaNode* parent, unsigned char* data
     }
 
     aroma_node_set_draw_cb(node, aroma_image_draw);
+    aroma_node_set_destroy_cb(node, __image_release);
        #ifdef ESP32
     aroma_node_invalidate(node);
     #endif
@@ -211,7 +219,7 @@ AromaNode* aroma_image_create_from_texture(AromaNode* parent, unsigned int textu
         return NULL;
     }
 
-    AromaImage* image = (AromaImage*)aroma_widget_alloc(sizeof(AromaImage));
+    AromaImage* image = (AromaImage*)aroma_widget_alloc_under(parent, sizeof(AromaImage));
     if (!image) {
         LOG_ERROR("Failed to allocate memory for image widget");
         return NULL;
@@ -224,7 +232,6 @@ AromaNode* aroma_image_create_from_texture(AromaNode* parent, unsigned int textu
     image->rect.height = height;
     image->texture_id = texture_id;
     image->owns_texture = take_ownership;
-    image->image_path[0] = '\0'; 
 
     AromaNode* node = __add_child_node(NODE_TYPE_WIDGET, parent, image);
     if (!node) {
@@ -236,6 +243,7 @@ AromaNode* aroma_image_create_from_texture(AromaNode* parent, unsigned int textu
     }
 
     aroma_node_set_draw_cb(node, aroma_image_draw);
+    aroma_node_set_destroy_cb(node, __image_release);
     
     LOG_INFO("Created texture image widget at (%d, %d) size %dx%d, texture ID: %u", 
               x, y, width, height, texture_id);
@@ -256,11 +264,11 @@ void aroma_image_set_source(AromaNode* image_node, const char* image_path)
     
     // Load new texture
     if (image_path) {
-        strncpy(image->image_path, image_path, AROMA_IMAGE_PATH_MAX - 1);
+        aroma_str_set(&image->image_path, image_path);
         image->texture_id = __image_load_texture(image_path);
         image->owns_texture = true;
     } else {
-        image->image_path[0] = '\0';
+        aroma_str_release(&image->image_path);
         image->texture_id = 0;
         image->owns_texture = false;
     }
@@ -350,7 +358,7 @@ const char* aroma_image_get_source(AromaNode* image_node)
     }
     
     AromaImage* image = (AromaImage*)image_node->node_widget_ptr;
-    return image->image_path;
+    return aroma_str_get(&image->image_path);
 }
 
 
@@ -365,6 +373,7 @@ void aroma_image_destroy(AromaNode* image_node)
         AromaImage* image = (AromaImage*)image_node->node_widget_ptr;
         
         __image_destroy_texture(image);
+        __image_release(image_node);
         
         aroma_widget_free(image);
         image_node->node_widget_ptr = NULL;
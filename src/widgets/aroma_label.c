@@ -23,21 +23,28 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_style.h"
+#include "core/aroma_post.h"
+#include "core/aroma_string.h"
+#include "core/aroma_drawlist.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <string.h>
 
-#define AROMA_LABEL_TEXT_MAX 256
-
 typedef struct AromaLabel {
     AromaRect rect;
-    char text[AROMA_LABEL_TEXT_MAX];
+    AromaStr text;
     AromaLabelStyle style;
     uint32_t color;
     AromaFont* font;
     float text_scale;
 } AromaLabel;
 
+static void __label_release(AromaNode* label_node)
+{
+    AromaLabel* label = (AromaLabel*)label_node->node_widget_ptr;
+    if (label) aroma_str_release(&label->text);
+}
+
 static uint32_t __label_default_color(void)
 {
     AromaTheme theme = aroma_theme_get_global();
@@ -51,7 +58,7 @@ AromaNode* aroma_label_create(AromaNode* parent, const char* text, int x, int y,
         return NULL;
     }
 
-    AromaLabel* label = (AromaLabel*)aroma_widget_alloc(sizeof(AromaLabel));
+    AromaLabel* label = (AromaLabel*)aroma_widget_alloc_under(parent, sizeof(AromaLabel));
     if (!label) return NULL;
 
     memset(label, 0, sizeof(AromaLabel));
@@ -62,7 +69,7 @@ AromaNode* aroma_label_create(AromaNode* parent, const char* text, int x, int y,
     label->style = style;
     label->color = __label_default_color();
     label->font = NULL;
-    strncpy(label->text, text, AROMA_LABEL_TEXT_MAX - 1);
+    aroma_str_set(&label->text, text);
     
     static const float LABEL_SCALES[] = {
         [LABEL_STYLE_LABEL_LARGE]     = 1.0f,
@@ -78,12 +85,14 @@ AromaNode* aroma_label_create(AromaNode* parent, const char* text, int x, int y,
 
     AromaNode* node = __add_child_node(NODE_TYPE_WIDGET, parent, label);
     if (!node) {
+        aroma_str_release(&label->text);
         aroma_widget_free(label);
         return NULL;
     }
 
 
     aroma_node_set_draw_cb(node, aroma_label_draw);
+    aroma_node_set_destroy_cb(node, __label_release);
     
     #ifdef ESP32
     aroma_node_invalidate(node); 
@@ -96,10 +105,20 @@ void aroma_label_set_text(AromaNode* label_node, const char* text)
 {
     if (!label_node || !label_node->node_widget_ptr || !text) return;
     AromaLabel* label = (AromaLabel*)label_node->node_widget_ptr;
-    strncpy(label->text, text, AROMA_LABEL_TEXT_MAX - 1);
+    aroma_str_set(&label->text, text);
     aroma_node_invalidate(label_node);
 }
 
+static void __label_apply_posted_text(AromaNode* label_node, const AromaPostValue* value)
+{
+    aroma_label_set_text(label_node, value->text);
+}
+
+bool aroma_label_post_text(uint64_t label_node_id, const char* text)
+{
+    return aroma_post_text(label_node_id, __label_apply_posted_text, text);
+}
+
 void aroma_label_set_color(AromaNode* label_node, uint32_t color)
 {
     if (!label_node || !label_node->node_widget_ptr) return;
@@ -135,13 +154,14 @@ void aroma_label_draw(AromaNode* label_node, size_t window_id)
     #endif
     //        aroma_node_invalidate(label_node);
     if (!gfx || !gfx->render_text) return;    
-    gfx->render_text(window_id, label->font, label->text, label->rect.x, label->rect.y, label->color, label->text_scale);
+    aroma_draw_text_str(window_id, label->font, &label->text, label->rect.x, label->rect.y, label->color, label->text_scale);
 }
 
 void aroma_label_destroy(AromaNode* label_node)
 {
     if (!label_node) return;
     if (label_node->node_widget_ptr) {
+        __label_release(label_node);
         aroma_widget_free(label_node->node_widget_ptr);
         label_node->node_widget_ptr = NULL;
     }
@@ -25,16 +25,20 @@
 #include "core/aroma_style.h"
 #include "core/aroma_event.h"
 #include "aroma_ui.h"
+#include "core/aroma_string.h"
+#include "core/aroma_drawlist.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <string.h>
 
 #define AROMA_LIST_MAX_ITEMS 64
+#define AROMA_LIST_INITIAL_ITEMS 8
 
 typedef struct AromaListView {
     AromaRect rect;
-    AromaListItem items[AROMA_LIST_MAX_ITEMS];
+    AromaListItem* items;
     size_t item_count;
+    size_t item_capacity;
     int selected_index;
     AromaFont* font;
     void (*callback)(int index, void* user_data);
@@ -45,6 +49,46 @@ typedef struct AromaListView {
     float text_scale;
 } AromaListView;
 
+static void __listview_release_items(AromaListView* list)
+{
+    for (size_t i = 0; i < list->item_count; ++i) {
+        aroma_str_release(&list->items[i].text);
+        aroma_str_release(&list->items[i].secondary_text);
+    }
+    list->item_count = 0;
+}
+
+static void __listview_release(AromaNode* list_node)
+{
+    AromaListView* list = (AromaListView*)list_node->node_widget_ptr;
+    if (!list || !list->items) return;
+    __listview_release_items(list);
+    aroma_widget_free(list->items);
+    list->items = NULL;
+    list->item_capacity = 0;
+}
+
+/* Items live out of line and double on demand up to AROMA_LIST_MAX_ITEMS. */
+static AromaListItem* __listview_push_item(AromaListView* list)
+{
+    if (list->item_count >= AROMA_LIST_MAX_ITEMS) return NULL;
+    if (list->item_count == list->item_capacity) {
+        size_t capacity = list->item_capacity ? list->item_capacity * 2 : AROMA_LIST_INITIAL_ITEMS;
+        if (capacity > AROMA_LIST_MAX_ITEMS) capacity = AROMA_LIST_MAX_ITEMS;
+        AromaListItem* items = (AromaListItem*)aroma_widget_alloc(capacity * sizeof(AromaListItem));
+        if (!items) return NULL;
+        if (list->items) {
+            memcpy(items, list->items, list->item_count * sizeof(AromaListItem));
+            aroma_widget_free(list->items);
+        }
+        list->items = items;
+        list->item_capacity = capacity;
+    }
+    AromaListItem* item = &list->items[list->item_count++];
+    memset(item, 0, sizeof(AromaListItem));
+    return item;
+}
+
 static bool __listview_handle_event(AromaEvent* event, void* user_data)
 {
     (void)user_data;
@@ -71,7 +115,7 @@ static bool __listview_handle_event(AromaEvent* event, void* user_data)
 AromaNode* aroma_listview_create(AromaNode* parent, int x, int y, int width, int height)
 {
     if (!parent || width <= 0 || height <= 0) return NULL;
-    AromaListView* list = (AromaListView*)aroma_widget_alloc(sizeof(AromaListView));
+    AromaListView* list = (AromaListView*)aroma_widget_alloc_under(parent, sizeof(AromaListView));
     if (!list) return NULL;
 
     memset(list, 0, sizeof(AromaListView));
@@ -93,6 +137,7 @@ AromaNode* aroma_listview_create(AromaNode* parent, int x, int y, int width, int
     }
 
     aroma_node_set_draw_cb(node, aroma_listview_draw);
+    aroma_node_set_destroy_cb(node, __listview_release);
 
     aroma_event_subscribe(node->node_id, EVENT_TYPE_MOUSE_CLICK, __listview_handle_event, NULL, 80);
 
@@ -107,11 +152,10 @@ void aroma_listview_add_item(AromaNode* list_node, const char* text, const char*
 {
     if (!list_node || !list_node->node_widget_ptr || !text) return;
     AromaListView* list = (AromaListView*)list_node->node_widget_ptr;
-    if (list->item_count >= AROMA_LIST_MAX_ITEMS) return;
-
-    AromaListItem* item = &list->items[list->item_count++];
-    strncpy(item->text, text, sizeof(item->text) - 1);
-    if (secondary_text) strncpy(item->secondary_text, secondary_text, sizeof(item->secondary_text) - 1);
+    AromaListItem* item = __listview_push_item(list);
+    if (!item) return;
+    aroma_str_set(&item->text, text);
+    aroma_str_set(&item->secondary_text, secondary_text);
     item->user_data = user_data;
     aroma_node_invalidate(list_node);
 }
@@ -120,7 +164,7 @@ void aroma_listview_clear(AromaNode* list_node)
 {
     if (!list_node || !list_node->node_widget_ptr) return;
     AromaListView* list = (AromaListView*)list_node->node_widget_ptr;
-    list->item_count = 0;
+    __listview_release_items(list);
     list->selected_index = -1;
     aroma_node_invalidate(list_node);
 }
@@ -153,10 +197,12 @@ void aroma_listview_draw(AromaNode* list_node, size_t window_id)
                         theme.colors.surface, true, list->corner_radius);
     if (aroma_node_is_hidden(list_node)) return;
 
+    /* Rows are clipped to the list, so the last one may show in part. */
     int item_height = 28;
+    aroma_draw_push_clip(window_id, list->rect.x, list->rect.y, list->rect.width, list->rect.height);
     for (size_t i = 0; i < list->item_count; ++i) {
         int y = list->rect.y + (int)i * item_height;
-        if (y + item_height > list->rect.y + list->rect.height) break;
+        if (y >= list->rect.y + list->rect.height) break;
 
         if ((int)i == list->selected_index) {
             gfx->fill_rectangle(window_id, list->rect.x + 2, y, list->rect.width - 4, item_height,
@@ -170,15 +216,17 @@ void aroma_listview_draw(AromaNode* list_node, size_t window_id)
         #endif
         {
         
-            gfx->render_text(window_id, list->font, list->items[i].text, list->rect.x + 12, y + 18, theme.colors.text_primary, list->text_scale);
+            aroma_draw_text_str(window_id, list->font, &list->items[i].text, list->rect.x + 12, y + 18, theme.colors.text_primary, list->text_scale);
         }
     }
+    aroma_draw_pop_clip(window_id);
 }
 
 void aroma_listview_destroy(AromaNode* list_node)
 {
     if (!list_node) return;
     if (list_node->node_widget_ptr) {
+        __listview_release(list_node);
         aroma_widget_free(list_node->node_widget_ptr);
         list_node->node_widget_ptr = NULL;
     }
@@ -25,16 +25,20 @@
 #include "core/aroma_style.h"
 #include "core/aroma_event.h"
 #include "aroma_ui.h"
+#include "core/aroma_string.h"
+#include "core/aroma_drawlist.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <string.h>
 
 #define AROMA_MENU_MAX_ITEMS 32
+#define AROMA_MENU_INITIAL_ITEMS 4
 
 typedef struct AromaMenu {
     AromaRect rect;
-    AromaMenuItem items[AROMA_MENU_MAX_ITEMS];
+    AromaMenuItem* items;
     size_t item_count;
+    size_t item_capacity;
     bool visible;
     AromaFont* font;
     int item_height;
@@ -45,6 +49,41 @@ typedef struct AromaMenu {
     float text_scale;
 } AromaMenu;
 
+static void __menu_release(AromaNode* menu_node)
+{
+    AromaMenu* menu = (AromaMenu*)menu_node->node_widget_ptr;
+    if (!menu || !menu->items) return;
+    for (size_t i = 0; i < menu->item_count; ++i) {
+        aroma_str_release(&menu->items[i].text);
+    }
+    aroma_widget_free(menu->items);
+    menu->items = NULL;
+    menu->item_count = 0;
+    menu->item_capacity = 0;
+}
+
+/* Items live out of line and double on demand, so a short context menu
+   does not carry AROMA_MENU_MAX_ITEMS slots around. */
+static AromaMenuItem* __menu_push_item(AromaMenu* menu)
+{
+    if (menu->item_count >= AROMA_MENU_MAX_ITEMS) return NULL;
+    if (menu->item_count == menu->item_capacity) {
+        size_t capacity = menu->item_capacity ? menu->item_capacity * 2 : AROMA_MENU_INITIAL_ITEMS;
+        if (capacity > AROMA_MENU_MAX_ITEMS) capacity = AROMA_MENU_MAX_ITEMS;
+        AromaMenuItem* items = (AromaMenuItem*)aroma_widget_alloc(capacity * sizeof(AromaMenuItem));
+        if (!items) return NULL;
+        if (menu->items) {
+            memcpy(items, menu->items, menu->item_count * sizeof(AromaMenuItem));
+            aroma_widget_free(menu->items);
+        }
+        menu->items = items;
+        menu->item_capacity = capacity;
+    }
+    AromaMenuItem* item = &menu->items[menu->item_count++];
+    memset(item, 0, sizeof(AromaMenuItem));
+    return item;
+}
+
 static bool __menu_handle_event(AromaEvent* event, void* user_data)
 {
     (void)user_data;
@@ -71,7 +110,7 @@ static bool __menu_handle_event(AromaEvent* event, void* user_data)
 AromaNode* aroma_menu_create(AromaNode* parent, int x, int y)
 {
     if (!parent) return NULL;
-    AromaMenu* menu = (AromaMenu*)aroma_widget_alloc(sizeof(AromaMenu));
+    AromaMenu* menu = (AromaMenu*)aroma_widget_alloc_under(parent, sizeof(AromaMenu));
     if (!menu) return NULL;
 
     memset(menu, 0, sizeof(AromaMenu));
@@ -97,6 +136,7 @@ AromaNode* aroma_menu_create(AromaNode* parent, int x, int y)
     }
 
     aroma_node_set_draw_cb(node, aroma_menu_draw);
+    aroma_node_set_destroy_cb(node, __menu_release);
 
     aroma_event_subscribe(node->node_id, EVENT_TYPE_MOUSE_CLICK, __menu_handle_event, NULL, 80);
     
@@ -111,11 +151,9 @@ void aroma_menu_add_item(AromaNode* menu_node, const char* text, void (*callback
 {
     if (!menu_node || !menu_node->node_widget_ptr || !text) return;
     AromaMenu* menu = (AromaMenu*)menu_node->node_widget_ptr;
-    if (menu->item_count >= AROMA_MENU_MAX_ITEMS) return;
-
-    AromaMenuItem* item = &menu->items[menu->item_count++];
-    memset(item, 0, sizeof(AromaMenuItem));
-    strncpy(item->text, text, sizeof(item->text) - 1);
+    AromaMenuItem* item = __menu_push_item(menu);
+    if (!item) return;
+    aroma_str_set(&item->text, text);
     item->enabled = true;
     item->callback = callback;
     item->user_data = user_data;
@@ -126,9 +164,8 @@ void aroma_menu_add_separator(AromaNode* menu_node)
 {
     if (!menu_node || !menu_node->node_widget_ptr) return;
     AromaMenu* menu = (AromaMenu*)menu_node->node_widget_ptr;
-    if (menu->item_count >= AROMA_MENU_MAX_ITEMS) return;
-    AromaMenuItem* item = &menu->items[menu->item_count++];
-    memset(item, 0, sizeof(AromaMenuItem));
+    AromaMenuItem* item = __menu_push_item(menu);
+    if (!item) return;
     item->separator = true;
     menu->rect.height = (int)menu->item_count * menu->item_height;
 }
@@ -180,7 +217,7 @@ void aroma_menu_draw(AromaNode* menu_node, size_t window_id)
             continue;
         }
         if (menu->font && gfx->render_text) {
-            gfx->render_text(window_id, menu->font, menu->items[i].text, menu->rect.x + 12, y + (menu->item_height/2), menu->text_color, menu->text_scale);
+            aroma_draw_text_str(window_id, menu->font, &menu->items[i].text, menu->rect.x + 12, y + (menu->item_height/2), menu->text_color, menu->text_scale);
         }
     }
 }
@@ -189,6 +226,7 @@ void aroma_menu_destroy(AromaNode* menu_node)
 {
     if (!menu_node) return;
     if (menu_node->node_widget_ptr) {
+        __menu_release(menu_node);
         aroma_widget_free(menu_node->node_widget_ptr);
         menu_node->node_widget_ptr = NULL;
     }
@@ -2,6 +2,8 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_style.h"
+#include "core/aroma_animation.h"
+#include "core/aroma_post.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 
@@ -15,16 +17,19 @@ typedef struct AromaProgressBar {
     int fill_width;
 } AromaProgressBar;
 
-static void __progressbar_update_fill(AromaProgressBar* bar)
+static void __progressbar_update_fill(AromaNode* node, AromaProgressBar* bar)
 {
-    bar->fill_width = (int)(bar->rect.width * bar->progress);
+    AromaTheme theme = aroma_theme_get_global();
+    uint32_t duration = theme.transition_duration_ms > 0 ? (uint32_t)theme.transition_duration_ms : 0;
+    aroma_animate_int(node, bar->rect, &bar->fill_width, (int)(bar->rect.width * bar->progress),
+                      duration, AROMA_EASE_OUT_QUAD);
 }
 
 AromaNode* aroma_progressbar_create(AromaNode* parent, int x, int y, int width, int height, AromaProgressType type)
 {
     if (!parent || width <= 0 || height <= 0) return NULL;
 
-    AromaProgressBar* bar = (AromaProgressBar*)aroma_widget_alloc(sizeof(AromaProgressBar));
+    AromaProgressBar* bar = (AromaProgressBar*)aroma_widget_alloc_under(parent, sizeof(AromaProgressBar));
     if (!bar) return NULL;
 
     AromaTheme theme = aroma_theme_get_global();
@@ -61,8 +66,17 @@ void aroma_progressbar_set_progress(AromaNode* progress_node, float progress)
     if (progress < 0.0f) progress = 0.0f;
     if (progress > 1.0f) progress = 1.0f;
     bar->progress = progress;
-    __progressbar_update_fill(bar);
-    aroma_node_invalidate(progress_node);
+    __progressbar_update_fill(progress_node, bar);
+}
+
+static void __progressbar_apply_posted_progress(AromaNode* progress_node, const AromaPostValue* value)
+{
+    aroma_progressbar_set_progress(progress_node, value->f);
+}
+
+bool aroma_progressbar_post_progress(uint64_t progress_node_id, float progress)
+{
+    return aroma_post_float(progress_node_id, __progressbar_apply_posted_progress, progress);
 }
 
 float aroma_progressbar_get_progress(AromaNode* progress_node)
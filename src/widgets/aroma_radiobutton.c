@@ -159,7 +159,7 @@ AromaNode* aroma_radio_button_create(AromaNode* parent, AromaRadioGroup* group,
         return NULL;
     }
 
-    AromaRadioButton* data = (AromaRadioButton*)aroma_widget_alloc(sizeof(AromaRadioButton));
+    AromaRadioButton* data = (AromaRadioButton*)aroma_widget_alloc_under(parent, sizeof(AromaRadioButton));
     if (!data) {
         LOG_ERROR("Failed to allocate radio button");
         return NULL;
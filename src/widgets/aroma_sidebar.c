@@ -145,7 +145,7 @@ AromaNode* aroma_sidebar_create(AromaNode* parent, int x, int y, int width, int
 {
     if (!parent || !labels || count <= 0) return NULL;
 
-    AromaSidebar* sidebar = (AromaSidebar*)aroma_widget_alloc(sizeof(AromaSidebar));
+    AromaSidebar* sidebar = (AromaSidebar*)aroma_widget_alloc_under(parent, sizeof(AromaSidebar));
     if (!sidebar) return NULL;
 
     memset(sidebar, 0, sizeof(AromaSidebar));
@@ -24,7 +24,7 @@ AromaNode* aroma_slider_create(AromaNode* parent, int x, int y, int width, int h
         return NULL;
     }
 
-    AromaSlider* data = (AromaSlider*)aroma_widget_alloc(sizeof(AromaSlider));
+    AromaSlider* data = (AromaSlider*)aroma_widget_alloc_under(parent, sizeof(AromaSlider));
     if (!data) {
         LOG_ERROR("Failed to allocate slider data\n");
         return NULL;
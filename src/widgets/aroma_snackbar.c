@@ -105,7 +105,7 @@ static void __snackbar_auto_dismiss(void* arg)
 AromaNode* aroma_snackbar_create(AromaNode* parent, const char* message, int duration_ms)
 {
     if (!parent || !message) return NULL;
-    AromaSnackbar* bar = (AromaSnackbar*)aroma_widget_alloc(sizeof(AromaSnackbar));
+    AromaSnackbar* bar = (AromaSnackbar*)aroma_widget_alloc_under(parent, sizeof(AromaSnackbar));
     if (!bar) return NULL;
 
     memset(bar, 0, sizeof(AromaSnackbar));
@@ -4,6 +4,7 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_style.h"
+#include "core/aroma_animation.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <stdlib.h>
@@ -16,7 +17,7 @@ AromaNode* aroma_switch_create(AromaNode* parent, int x, int y, int width, int h
         return NULL;
     }
 
-    AromaSwitch* data = (AromaSwitch*)aroma_widget_alloc(sizeof(AromaSwitch));
+    AromaSwitch* data = (AromaSwitch*)aroma_widget_alloc_under(parent, sizeof(AromaSwitch));
     if (!data) {
         LOG_ERROR("Failed to allocate switch data\n");
         return NULL;
@@ -30,6 +31,7 @@ AromaNode* aroma_switch_create(AromaNode* parent, int x, int y, int width, int h
     AromaTheme theme = aroma_theme_get_global();
     data->color_on = theme.colors.primary;
     data->color_off = theme.colors.border;
+    data->track_color = data->state ? data->color_on : data->color_off;
     data->is_hovered = false;
 
     data->track_radius = (float)data->rect.height / 2.0f;
@@ -66,7 +68,12 @@ void aroma_switch_set_state(AromaNode* node, bool state)
     AromaSwitch* data = (AromaSwitch*)node->node_widget_ptr;
     if (data->state != state) {
         data->state = state;
-        data->toggle_x = data->state ? (data->rect.x + data->rect.width - data->toggle_size - 2) : (data->rect.x + 2);
+        int target_x = data->state ? (data->rect.x + data->rect.width - data->toggle_size - 2) : (data->rect.x + 2);
+        uint32_t target_color = data->state ? data->color_on : data->color_off;
+        AromaTheme theme = aroma_theme_get_global();
+        uint32_t duration = theme.transition_duration_ms > 0 ? (uint32_t)theme.transition_duration_ms : 0;
+        aroma_animate_int(node, data->rect, &data->toggle_x, target_x, duration, AROMA_EASE_OUT_CUBIC);
+        aroma_animate_color(node, data->rect, &data->track_color, target_color, duration, AROMA_EASE_LINEAR);
         if (data->on_change) {
             data->on_change(node, data->user_data);
         }
@@ -97,10 +104,9 @@ void aroma_switch_draw(AromaNode* node, size_t window_id)
     AromaGraphicsInterface* gfx = aroma_backend_abi.get_graphics_interface();
     if (!gfx) return;
 
-    uint32_t bg_color = data->state ? data->color_on : data->color_off;
+    uint32_t bg_color = data->track_color;
     if (data->is_hovered) {
-        bg_color = data->state ? aroma_color_adjust(data->color_on, 0.08f)
-                                : aroma_color_adjust(data->color_off, 0.08f);
+        bg_color = aroma_color_adjust(data->track_color, 0.08f);
     }
     gfx->fill_rectangle(window_id, data->rect.x, data->rect.y, data->rect.width, data->rect.height, bg_color, true, data->track_radius);
 
@@ -161,7 +161,7 @@ AromaNode* aroma_tabs_create(AromaNode* parent, int x, int y, int width, int hei
 {
     if (!parent || !labels || count <= 0) return NULL;
 
-    AromaTabs* tabs = (AromaTabs*)aroma_widget_alloc(sizeof(AromaTabs));
+    AromaTabs* tabs = (AromaTabs*)aroma_widget_alloc_under(parent, sizeof(AromaTabs));
     if (!tabs) return NULL;
 
     memset(tabs, 0, sizeof(AromaTabs));
@@ -4,23 +4,130 @@
 #include "core/aroma_logger.h"
 #include "core/aroma_slab_alloc.h"
 #include "core/aroma_font.h"
+#include "core/aroma_timer.h"
 #include "aroma_ui.h"
 #include "core/aroma_style.h"
 #include "backends/aroma_abi.h"
 #include "backends/graphics/aroma_graphics_interface.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 #define AROMA_TEXTBOX_PADDING_X 8
+#define AROMA_TEXTBOX_CURSOR_WIDTH 2
+#define AROMA_TEXTBOX_INITIAL_CAPACITY 32
+#define AROMA_TEXTBOX_CURSOR_BLINKS (AROMA_TEXTBOX_CURSOR_BLINK_TIMEOUT / AROMA_TEXTBOX_CURSOR_BLINK_RATE)
+
+/* Only one caret blinks at a time, so its state lives here rather than in
+   every textbox. The node is tracked by id because a tree teardown can free
+   the textbox without going through aroma_textbox_destroy. */
+static struct {
+    AromaTimer* timer;
+    uint64_t node_id;
+    uint16_t blinks_left;
+    bool paused;
+} g_caret = {0};
+
+static AromaNode* __textbox_caret_node(void)
+{
+    if (g_caret.node_id == AROMA_NODE_ID_INVALID) return NULL;
+    for (int i = 0; i < g_window_count; ++i) {
+        AromaNode* node = __find_node_by_id(g_windows[i].root_node, g_caret.node_id);
+        if (node) return node;
+    }
+    return NULL;
+}
+
+/* Resolved from the tree so a caret focused before its first draw still follows its window. */
+static bool __textbox_in_window(const AromaNode* node, size_t window_id)
+{
+    while (node->parent_node) node = node->parent_node;
+    for (int i = 0; i < g_window_count; ++i) {
+        if (g_windows[i].window_id == window_id) return g_windows[i].root_node == node;
+    }
+    return false;
+}
+
+static void __textbox_damage_caret(AromaNode* node, const AromaTextbox* textbox)
+{
+    if (textbox->cursor_height > 0) {
+        aroma_node_invalidate_rect(node, textbox->cursor_x, textbox->cursor_y,
+                                   AROMA_TEXTBOX_CURSOR_WIDTH, textbox->cursor_height);
+    } else {
+        aroma_node_invalidate(node);
+    }
+}
+
+static void __textbox_stop_caret(void)
+{
+    if (g_caret.timer) aroma_timer_cancel(g_caret.timer);
+    g_caret.timer = NULL;
+    g_caret.node_id = AROMA_NODE_ID_INVALID;
+}
 
-static uint64_t __textbox_now_ms(void)
+static void __textbox_caret_blink(void* user_data)
 {
-    struct timespec ts;
-    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
-        return 0;
+    (void)user_data;
+    AromaNode* node = __textbox_caret_node();
+    AromaTextbox* textbox = node ? (AromaTextbox*)node->node_widget_ptr : NULL;
+    if (!textbox || !textbox->is_focused) {
+        __textbox_stop_caret();
+        return;
+    }
+
+    if (g_caret.blinks_left == 0) {
+        /* Idle for a while: leave the caret solid and stop waking the loop. */
+        aroma_timer_set_paused(g_caret.timer, true);
+        if (!textbox->show_cursor) {
+            textbox->show_cursor = true;
+            __textbox_damage_caret(node, textbox);
+        }
+        return;
+    }
+
+    g_caret.blinks_left--;
+    textbox->show_cursor = !textbox->show_cursor;
+    __textbox_damage_caret(node, textbox);
+}
+
+static void __textbox_start_caret(AromaNode* node)
+{
+    if (!g_caret.timer) {
+        g_caret.timer = aroma_timer_create(AROMA_TEXTBOX_CURSOR_BLINK_RATE, true, __textbox_caret_blink, NULL);
+    }
+    g_caret.node_id = node->node_id;
+    g_caret.paused = aroma_ui_is_idle_throttled() || !aroma_ui_is_node_window_focused(node);
+}
+
+static void __textbox_restart_caret(AromaNode* node)
+{
+    AromaTextbox* textbox = (AromaTextbox*)node->node_widget_ptr;
+    textbox->show_cursor = true;
+    /* Edits to other textboxes must not keep the focused caret awake. */
+    if (g_caret.node_id != node->node_id) return;
+    g_caret.blinks_left = AROMA_TEXTBOX_CURSOR_BLINKS;
+    if (g_caret.timer) {
+        aroma_timer_reset(g_caret.timer);
+        aroma_timer_set_paused(g_caret.timer, g_caret.paused);
+    }
+}
+
+void aroma_textbox_set_caret_blink_paused(size_t window_id, bool paused)
+{
+    AromaNode* node = __textbox_caret_node();
+    AromaTextbox* textbox = node ? (AromaTextbox*)node->node_widget_ptr : NULL;
+    if (!textbox || !__textbox_in_window(node, window_id)) return;
+    if (g_caret.paused == paused) return;
+
+    g_caret.paused = paused;
+    if (paused) {
+        aroma_timer_set_paused(g_caret.timer, true);
+        if (!textbox->show_cursor) {
+            textbox->show_cursor = true;
+            __textbox_damage_caret(node, textbox);
+        }
+    } else {
+        __textbox_restart_caret(node);
     }
-    return (uint64_t)ts.tv_sec * 1000ull + (uint64_t)(ts.tv_nsec / 1000000ull);
 }
 
 static bool __textbox_contains_point(const AromaTextbox* textbox, int x, int y)
@@ -52,10 +159,20 @@ static float __textbox_measure_prefix(const AromaTextbox* textbox, AromaGraphics
         return (float)(length * 8);
     }
     if (length > textbox->text_length) length = textbox->text_length;
-    char buffer[AROMA_TEXTBOX_MAX_LENGTH];
-    memcpy(buffer, textbox->text, length);
-    buffer[length] = '\0';
-    return gfx->measure_text(window_id, textbox->font, buffer, textbox->text_scale);
+    if (length == 0) return 0.0f;
+    AromaFrameArena* arena = aroma_ui_get_frame_arena(window_id);
+    if (!arena) {
+        char buffer[AROMA_TEXTBOX_MAX_LENGTH];
+        memcpy(buffer, textbox->text, length);
+        buffer[length] = '\0';
+        return gfx->measure_text(window_id, textbox->font, buffer, textbox->text_scale);
+    }
+    /* Scratch copy: rewound straight away so event-time measuring never grows the arena. */
+    AromaFrameArenaMark mark = aroma_frame_arena_mark(arena);
+    char* prefix = aroma_frame_arena_strndup(arena, textbox->text, length);
+    float width = prefix ? gfx->measure_text(window_id, textbox->font, prefix, textbox->text_scale) : (float)(length * 8);
+    aroma_frame_arena_rewind(arena, mark);
+    return width;
 }
 
 static size_t __textbox_cursor_from_click(const AromaTextbox* textbox, AromaGraphicsInterface* gfx,
@@ -81,6 +198,39 @@ static size_t __textbox_cursor_from_click(const AromaTextbox* textbox, AromaGrap
     return textbox->text_length;
 }
 
+/* Grows the edit buffer to hold `length` characters plus the terminator,
+   doubling up to AROMA_TEXTBOX_MAX_LENGTH. */
+static bool __textbox_reserve(AromaTextbox* data, size_t length)
+{
+    if (length >= AROMA_TEXTBOX_MAX_LENGTH) return false;
+    if (length < data->text_capacity) return true;
+    size_t capacity = data->text_capacity ? data->text_capacity : AROMA_TEXTBOX_INITIAL_CAPACITY;
+    while (capacity <= length) capacity *= 2;
+    if (capacity > AROMA_TEXTBOX_MAX_LENGTH) capacity = AROMA_TEXTBOX_MAX_LENGTH;
+    char* text = (char*)aroma_widget_alloc(capacity);
+    if (!text) return false;
+    if (data->text) {
+        memcpy(text, data->text, data->text_length + 1);
+        aroma_widget_free(data->text);
+    } else {
+        text[0] = '\0';
+    }
+    data->text = text;
+    data->text_capacity = capacity;
+    return true;
+}
+
+static void __textbox_release(AromaNode* node)
+{
+    AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
+    if (!data) return;
+    if (data->text) aroma_widget_free(data->text);
+    data->text = NULL;
+    data->text_capacity = 0;
+    data->text_length = 0;
+    aroma_str_release(&data->placeholder);
+}
+
 AromaNode* aroma_textbox_create(AromaNode* parent, int x, int y, int width, int height)
 {
     if (!parent || width <= 0 || height <= 0) {
@@ -88,7 +238,7 @@ AromaNode* aroma_textbox_create(AromaNode* parent, int x, int y, int width, int
         return NULL;
     }
 
-    AromaTextbox* data = (AromaTextbox*)aroma_widget_alloc(sizeof(AromaTextbox));
+    AromaTextbox* data = (AromaTextbox*)aroma_widget_alloc_under(parent, sizeof(AromaTextbox));
     if (!data) {
         LOG_ERROR("Failed to allocate textbox data\n");
         return NULL;
@@ -98,13 +248,13 @@ AromaNode* aroma_textbox_create(AromaNode* parent, int x, int y, int width, int
     data->rect.y = y;
     data->rect.width = width;
     data->rect.height = height;
-    data->text[0] = '\0';
+    data->text = NULL;
+    data->text_capacity = 0;
     data->text_length = 0;
     data->cursor_pos = 0;
     data->is_focused = false;
     data->is_hovered = false;
     data->show_cursor = true;
-    data->cursor_blink_time = 0;
     AromaTheme theme = aroma_theme_get_global();
     data->hover_bg_color = aroma_color_blend(theme.colors.surface, theme.colors.primary_light, 0.08f);
     data->focused_bg_color = theme.colors.surface;
@@ -116,7 +266,7 @@ AromaNode* aroma_textbox_create(AromaNode* parent, int x, int y, int width, int
     data->placeholder_color = 0x999999;
     data->bg_color = theme.colors.surface;
 
-    data->placeholder[0] = '\0';
+    memset(&data->placeholder, 0, sizeof(data->placeholder));
     data->on_text_changed = NULL;
     data->on_focus_changed = NULL;
     data->user_data = NULL;
@@ -136,6 +286,7 @@ AromaNode* aroma_textbox_create(AromaNode* parent, int x, int y, int width, int
     }
 
     aroma_node_set_draw_cb(node, aroma_textbox_draw);
+    aroma_node_set_destroy_cb(node, __textbox_release);
 
     LOG_INFO("Textbox created: x=%d, y=%d, w=%d, h=%d\n", x, y, width, height);
     #ifdef ESP32
@@ -148,8 +299,7 @@ void aroma_textbox_set_placeholder(AromaNode* node, const char* placeholder)
 {
     if (!node || !node->node_widget_ptr || !placeholder) return;
     AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
-    strncpy(data->placeholder, placeholder, AROMA_TEXTBOX_MAX_LENGTH - 1);
-    data->placeholder[AROMA_TEXTBOX_MAX_LENGTH - 1] = '\0';
+    aroma_str_set(&data->placeholder, placeholder);
     aroma_node_invalidate(node);
     LOG_INFO("Textbox placeholder set: %s\n", placeholder);
 }
@@ -158,14 +308,17 @@ void aroma_textbox_set_text(AromaNode* node, const char* text)
 {
     if (!node || !node->node_widget_ptr || !text) return;
     AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
-    strncpy(data->text, text, AROMA_TEXTBOX_MAX_LENGTH - 1);
-    data->text[AROMA_TEXTBOX_MAX_LENGTH - 1] = '\0';
-    data->text_length = strlen(data->text);
+    size_t length = strnlen(text, AROMA_TEXTBOX_MAX_LENGTH - 1);
+    if (length > 0 && !__textbox_reserve(data, length)) return;
+    if (data->text) {
+        memmove(data->text, text, length);
+        data->text[length] = '\0';
+    }
+    data->text_length = length;
     data->cursor_pos = data->text_length;
-    data->show_cursor = true;
-    data->cursor_blink_time = __textbox_now_ms();
+    __textbox_restart_caret(node);
     if (data->on_text_changed) {
-        data->on_text_changed(node, data->text, data->user_data);
+        data->on_text_changed(node, data->text ? data->text : "", data->user_data);
     }
     aroma_node_invalidate(node);
     LOG_INFO("Textbox text set: %s\n", text);
@@ -175,7 +328,7 @@ const char* aroma_textbox_get_text(AromaNode* node)
 {
     if (!node || !node->node_widget_ptr) return "";
     AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
-    return data->text;
+    return data->text ? data->text : "";
 }
 
 void aroma_textbox_set_focused(AromaNode* node, bool focused)
@@ -184,13 +337,14 @@ void aroma_textbox_set_focused(AromaNode* node, bool focused)
     AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
     if (data->is_focused != focused) {
         data->is_focused = focused;
-        data->show_cursor = true;
-        data->cursor_blink_time = __textbox_now_ms();
         if (focused) {
             aroma_ui_set_focused_node(node);
+            __textbox_start_caret(node);
         } else {
             aroma_ui_clear_focused_node(node);
+            if (g_caret.node_id == node->node_id) __textbox_stop_caret();
         }
+        __textbox_restart_caret(node);
         aroma_node_invalidate(node);
         if (data->on_focus_changed) {
             data->on_focus_changed(node, focused, data->user_data);
@@ -218,8 +372,7 @@ void aroma_textbox_on_click(AromaNode* node, int mouse_x, int mouse_y)
         size_t desired_cursor = __textbox_cursor_from_click(data, gfx, window_id, mouse_x);
         if (desired_cursor > data->text_length) desired_cursor = data->text_length;
         data->cursor_pos = desired_cursor;
-        data->show_cursor = true;
-        data->cursor_blink_time = __textbox_now_ms();
+        __textbox_restart_caret(node);
         aroma_node_invalidate(node);
     } else {
         aroma_textbox_set_focused(node, false);
@@ -231,7 +384,7 @@ void aroma_textbox_on_char(AromaNode* node, char character)
     if (!node || !node->node_widget_ptr) return;
     AromaTextbox* data = (AromaTextbox*)node->node_widget_ptr;
     if (!data->is_focused) return;
-    if (data->text_length < AROMA_TEXTBOX_MAX_LENGTH - 1) {
+    if (__textbox_reserve(data, data->text_length + 1)) {
         memmove(&data->text[data->cursor_pos + 1],
                 &data->text[data->cursor_pos],
                 data->text_length - data->cursor_pos);
@@ -239,8 +392,7 @@ void aroma_textbox_on_char(AromaNode* node, char character)
         data->text_length++;
         data->cursor_pos++;
         data->text[data->text_length] = '\0';
-        data->show_cursor = true;
-        data->cursor_blink_time = __textbox_now_ms();
+        __textbox_restart_caret(node);
         if (data->on_text_changed) {
             data->on_text_changed(node, data->text, data->user_data);
         }
@@ -260,8 +412,7 @@ void aroma_textbox_on_backspace(AromaNode* node)
                 data->text_length - data->cursor_pos);
         data->text_length--;
         data->text[data->text_length] = '\0';
-        data->show_cursor = true;
-        data->cursor_blink_time = __textbox_now_ms();
+        __textbox_restart_caret(node);
         if (data->on_text_changed) {
             data->on_text_changed(node, data->text, data->user_data);
         }
@@ -341,7 +492,7 @@ void aroma_textbox_draw(AromaNode* node, size_t window_id)
         const char* text = data->text;
         uint32_t text_color = data->text_color;
         if (!text || text[0] == '\0') {
-            text = data->placeholder;
+            text = aroma_str_get(&data->placeholder);
             text_color = data->placeholder_color;
         }
 
@@ -375,18 +526,11 @@ void aroma_textbox_draw(AromaNode* node, size_t window_id)
     }
 
     if (data->is_focused) {
-        uint64_t now = __textbox_now_ms();
-        if (data->cursor_blink_time == 0) data->cursor_blink_time = now;
-        if (now != 0 && data->cursor_blink_time != 0 && now - data->cursor_blink_time >= AROMA_TEXTBOX_CURSOR_BLINK_RATE) {
-            data->cursor_blink_time = now;
-            data->show_cursor = !data->show_cursor;
-            aroma_node_invalidate(node);
-        }
-
+        /* Kept current even while hidden so a blink can damage just the caret. */
+        __textbox_update_cursor_position(data, gfx, window_id);
         if (data->show_cursor) {
-            __textbox_update_cursor_position(data, gfx, window_id);
-            gfx->fill_rectangle(window_id, data->cursor_x, data->cursor_y, 2, data->cursor_height,
-                                data->cursor_color, false, 0.0f);
+            gfx->fill_rectangle(window_id, data->cursor_x, data->cursor_y, AROMA_TEXTBOX_CURSOR_WIDTH,
+                                data->cursor_height, data->cursor_color, false, 0.0f);
         }
     }
 
@@ -397,6 +541,8 @@ void aroma_textbox_destroy(AromaNode* node)
 {
     if (!node) return;
     if (node->node_widget_ptr) {
+        if (g_caret.node_id == node->node_id) __textbox_stop_caret();
+        __textbox_release(node);
         aroma_widget_free(node->node_widget_ptr);
         node->node_widget_ptr = NULL;
     }
@@ -457,8 +603,7 @@ static bool __textbox_default_keyboard_handler(AromaEvent* event, void* user_dat
                 if (key_code == 0xFF51) {
                     if (textbox->cursor_pos > 0) {
                         textbox->cursor_pos--;
-                        textbox->show_cursor = true;
-                        textbox->cursor_blink_time = __textbox_now_ms();
+                        __textbox_restart_caret(event->target_node);
                         aroma_node_invalidate(event->target_node);
                         __textbox_request_redraw(user_data);
                     }
@@ -467,8 +612,7 @@ static bool __textbox_default_keyboard_handler(AromaEvent* event, void* user_dat
                 if (key_code == 0xFF53) {
                     if (textbox->cursor_pos < textbox->text_length) {
                         textbox->cursor_pos++;
-                        textbox->show_cursor = true;
-                        textbox->cursor_blink_time = __textbox_now_ms();
+                        __textbox_restart_caret(event->target_node);
                         aroma_node_invalidate(event->target_node);
                         __textbox_request_redraw(user_data);
                     }
@@ -476,16 +620,14 @@ static bool __textbox_default_keyboard_handler(AromaEvent* event, void* user_dat
                 }
                 if (key_code == 0xFF50) {
                     textbox->cursor_pos = 0;
-                    textbox->show_cursor = true;
-                    textbox->cursor_blink_time = __textbox_now_ms();
+                    __textbox_restart_caret(event->target_node);
                     aroma_node_invalidate(event->target_node);
                     __textbox_request_redraw(user_data);
                     return true;
                 }
                 if (key_code == 0xFF57) {
                     textbox->cursor_pos = textbox->text_length;
-                    textbox->show_cursor = true;
-                    textbox->cursor_blink_time = __textbox_now_ms();
+                    __textbox_restart_caret(event->target_node);
                     aroma_node_invalidate(event->target_node);
                     __textbox_request_redraw(user_data);
                     return true;
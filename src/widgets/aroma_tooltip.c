@@ -44,7 +44,7 @@ typedef struct AromaTooltip {
 AromaNode* aroma_tooltip_create(AromaNode* parent, const char* text, int x, int y, AromaTooltipPosition position)
 {
     if (!parent || !text) return NULL;
-    AromaTooltip* tip = (AromaTooltip*)aroma_widget_alloc(sizeof(AromaTooltip));
+    AromaTooltip* tip = (AromaTooltip*)aroma_widget_alloc_under(parent, sizeof(AromaTooltip));
     if (!tip) return NULL;
 
     memset(tip, 0, sizeof(AromaTooltip));
@@ -0,0 +1,192 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_alloc_profile.h"
+#include "aroma_alloc_profile.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_node.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#ifdef AROMA_ALLOC_PROFILE
+
+static int g_small_line = 0;
+static int g_big_line = 0;
+
+static void* alloc_small(void) {
+    g_small_line = __LINE__ + 1;
+    return aroma_widget_alloc(24);
+}
+
+static void* alloc_big(void) {
+    g_big_line = __LINE__ + 1;
+    return aroma_widget_alloc(3000);
+}
+
+static void init_test_environment(void) {
+    aroma_memory_system_init();
+    aroma_alloc_profile_reset();
+}
+
+static void cleanup_test_environment(void) {
+    aroma_memory_system_destroy();
+    aroma_alloc_profile_reset();
+}
+
+static void test_sites_sorted(void) {
+    init_test_environment();
+
+    void* small[10];
+    void* big[2];
+    for (int i = 0; i < 10; i++) small[i] = alloc_small();
+    for (int i = 0; i < 2; i++) big[i] = alloc_big();
+
+    AromaAllocSiteStats sites[4];
+    size_t count = aroma_alloc_profile_get_sites(sites, 4, AROMA_ALLOC_SORT_LIVE_BYTES);
+    assert(count == 2);
+    assert(sites[0].line == g_big_line && sites[0].live_bytes == 6000);
+    assert(strstr(sites[0].file, "test_aroma_alloc_profile.c") != NULL);
+    assert(sites[1].line == g_small_line && sites[1].live_count == 10);
+
+    count = aroma_alloc_profile_get_sites(sites, 4, AROMA_ALLOC_SORT_ALLOCS);
+    assert(count == 2);
+    assert(sites[0].line == g_small_line && sites[0].allocs == 10);
+
+    for (int i = 0; i < 2; i++) aroma_widget_free(big[i]);
+    for (int i = 0; i < 4; i++) aroma_widget_free(small[i]);
+    count = aroma_alloc_profile_get_sites(sites, 1, AROMA_ALLOC_SORT_LIVE_BYTES);
+    assert(count == 1);
+    assert(sites[0].line == g_small_line && sites[0].live_bytes == 6 * 24 && sites[0].frees == 4);
+
+    count = aroma_alloc_profile_get_sites(sites, 4, AROMA_ALLOC_SORT_TOTAL_BYTES);
+    assert(count == 2);
+    assert(sites[0].line == g_big_line && sites[0].live_bytes == 0 && sites[0].peak_live_bytes == 6000);
+
+    aroma_alloc_profile_report(AROMA_ALLOC_SORT_LIVE_BYTES, 8);
+    for (int i = 4; i < 10; i++) aroma_widget_free(small[i]);
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_node_types(void) {
+    __node_system_init();
+    aroma_alloc_profile_reset();
+
+    AromaNode* root = __create_node(NODE_TYPE_ROOT, NULL, NULL);
+    void* payload = aroma_widget_alloc(100);
+    AromaNode* child = __add_child_node(NODE_TYPE_WIDGET, root, payload);
+    void* loose = aroma_widget_alloc(40);
+    assert(root && child && loose);
+
+    assert(aroma_alloc_profile_get_type(NODE_TYPE_ROOT).live_count == 1);
+    AromaAllocTypeStats widget = aroma_alloc_profile_get_type(NODE_TYPE_WIDGET);
+    assert(widget.live_count == 2);
+    assert(widget.live_bytes == sizeof(AromaNode) + 100);
+    AromaAllocTypeStats untagged = aroma_alloc_profile_get_type(AROMA_ALLOC_PROFILE_UNTAGGED);
+    assert(untagged.live_count == 1 && untagged.live_bytes == 40);
+
+    __destroy_node(root);
+    aroma_widget_free(loose);
+    assert(aroma_alloc_profile_get_type(NODE_TYPE_WIDGET).live_bytes == 0);
+    assert(aroma_alloc_profile_get_type(NODE_TYPE_WIDGET).peak_live_bytes == sizeof(AromaNode) + 100);
+    assert(aroma_alloc_profile_get_type(NODE_TYPE_ROOT).live_count == 0);
+
+    __node_system_destroy();
+    aroma_alloc_profile_reset();
+    tests_passed++;
+}
+
+static void test_snapshot_diff(void) {
+    init_test_environment();
+
+    void* keep = alloc_small();
+    static AromaAllocSnapshot before, after;
+    aroma_alloc_profile_snapshot(&before);
+
+    void* leaked[5];
+    for (int i = 0; i < 5; i++) leaked[i] = alloc_big();
+    aroma_widget_free(keep);
+    aroma_alloc_profile_snapshot(&after);
+
+    AromaAllocSiteDelta deltas[4];
+    size_t changed = aroma_alloc_profile_diff(&before, &after, deltas, 4);
+    assert(changed == 2);
+    assert(deltas[0].line == g_big_line);
+    assert(deltas[0].live_count == 5 && deltas[0].live_bytes == 5 * 3000 && deltas[0].allocs == 5);
+    assert(deltas[1].line == g_small_line);
+    assert(deltas[1].live_count == -1 && deltas[1].live_bytes == -24 && deltas[1].frees == 1);
+    aroma_alloc_profile_report_diff(&before, &after);
+
+    /* Nothing changed: empty diff. */
+    changed = aroma_alloc_profile_diff(&after, &after, deltas, 4);
+    assert(changed == 0);
+
+    for (int i = 0; i < 5; i++) aroma_widget_free(leaked[i]);
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+#else
+
+static void test_profiler_compiled_out(void) {
+    int evaluated = 0;
+    AROMA_ALLOC_PROFILE_TAG((evaluated++, (void*)NULL), NODE_TYPE_WIDGET);
+    assert(evaluated == 0);
+    tests_passed++;
+}
+
+#endif
+
+void run_alloc_profile_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Allocation Profiler Tests ===\n");
+
+#ifdef AROMA_ALLOC_PROFILE
+    LOG_PERFORMANCE(NULL);
+    test_sites_sorted();
+    LOG_PERFORMANCE("test_sites_sorted");
+
+    LOG_PERFORMANCE(NULL);
+    test_node_types();
+    LOG_PERFORMANCE("test_node_types");
+
+    LOG_PERFORMANCE(NULL);
+    test_snapshot_diff();
+    LOG_PERFORMANCE("test_snapshot_diff");
+#else
+    LOG_PERFORMANCE(NULL);
+    test_profiler_compiled_out();
+    LOG_PERFORMANCE("test_profiler_compiled_out");
+#endif
+
+    printf("\nAllocation Profiler: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
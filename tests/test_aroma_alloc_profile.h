@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_ALLOC_PROFILE_H
+#define TEST_AROMA_ALLOC_PROFILE_H
+
+void run_alloc_profile_tests(int* passed, int* failed);
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_animation.h"
+#include "aroma_animation.h"
+#include "aroma_node.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+typedef struct {
+    int x;
+    float progress;
+    uint32_t color;
+} MockAnimatedWidget;
+
+static AromaNode* g_root = NULL;
+static AromaNode* g_child = NULL;
+static MockAnimatedWidget* g_widget = NULL;
+
+static void init_test_environment(void) {
+    __node_system_init();
+    aroma_animation_init();
+
+    g_root = __create_node(NODE_TYPE_ROOT, NULL, NULL);
+    g_widget = (MockAnimatedWidget*)aroma_widget_alloc(sizeof(MockAnimatedWidget));
+    memset(g_widget, 0, sizeof(MockAnimatedWidget));
+    g_child = __add_child_node(NODE_TYPE_WIDGET, g_root, g_widget);
+    assert(g_root && g_child);
+    aroma_dirty_list_clear();
+}
+
+static void cleanup_test_environment(void) {
+    __destroy_node_tree(g_root);
+    g_root = g_child = NULL;
+    g_widget = NULL;
+    aroma_animation_shutdown();
+    aroma_dirty_list_clear();
+    aroma_memory_system_destroy();
+    __node_system_destroy();
+}
+
+static void test_easing_endpoints(void) {
+    for (int e = AROMA_EASE_LINEAR; e <= AROMA_EASE_IN_OUT_CUBIC; e++) {
+        assert(aroma_easing_apply((AromaEasing)e, 0.0f) == 0.0f);
+        assert(aroma_easing_apply((AromaEasing)e, 1.0f) == 1.0f);
+        float mid = aroma_easing_apply((AromaEasing)e, 0.5f);
+        assert(mid > 0.0f && mid < 1.0f);
+    }
+    assert(aroma_easing_apply(AROMA_EASE_LINEAR, 0.25f) == 0.25f);
+    tests_passed++;
+}
+
+static void test_simulated_clock_progression(void) {
+    init_test_environment();
+
+    AromaRect damage = {10, 20, 40, 8};
+    AromaAnimation* anim = aroma_animate_int(g_child, damage, &g_widget->x, 100, 100, AROMA_EASE_LINEAR);
+    assert(anim != NULL);
+    assert(aroma_animation_is_running());
+
+    bool running = aroma_animation_tick(1000);
+    assert(running);
+    assert(g_widget->x == 0);
+
+    running = aroma_animation_tick(1050);
+    assert(running);
+    assert(g_widget->x == 50);
+
+    running = aroma_animation_tick(1100);
+    assert(!running);
+    assert(g_widget->x == 100);
+    assert(!aroma_animation_is_running());
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_damage_is_local(void) {
+    init_test_environment();
+
+    AromaRect damage = {10, 20, 40, 8};
+    aroma_animate_float(g_child, damage, &g_widget->progress, 1.0f, 100, AROMA_EASE_OUT_QUAD);
+    aroma_animation_tick(0);
+    aroma_animation_tick(40);
+
+    size_t dirty_count = 0;
+    AromaNode** dirty = aroma_dirty_list_get(&dirty_count);
+    assert(dirty_count == 1);
+    assert(dirty[0] == g_child);
+    assert(!aroma_node_is_dirty(g_root));
+
+    AromaRect region;
+    bool has_region = aroma_dirty_region_get(&region);
+    assert(has_region);
+    assert(region.x == 10 && region.y == 20 && region.width == 40 && region.height == 8);
+
+    aroma_node_invalidate(g_child);
+    has_region = aroma_dirty_region_get(&region);
+    assert(!has_region);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_settled_animation_stops_invalidating(void) {
+    init_test_environment();
+
+    AromaRect damage = {0, 0, 16, 16};
+    aroma_animate_color(g_child, damage, &g_widget->color, 0xFF00FF, 50, AROMA_EASE_LINEAR);
+    aroma_animation_tick(0);
+    aroma_animation_tick(50);
+    assert(g_widget->color == 0xFF00FF);
+
+    aroma_dirty_list_clear();
+    bool running = aroma_animation_tick(60);
+    assert(!running);
+    running = aroma_animation_tick(500);
+    assert(!running);
+
+    size_t dirty_count = 0;
+    aroma_dirty_list_get(&dirty_count);
+    assert(dirty_count == 0);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_retarget_and_cancel_on_destroy(void) {
+    init_test_environment();
+
+    AromaRect damage = {0, 0, 16, 16};
+    AromaAnimation* first = aroma_animate_int(g_child, damage, &g_widget->x, 100, 100, AROMA_EASE_LINEAR);
+    aroma_animation_tick(0);
+    aroma_animation_tick(50);
+    assert(g_widget->x == 50);
+
+    AromaAnimation* second = aroma_animate_int(g_child, damage, &g_widget->x, 0, 100, AROMA_EASE_LINEAR);
+    assert(second == first);
+    assert(aroma_animation_active_count() == 1);
+    aroma_animation_tick(100);
+    aroma_animation_tick(150);
+    assert(g_widget->x == 25);
+
+    __remove_child_node(g_root, g_child->node_id);
+    __destroy_node(g_child);
+    g_child = NULL;
+    assert(aroma_animation_active_count() == 0);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_zero_duration_applies_immediately(void) {
+    init_test_environment();
+
+    AromaRect damage = {0, 0, 16, 16};
+    AromaAnimation* anim = aroma_animate_int(g_child, damage, &g_widget->x, 42, 0, AROMA_EASE_LINEAR);
+    assert(anim == NULL);
+    assert(g_widget->x == 42);
+    assert(!aroma_animation_is_running());
+
+    size_t dirty_count = 0;
+    aroma_dirty_list_get(&dirty_count);
+    assert(dirty_count == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+void run_animation_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Animation Engine Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_easing_endpoints();
+    LOG_PERFORMANCE("test_easing_endpoints");
+
+    LOG_PERFORMANCE(NULL);
+    test_simulated_clock_progression();
+    LOG_PERFORMANCE("test_simulated_clock_progression");
+
+    LOG_PERFORMANCE(NULL);
+    test_damage_is_local();
+    LOG_PERFORMANCE("test_damage_is_local");
+
+    LOG_PERFORMANCE(NULL);
+    test_settled_animation_stops_invalidating();
+    LOG_PERFORMANCE("test_settled_animation_stops_invalidating");
+
+    LOG_PERFORMANCE(NULL);
+    test_retarget_and_cancel_on_destroy();
+    LOG_PERFORMANCE("test_retarget_and_cancel_on_destroy");
+
+    LOG_PERFORMANCE(NULL);
+    test_zero_duration_applies_immediately();
+    LOG_PERFORMANCE("test_zero_duration_applies_immediately");
+
+    printf("\nAnimation Engine: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_ANIMATION_H
+#define TEST_AROMA_ANIMATION_H
+
+void run_animation_tests(int* passed, int* failed);
+
+#endif
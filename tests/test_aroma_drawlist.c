@@ -0,0 +1,818 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_drawlist.h"
+#include "aroma_drawlist.h"
+#include "aroma_string.h"
+#include "aroma_logger.h"
+#include "backends/graphics/aroma_graphics_interface.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+/* Recording backend: remembers the last call of each kind and counts all calls. */
+typedef struct RecordedCall {
+    int x, y, width, height;
+    uint32_t color;
+    bool is_rounded;
+    float radius;
+    int border_width;
+    char text[64];
+} RecordedCall;
+
+static RecordedCall g_calls[32];
+static int g_types[32];
+static int g_batches;
+static int g_call_count;
+static int g_last_type;
+
+static void rec_clear(size_t window_id, uint32_t color) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){.color = color};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_CLEAR;
+    g_call_count++;
+}
+
+static void rec_fill(size_t window_id, int x, int y, int w, int h, uint32_t color, bool rounded, float radius) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){x, y, w, h, color, rounded, radius, 0, ""};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_FILL_RECT;
+    g_call_count++;
+}
+
+static void rec_hollow(size_t window_id, int x, int y, int w, int h, uint32_t color, int border,
+                       bool rounded, float radius) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){x, y, w, h, color, rounded, radius, border, ""};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_HOLLOW_RECT;
+    g_call_count++;
+}
+
+static void rec_arc(size_t window_id, int cx, int cy, int radius, float start, float end, uint32_t color,
+                    int thickness) {
+    (void)window_id; (void)start; (void)end;
+    g_calls[g_call_count & 31] = (RecordedCall){cx, cy, radius, radius, color, false, 0.0f, thickness, ""};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_ARC;
+    g_call_count++;
+}
+
+static void rec_text(size_t window_id, AromaFont* font, const char* text, int x, int y, uint32_t color,
+                     float scale) {
+    (void)window_id; (void)font; (void)scale;
+    RecordedCall call = {x, y, 0, 0, color, false, 0.0f, 0, ""};
+    snprintf(call.text, sizeof(call.text), "%s", text);
+    g_calls[g_call_count & 31] = call;
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_TEXT;
+    g_call_count++;
+}
+
+/* Fixed 10 px advance per character. */
+static float rec_measure(size_t window_id, AromaFont* font, const char* text, float scale) {
+    (void)window_id; (void)font;
+    return (float)strlen(text) * 10.0f * scale;
+}
+
+static void rec_image(size_t window_id, int x, int y, int w, int h, unsigned int texture_id) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){x, y, w, h, texture_id, false, 0.0f, 0, ""};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_IMAGE;
+    g_call_count++;
+}
+
+static void rec_rects(size_t window_id, const AromaRectBatchItem* rects, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const AromaRectBatchItem* r = &rects[i];
+        if (r->border_width > 0) {
+            rec_hollow(window_id, r->x, r->y, r->width, r->height, r->color, r->border_width, r->is_rounded,
+                       r->corner_radius);
+        } else {
+            rec_fill(window_id, r->x, r->y, r->width, r->height, r->color, r->is_rounded, r->corner_radius);
+        }
+    }
+    g_batches++;
+}
+
+/* Clips record as AROMA_DRAW_CMD_CLIP; lifting one records the text "off". */
+static void rec_set_clip(size_t window_id, int x, int y, int w, int h) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){x, y, w, h, 0, false, 0.0f, 0, ""};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_CLIP;
+    g_call_count++;
+}
+
+static void rec_clear_clip(size_t window_id) {
+    (void)window_id;
+    g_calls[g_call_count & 31] = (RecordedCall){0, 0, 0, 0, 0, false, 0.0f, 0, "off"};
+    g_types[g_call_count & 31] = g_last_type = AROMA_DRAW_CMD_CLIP;
+    g_call_count++;
+}
+
+static AromaGraphicsInterface g_recorder = {
+    .clear = rec_clear,
+    .fill_rectangle = rec_fill,
+    .draw_hollow_rectangle = rec_hollow,
+    .draw_rectangles = rec_rects,
+    .draw_arc = rec_arc,
+    .render_text = rec_text,
+    .measure_text = rec_measure,
+    .draw_image = rec_image,
+    .set_draw_clip = rec_set_clip,
+    .clear_draw_clip = rec_clear_clip,
+};
+
+static void recorder_reset(void) {
+    memset(g_calls, 0, sizeof(g_calls));
+    memset(g_types, 0, sizeof(g_types));
+    g_call_count = 0;
+    g_batches = 0;
+    g_last_type = -1;
+}
+
+static void test_replay_round_trips_commands(void) {
+    const char* long_text = "Transient text longer than an inline string";
+    AromaDrawList* list = aroma_drawlist_create();
+    AromaStr pooled;
+    memset(&pooled, 0, sizeof(pooled));
+    aroma_str_set(&pooled, "Interned label text for the pool");
+
+    aroma_drawlist_cmd_clear(list, 0x102030);
+    aroma_drawlist_cmd_fill_rect(list, -5, 10, 200, 40, 0xFF8040, true, 6.0f);
+    aroma_drawlist_cmd_hollow_rect(list, 1, 2, 3, 4, 0x000000, 2, false, 0.0f);
+    aroma_drawlist_cmd_arc(list, 50, 60, 12, 0.0f, 3.14f, 0x00FF00, 3);
+    aroma_drawlist_cmd_text(list, NULL, "OK", 7, 20, 0xFFFFFF, 1.0f);
+    aroma_drawlist_cmd_text(list, NULL, long_text, 7, 40, 0xFFFFFF, 1.0f);
+    aroma_drawlist_cmd_text_str(list, NULL, &pooled, 7, 60, 0xFFFFFF, 1.0f);
+    aroma_drawlist_cmd_image(list, 8, 9, 32, 32, 42);
+    aroma_str_release(&pooled);
+    assert(aroma_drawlist_get_stats(list).count == 8);
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 8);
+    assert(g_calls[0].color == 0x102030);
+    assert(g_calls[1].x == -5 && g_calls[1].width == 200 && g_calls[1].is_rounded && g_calls[1].radius == 6.0f);
+    assert(g_calls[1].color == 0xFF8040);
+    assert(g_calls[2].border_width == 2 && !g_calls[2].is_rounded);
+    assert(g_calls[3].x == 50 && g_calls[3].width == 12 && g_calls[3].border_width == 3);
+    assert(strcmp(g_calls[4].text, "OK") == 0);
+    assert(strcmp(g_calls[5].text, long_text) == 0);
+    assert(strcmp(g_calls[6].text, "Interned label text for the pool") == 0);
+    assert(g_calls[7].width == 32 && g_calls[7].color == 42);
+
+    /* Replay does not consume the list. */
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 16);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void test_commands_are_packed(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    size_t clear_bytes = aroma_drawlist_get_stats(list).bytes;
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 10, 10, 0x000000, false, 0.0f);
+    size_t rect_bytes = aroma_drawlist_get_stats(list).bytes - clear_bytes;
+    aroma_drawlist_cmd_text(list, NULL, "Hi", 0, 0, 0x000000, 1.0f);
+    size_t text_bytes = aroma_drawlist_get_stats(list).bytes - clear_bytes - rect_bytes;
+
+    /* Each command costs its own size, not that of the largest one. */
+    assert(clear_bytes > 0 && clear_bytes <= 8);
+    assert(rect_bytes > clear_bytes && rect_bytes <= 32);
+    assert(text_bytes > rect_bytes && text_bytes <= 48);
+    assert(aroma_drawlist_get_stats(list).bytes % sizeof(uint32_t) == 0);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void test_batching_merges_disjoint_rects(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    aroma_drawlist_set_batching(list, true);
+
+    /* Three cards, each a background, a border and a label. */
+    for (int i = 0; i < 3; i++) {
+        aroma_drawlist_cmd_fill_rect(list, 0, i * 50, 200, 40, 0xFFFFFF, true, 8.0f);
+        aroma_drawlist_cmd_hollow_rect(list, 0, i * 50, 200, 40, 0xCCCCCC, 1, true, 8.0f);
+        aroma_drawlist_cmd_text(list, NULL, "Card", 12, i * 50 + 24, 0x000000, 1.0f);
+    }
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 9);
+    /* All six rectangles go in one batch ahead of the labels. */
+    assert(g_batches == 1);
+    assert(aroma_drawlist_get_stats(list).flush_calls == 4);
+    for (int i = 0; i < 6; i++) {
+        assert(g_types[i] == AROMA_DRAW_CMD_FILL_RECT || g_types[i] == AROMA_DRAW_CMD_HOLLOW_RECT);
+    }
+    /* Each border still follows its own background. */
+    for (int i = 0; i < 6; i += 2) {
+        assert(g_types[i] == AROMA_DRAW_CMD_FILL_RECT && g_types[i + 1] == AROMA_DRAW_CMD_HOLLOW_RECT);
+        assert(g_calls[i].y == g_calls[i + 1].y);
+    }
+    for (int i = 6; i < 9; i++) assert(g_types[i] == AROMA_DRAW_CMD_TEXT);
+
+    aroma_drawlist_set_batching(list, false);
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_batches == 0 && aroma_drawlist_get_stats(list).flush_calls == 9);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void test_batching_keeps_overlapping_order(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    aroma_drawlist_set_batching(list, true);
+
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 200, 100, 0x111111, false, 0.0f);
+    aroma_drawlist_cmd_image(list, 10, 10, 32, 32, 7);
+    /* Covers the image, so it must not join the first rectangle. */
+    aroma_drawlist_cmd_fill_rect(list, 20, 20, 40, 40, 0x222222, false, 0.0f);
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    /* Nothing crosses a clear, even without overlap. */
+    aroma_drawlist_cmd_fill_rect(list, 500, 500, 10, 10, 0x333333, false, 0.0f);
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 5 && g_batches == 0);
+    assert(g_types[0] == AROMA_DRAW_CMD_FILL_RECT && g_calls[0].color == 0x111111);
+    assert(g_types[1] == AROMA_DRAW_CMD_IMAGE);
+    assert(g_types[2] == AROMA_DRAW_CMD_FILL_RECT && g_calls[2].color == 0x222222);
+    assert(g_types[3] == AROMA_DRAW_CMD_CLEAR);
+    assert(g_types[4] == AROMA_DRAW_CMD_FILL_RECT && g_calls[4].color == 0x333333);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static bool same_call(const RecordedCall* a, const RecordedCall* b) {
+    return a->x == b->x && a->y == b->y && a->width == b->width && a->height == b->height &&
+           a->color == b->color && a->is_rounded == b->is_rounded && a->radius == b->radius &&
+           a->border_width == b->border_width && strcmp(a->text, b->text) == 0;
+}
+
+static void test_tile_bins_match_linear_scan(void) {
+    enum { TILE = 100, SURFACE = 400, TILES = SURFACE / TILE };
+    AromaDrawList* list = aroma_drawlist_create();
+    RecordedCall calls[TILES][32];
+    int types[TILES][32];
+    int counts[TILES];
+
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    aroma_drawlist_cmd_fill_rect(list, 0, -20, 320, 40, 0x111111, false, 0.0f);
+    aroma_drawlist_cmd_hollow_rect(list, 10, 90, 50, 30, 0x222222, 1, false, 0.0f);
+    aroma_drawlist_cmd_fill_rect(list, 10, 100, 50, 100, 0x333333, false, 0.0f);
+    aroma_drawlist_cmd_arc(list, 160, 150, 20, 0.0f, 3.14f, 0x444444, 2);
+    aroma_drawlist_cmd_text(list, NULL, "Straddles", 8, 104, 0x000000, 1.0f);
+    aroma_drawlist_cmd_text(list, NULL, "Touches", 8, 214, 0x000000, 1.0f);
+    aroma_drawlist_cmd_image(list, 200, 150, 64, 140, 7);
+    for (int i = 0; i < 12; i++) {
+        aroma_drawlist_cmd_fill_rect(list, i * 20, 20 + i * 4, 16, 16, 0x555555, false, 0.0f);
+    }
+
+    for (int t = 0; t < TILES; t++) {
+        recorder_reset();
+        aroma_drawlist_replay_region(list, 0, &g_recorder, 0, t * TILE, 320, TILE);
+        counts[t] = g_call_count;
+        memcpy(calls[t], g_calls, sizeof(g_calls));
+        memcpy(types[t], g_types, sizeof(g_types));
+    }
+
+    bool binned = aroma_drawlist_bin_tiles(list, TILE, SURFACE);
+    assert(binned);
+    for (int t = 0; t < TILES; t++) {
+        recorder_reset();
+        aroma_drawlist_replay_region(list, 0, &g_recorder, 0, t * TILE, 320, TILE);
+        assert(g_call_count == counts[t]);
+        for (int i = 0; i < counts[t]; i++) {
+            assert(g_types[i] == types[t][i] && same_call(&g_calls[i], &calls[t][i]));
+        }
+    }
+    assert(counts[0] > 0 && counts[3] == 0);
+
+    /* Recording after binning falls back to the full scan. */
+    aroma_drawlist_cmd_fill_rect(list, 0, 350, 10, 10, 0x666666, false, 0.0f);
+    recorder_reset();
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 0, 3 * TILE, 320, TILE);
+    assert(g_call_count == 1 && g_calls[0].y == 350);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void test_text_bounds_cull_by_measured_width(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    AromaGraphicsInterface unmeasured = g_recorder;
+    unmeasured.measure_text = NULL;
+
+    aroma_drawlist_set_text_measure(list, &g_recorder, 0);
+    aroma_drawlist_cmd_text(list, NULL, "Right", 300, 40, 0x000000, 1.0f);
+    aroma_drawlist_cmd_text(list, NULL, "Scaled", 0, 140, 0x000000, 2.0f);
+
+    recorder_reset();
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 0, 0, 200, 100);
+    assert(g_call_count == 0);
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 290, 0, 100, 100);
+    assert(g_call_count == 1 && strcmp(g_calls[0].text, "Right") == 0);
+
+    /* 6 characters at twice the scale reach x = 120 but no further. */
+    recorder_reset();
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 115, 100, 50, 100);
+    assert(g_call_count == 1 && strcmp(g_calls[0].text, "Scaled") == 0);
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 125, 100, 50, 100);
+    assert(g_call_count == 1);
+
+    /* Without a measurement the text claims the rest of its row. */
+    aroma_drawlist_set_text_measure(list, &unmeasured, 0);
+    aroma_drawlist_cmd_text(list, NULL, "Unknown", 0, 240, 0x000000, 1.0f);
+    recorder_reset();
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 2000, 200, 100, 100);
+    assert(g_call_count == 1 && strcmp(g_calls[0].text, "Unknown") == 0);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static unsigned int offset_texture(const AromaDrawCaptureTexture* texture, void* user_data) {
+    (void)user_data;
+    assert(texture->uses == 1 && texture->width == 64);
+    return texture->texture_id + 100;
+}
+
+static void test_capture_round_trips(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    AromaStr pooled;
+    memset(&pooled, 0, sizeof(pooled));
+    aroma_str_set(&pooled, "Interned label text for the pool");
+
+    aroma_drawlist_cmd_clear(list, 0x102030);
+    aroma_drawlist_cmd_fill_rect(list, -5, 10, 200, 40, 0xFF8040, true, 6.0f);
+    aroma_drawlist_cmd_hollow_rect(list, 1, 2, 3, 4, 0x000000, 2, false, 0.0f);
+    aroma_drawlist_cmd_arc(list, 50, 60, 12, 0.0f, 3.14f, 0x00FF00, 3);
+    aroma_drawlist_cmd_text(list, NULL, "Transient text longer than an inline string", 7, 8, 0x0000FF, 1.5f);
+    aroma_drawlist_cmd_text_str(list, NULL, &pooled, 9, 10, 0x111111, 1.0f);
+    aroma_drawlist_cmd_image(list, 0, 0, 64, 32, 7);
+    aroma_drawlist_cmd_image(list, 64, 0, 64, 64, 9);
+
+    size_t size = aroma_drawlist_serialize(list, 320, 240, NULL, 0);
+    uint8_t* bytes = malloc(size + 8);
+    assert(bytes);
+    size_t written = aroma_drawlist_serialize(list, 320, 240, bytes, size);
+    assert(written == size);
+
+    AromaDrawCaptureOptions options = { NULL, offset_texture, NULL, &g_recorder, 0 };
+    AromaDrawCaptureInfo info;
+    AromaDrawList* loaded = aroma_drawlist_deserialize(bytes, size, &options, &info);
+    assert(loaded);
+    assert(info.version == AROMA_DRAWLIST_CAPTURE_VERSION && info.surface_width == 320 && info.surface_height == 240);
+    assert(info.command_count == 8 && info.font_count == 0 && info.texture_count == 2);
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    RecordedCall expected[8];
+    memcpy(expected, g_calls, sizeof(expected));
+    recorder_reset();
+    aroma_drawlist_replay(loaded, 0, &g_recorder);
+    assert(g_call_count == 8);
+    for (int i = 0; i < 6; i++) {
+        assert(same_call(&g_calls[i], &expected[i]));
+    }
+    assert(g_calls[6].color == 107 && g_calls[7].color == 109);
+
+    /* Loaded text is measured with the given interface: nothing reaches x = 700. */
+    recorder_reset();
+    aroma_drawlist_replay_region(loaded, 0, &g_recorder, 700, 0, 100, 40);
+    for (int i = 0; i < g_call_count; i++) assert(g_types[i] != AROMA_DRAW_CMD_TEXT);
+    aroma_drawlist_destroy(loaded);
+
+    /* Unknown command types from newer writers are skipped. */
+    const uint8_t unknown[8] = { 0xEE, 0, 4, 0, 1, 2, 3, 4 };
+    memcpy(bytes + size, unknown, sizeof(unknown));
+    bytes[16]++;
+    loaded = aroma_drawlist_deserialize(bytes, size + sizeof(unknown), NULL, NULL);
+    assert(loaded && aroma_drawlist_get_stats(loaded).count == 8);
+    aroma_drawlist_destroy(loaded);
+    bytes[16]--;
+
+    /* Truncated and newer captures are refused. */
+    assert(aroma_drawlist_deserialize(bytes, size - 1, NULL, NULL) == NULL);
+    bytes[4] = AROMA_DRAWLIST_CAPTURE_VERSION + 1;
+    assert(aroma_drawlist_deserialize(bytes, size, NULL, NULL) == NULL);
+
+    free(bytes);
+    aroma_str_release(&pooled);
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+typedef struct ParallelScene {
+    int items;
+    AromaStr labels[4];
+    bool worker_seen[AROMA_DRAWLIST_MAX_RECORD_THREADS];
+} ParallelScene;
+
+static void record_scene_items(ParallelScene* scene, AromaDrawList* list, int begin, int end) {
+    char caption[80];
+    for (int i = begin; i < end; i++) {
+        aroma_drawlist_cmd_fill_rect(list, (i % 16) * 20, (i / 16) * 20, 18, 18, 0x100000 + (uint32_t)i,
+                                     i % 3 == 0, 4.0f);
+        snprintf(caption, sizeof(caption), "Row %d caption, long enough for the arena", i);
+        aroma_drawlist_cmd_text(list, NULL, caption, (i % 16) * 20, (i / 16) * 20, 0x000000, 1.0f);
+        aroma_drawlist_cmd_text_str(list, NULL, &scene->labels[i % 4], 0, i, 0x222222, 1.0f);
+    }
+}
+
+static void record_scene_chunk(uint32_t chunk, uint32_t chunk_count, void* user_data) {
+    ParallelScene* scene = user_data;
+    scene->worker_seen[chunk] = aroma_drawlist_is_worker();
+    record_scene_items(scene, aroma_drawlist_get_active(), scene->items * (int)chunk / (int)chunk_count,
+                       scene->items * (int)(chunk + 1) / (int)chunk_count);
+}
+
+static void test_parallel_recording_matches_sequential(void) {
+    ParallelScene scene;
+    memset(&scene, 0, sizeof(scene));
+    scene.items = 200;
+    for (int i = 0; i < 4; i++) {
+        char label[48];
+        snprintf(label, sizeof(label), "Interned dashboard label number %d", i);
+        aroma_str_set(&scene.labels[i], label);
+    }
+
+    AromaDrawList* sequential = aroma_drawlist_create();
+    aroma_drawlist_cmd_clear(sequential, 0xFFFFFF);
+    record_scene_items(&scene, sequential, 0, scene.items);
+
+    bool started = aroma_drawlist_set_record_threads(4);
+    assert(started);
+    assert(aroma_drawlist_get_record_threads() == 4);
+    AromaDrawList* parallel = aroma_drawlist_create();
+    for (int frame = 0; frame < 3; frame++) {
+        aroma_drawlist_reset(parallel);
+        aroma_drawlist_cmd_clear(parallel, 0xFFFFFF);
+        aroma_drawlist_record_parallel(parallel, 0, 4, record_scene_chunk, &scene);
+        assert(!aroma_drawlist_is_active());
+        assert(aroma_drawlist_get_hash(parallel) == aroma_drawlist_get_hash(sequential));
+        assert(aroma_drawlist_get_stats(parallel).count == aroma_drawlist_get_stats(sequential).count);
+    }
+    assert(!scene.worker_seen[0] && scene.worker_seen[1] && scene.worker_seen[3]);
+
+    /* Worker lists are reset after the append; the copies own their text. */
+    recorder_reset();
+    aroma_drawlist_replay(parallel, 0, &g_recorder);
+    assert(g_call_count == 1 + scene.items * 3);
+    assert(strcmp(g_calls[(g_call_count - 1) & 31].text, "Interned dashboard label number 3") == 0);
+    assert(strcmp(g_calls[(g_call_count - 2) & 31].text, "Row 199 caption, long enough for the arena") == 0);
+
+    started = aroma_drawlist_set_record_threads(1);
+    assert(started);
+    aroma_drawlist_destroy(parallel);
+    aroma_drawlist_destroy(sequential);
+    for (int i = 0; i < 4; i++) aroma_str_release(&scene.labels[i]);
+    tests_passed++;
+}
+
+static void test_occlusion_drops_covered_commands(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    aroma_drawlist_set_text_measure(list, &g_recorder, 0);
+    AromaStr label = {0};
+    aroma_str_set(&label, "An interned label that is pinned by the list");
+
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    aroma_drawlist_cmd_clear(list, 0xEEEEEE);
+    aroma_drawlist_cmd_fill_rect(list, -1, -1, 322, 242, 0xFAFAFA, false, 0.0f);   /* card */
+    aroma_drawlist_cmd_fill_rect(list, 20, 20, 80, 30, 0x6200EE, true, 8.0f);      /* button */
+    aroma_drawlist_cmd_text_str(list, NULL, &label, 24, 24, 0xFFFFFF, 1.0f);
+    aroma_drawlist_cmd_fill_rect(list, -1, -1, 322, 242, 0x444444, false, 0.0f);   /* scrim */
+    aroma_drawlist_cmd_fill_rect(list, 42, 42, 6, 6, 0xFF0000, false, 0.0f);       /* under a corner */
+    aroma_drawlist_cmd_fill_rect(list, 100, 80, 20, 20, 0x00FF00, false, 0.0f);   /* under the middle */
+    aroma_drawlist_cmd_fill_rect(list, 40, 40, 200, 120, 0xFFFFFF, true, 12.0f);   /* dialog */
+    aroma_drawlist_cmd_text(list, NULL, "OK", 60, 60, 0x000000, 1.0f);
+    uint64_t hash = aroma_drawlist_get_hash(list);
+
+    /* Fills hide a clear only when they overshoot the blended edge pixels. */
+    size_t culled = aroma_drawlist_cull_occluded(list, 320, 240);
+    assert(culled == 6);
+    AromaDrawListStats stats = aroma_drawlist_get_stats(list);
+    assert(stats.count == 4 && stats.occluded == 6);
+    assert(stats.occluded_pixels >= 3u * 320u * 240u + 80u * 30u + 20u * 20u);
+    assert(stats.painted_pixels >= 320u * 240u + 200u * 120u);
+    assert(aroma_drawlist_get_hash(list) == hash);
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 4);
+    assert(g_types[0] == AROMA_DRAW_CMD_FILL_RECT && g_calls[0].color == 0x444444);
+    assert(g_calls[1].x == 42 && g_calls[1].color == 0xFF0000);
+    assert(g_calls[2].is_rounded && g_calls[2].width == 200);
+    assert(g_types[3] == AROMA_DRAW_CMD_TEXT && strcmp(g_calls[3].text, "OK") == 0);
+    culled = aroma_drawlist_cull_occluded(list, 320, 240);
+    assert(culled == 0);
+
+    /* Without a surface size fills never hide a clear, but a later clear does. */
+    aroma_drawlist_reset(list);
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    aroma_drawlist_cmd_fill_rect(list, 10, 10, 50, 50, 0x123456, false, 0.0f);
+    aroma_drawlist_cmd_clear(list, 0xEEEEEE);
+    aroma_drawlist_cmd_fill_rect(list, -1, -1, 322, 242, 0xFAFAFA, false, 0.0f);
+    culled = aroma_drawlist_cull_occluded(list, 0, 0);
+    assert(culled == 2);
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 2 && g_types[0] == AROMA_DRAW_CMD_CLEAR && g_calls[0].color == 0xEEEEEE);
+
+    aroma_drawlist_destroy(list);
+    aroma_str_release(&label);
+    tests_passed++;
+}
+
+static bool is_clip_call(int index, int x, int y, int width, int height) {
+    const RecordedCall* call = &g_calls[index];
+    return g_types[index] == AROMA_DRAW_CMD_CLIP && call->text[0] == '\0' && call->x == x && call->y == y &&
+           call->width == width && call->height == height;
+}
+
+static bool is_clip_off_call(int index) {
+    return g_types[index] == AROMA_DRAW_CMD_CLIP && strcmp(g_calls[index].text, "off") == 0;
+}
+
+static void record_clipped_row(AromaDrawList* list, uint32_t first, uint32_t last) {
+    for (uint32_t i = first; i < last; i++) {
+        aroma_drawlist_cmd_fill_rect(list, (int)i * 20, 0, 18, 18, 0x100000 + i, false, 0.0f);
+    }
+}
+
+static void record_clipped_chunk(uint32_t chunk, uint32_t chunk_count, void* user_data) {
+    (void)user_data;
+    record_clipped_row(aroma_drawlist_get_active(), chunk * 8 / chunk_count, (chunk + 1) * 8 / chunk_count);
+}
+
+static void test_clip_stack_culls_and_replays(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+    aroma_drawlist_set_text_measure(list, &g_recorder, 0);
+
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 100, 100, 0x111111, false, 0.0f);
+    aroma_drawlist_cmd_push_clip(list, 10, 10, 50, 50);
+    aroma_drawlist_cmd_fill_rect(list, 20, 20, 10, 10, 0x222222, false, 0.0f);
+    aroma_drawlist_cmd_fill_rect(list, 200, 200, 10, 10, 0x333333, false, 0.0f);    /* outside */
+    aroma_drawlist_cmd_push_clip(list, 40, 40, 100, 100);
+    int x, y, width, height;
+    bool clipped = aroma_drawlist_get_clip(list, &x, &y, &width, &height);
+    assert(clipped);
+    assert(x == 40 && y == 40 && width == 20 && height == 20);
+    aroma_drawlist_cmd_text(list, NULL, "in", 45, 58, 0x000000, 1.0f);
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 30, 30, 0x444444, false, 0.0f);        /* outside the inner clip */
+    aroma_drawlist_cmd_pop_clip(list);
+    aroma_drawlist_cmd_pop_clip(list);
+    aroma_drawlist_cmd_fill_rect(list, 5, 5, 5, 5, 0x555555, false, 0.0f);
+    /* A push whose contents all miss records nothing at all. */
+    aroma_drawlist_cmd_push_clip(list, 300, 300, 10, 10);
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 5, 5, 0x666666, false, 0.0f);
+    aroma_drawlist_cmd_pop_clip(list);
+    clipped = aroma_drawlist_get_clip(list, NULL, NULL, NULL, NULL);
+    assert(!clipped);
+
+    AromaDrawListStats stats = aroma_drawlist_get_stats(list);
+    assert(stats.clipped == 3 && stats.count == 7);
+
+    recorder_reset();
+    aroma_drawlist_replay(list, 0, &g_recorder);
+    assert(g_call_count == 8);
+    assert(g_types[0] == AROMA_DRAW_CMD_FILL_RECT && g_calls[0].color == 0x111111);
+    assert(is_clip_call(1, 10, 10, 50, 50));
+    assert(g_calls[2].color == 0x222222);
+    assert(is_clip_call(3, 40, 40, 20, 20));
+    assert(g_types[4] == AROMA_DRAW_CMD_TEXT && strcmp(g_calls[4].text, "in") == 0);
+    assert(is_clip_off_call(5));
+    assert(g_calls[6].color == 0x555555);
+    assert(is_clip_off_call(7));
+
+    /* A tile replays every clip command to know the clip of its draws. */
+    bool binned = aroma_drawlist_bin_tiles(list, 16, 100);
+    assert(binned);
+    recorder_reset();
+    aroma_drawlist_replay_region(list, 0, &g_recorder, 0, 48, 100, 16);
+    assert(g_call_count == 6);
+    assert(g_calls[0].color == 0x111111 && is_clip_call(1, 10, 10, 50, 50) && is_clip_call(2, 40, 40, 20, 20));
+    assert(g_types[3] == AROMA_DRAW_CMD_TEXT && is_clip_off_call(4) && is_clip_off_call(5));
+
+    /* Captures carry the absolute clips. */
+    size_t size = aroma_drawlist_serialize(list, 100, 100, NULL, 0);
+    void* bytes = malloc(size);
+    assert(bytes);
+    size_t written = aroma_drawlist_serialize(list, 100, 100, bytes, size);
+    assert(written == size);
+    AromaDrawList* loaded = aroma_drawlist_deserialize(bytes, size, NULL, NULL);
+    free(bytes);
+    assert(loaded && aroma_drawlist_get_stats(loaded).count == 7);
+    recorder_reset();
+    aroma_drawlist_replay(loaded, 0, &g_recorder);
+    assert(g_call_count == 8 && is_clip_call(3, 40, 40, 20, 20) && is_clip_off_call(5));
+    aroma_drawlist_destroy(loaded);
+
+    /* Parallel chunks start under the caller's clip, as sequential ones do. */
+    AromaDrawList* sequential = aroma_drawlist_create();
+    aroma_drawlist_cmd_push_clip(sequential, 30, 0, 100, 20);
+    record_clipped_row(sequential, 0, 8);
+    aroma_drawlist_reset(list);
+    aroma_drawlist_cmd_push_clip(list, 30, 0, 100, 20);
+    bool started = aroma_drawlist_set_record_threads(4);
+    assert(started);
+    aroma_drawlist_record_parallel(list, 0, 4, record_clipped_chunk, NULL);
+    started = aroma_drawlist_set_record_threads(1);
+    assert(started);
+    assert(aroma_drawlist_get_stats(list).count == 7 && aroma_drawlist_get_stats(list).clipped == 2);
+    assert(aroma_drawlist_get_hash(list) == aroma_drawlist_get_hash(sequential));
+
+    aroma_drawlist_destroy(sequential);
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void record_hash_frame(AromaDrawList* list, const char* title, uint32_t accent) {
+    char caption[64];
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    aroma_drawlist_cmd_fill_rect(list, 0, 0, 320, 48, accent, false, 0.0f);
+    /* Built fresh each frame, so its bytes land at a new arena address. */
+    snprintf(caption, sizeof(caption), "%s - a caption long enough for the arena", title);
+    aroma_drawlist_cmd_text(list, NULL, caption, 8, 30, 0x000000, 1.0f);
+    aroma_drawlist_cmd_text(list, NULL, title, 8, 60, 0x000000, 1.0f);
+}
+
+static void test_hash_tracks_content(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+
+    uint64_t empty = aroma_drawlist_get_hash(list);
+    record_hash_frame(list, "Inbox", 0x2196F3);
+    uint64_t first = aroma_drawlist_get_hash(list);
+    assert(first != empty);
+
+    aroma_drawlist_reset(list);
+    assert(aroma_drawlist_get_hash(list) == empty);
+    record_hash_frame(list, "Inbox", 0x2196F3);
+    assert(aroma_drawlist_get_hash(list) == first);
+
+    aroma_drawlist_reset(list);
+    record_hash_frame(list, "Inbox", 0x2196F4);
+    assert(aroma_drawlist_get_hash(list) != first);
+
+    aroma_drawlist_reset(list);
+    record_hash_frame(list, "Inbix", 0x2196F3);
+    assert(aroma_drawlist_get_hash(list) != first);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static double elapsed_seconds(const struct timespec* start, const struct timespec* end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/* A settings-style screen: card backgrounds, borders, icons and labels. */
+static void record_screen(AromaDrawList* list, AromaStr* labels) {
+    aroma_drawlist_cmd_clear(list, 0xF5F5F5);
+    for (int i = 0; i < 48; i++) {
+        int y = i * 40;
+        aroma_drawlist_cmd_fill_rect(list, 8, y, 464, 36, 0xFFFFFF, true, 8.0f);
+        aroma_drawlist_cmd_hollow_rect(list, 8, y, 464, 36, 0xDDDDDD, 1, true, 8.0f);
+        aroma_drawlist_cmd_image(list, 16, y + 6, 24, 24, (unsigned int)i);
+        aroma_drawlist_cmd_text_str(list, NULL, &labels[i & 3], 48, y + 24, 0x202020, 1.0f);
+        if ((i & 3) == 0) aroma_drawlist_cmd_arc(list, 440, y + 18, 8, 0.0f, 6.28f, 0x2196F3, 2);
+    }
+}
+
+static void test_record_flush_benchmark(void) {
+    static const char* names[4] = {"Wi-Fi", "Bluetooth and nearby devices", "Display", "Notifications and sounds"};
+    AromaStr labels[4];
+    memset(labels, 0, sizeof(labels));
+    for (int i = 0; i < 4; i++) aroma_str_set(&labels[i], names[i]);
+
+    AromaDrawList* list = aroma_drawlist_create();
+    const int frames = 2000;
+    double record_time = 0.0, flush_time = 0.0;
+    struct timespec start, mid, end;
+    record_screen(list, labels);
+    aroma_drawlist_reset(list);
+    size_t warm_allocs = aroma_drawlist_get_stats(list).heap_allocs;
+    for (int frame = 0; frame < frames; frame++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        record_screen(list, labels);
+        clock_gettime(CLOCK_MONOTONIC, &mid);
+        aroma_drawlist_replay(list, 0, &g_recorder);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        record_time += elapsed_seconds(&start, &mid);
+        flush_time += elapsed_seconds(&mid, &end);
+        if (frame + 1 < frames) aroma_drawlist_reset(list);
+    }
+
+    AromaDrawListStats stats = aroma_drawlist_get_stats(list);
+    printf("  %zu commands, %.1f bytes/command: record %.1f ns/cmd, flush %.1f ns/cmd\n",
+           stats.count, (double)stats.bytes / (double)stats.count,
+           record_time * 1e9 / ((double)frames * stats.count), flush_time * 1e9 / ((double)frames * stats.count));
+    assert(stats.count == 1 + 48 * 4 + 12);
+    /* Steady-state frames never grow the stream. */
+    assert(stats.heap_allocs == warm_allocs);
+
+    aroma_drawlist_set_batching(list, true);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int frame = 0; frame < frames; frame++) aroma_drawlist_replay(list, 0, &g_recorder);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    size_t batched_calls = aroma_drawlist_get_stats(list).flush_calls;
+    printf("  batched flush %.1f ns/cmd, %zu backend calls instead of %zu\n",
+           elapsed_seconds(&start, &end) * 1e9 / ((double)frames * stats.count), batched_calls, stats.count);
+    /* The 96 card rectangles collapse into a couple of calls; the look-back
+       window bounds how far a rectangle can travel to join its batch. */
+    assert(batched_calls <= stats.count - 48 * 2 + 2);
+
+    aroma_drawlist_destroy(list);
+    for (int i = 0; i < 4; i++) aroma_str_release(&labels[i]);
+    tests_passed++;
+}
+
+void run_drawlist_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Draw List Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_replay_round_trips_commands();
+    LOG_PERFORMANCE("test_replay_round_trips_commands");
+
+    LOG_PERFORMANCE(NULL);
+    test_commands_are_packed();
+    LOG_PERFORMANCE("test_commands_are_packed");
+
+    LOG_PERFORMANCE(NULL);
+    test_batching_merges_disjoint_rects();
+    LOG_PERFORMANCE("test_batching_merges_disjoint_rects");
+
+    LOG_PERFORMANCE(NULL);
+    test_batching_keeps_overlapping_order();
+    LOG_PERFORMANCE("test_batching_keeps_overlapping_order");
+
+    LOG_PERFORMANCE(NULL);
+    test_tile_bins_match_linear_scan();
+    LOG_PERFORMANCE("test_tile_bins_match_linear_scan");
+
+    LOG_PERFORMANCE(NULL);
+    test_text_bounds_cull_by_measured_width();
+    LOG_PERFORMANCE("test_text_bounds_cull_by_measured_width");
+
+    LOG_PERFORMANCE(NULL);
+    test_capture_round_trips();
+    LOG_PERFORMANCE("test_capture_round_trips");
+
+    LOG_PERFORMANCE(NULL);
+    test_parallel_recording_matches_sequential();
+    LOG_PERFORMANCE("test_parallel_recording_matches_sequential");
+
+    LOG_PERFORMANCE(NULL);
+    test_occlusion_drops_covered_commands();
+    LOG_PERFORMANCE("test_occlusion_drops_covered_commands");
+
+    LOG_PERFORMANCE(NULL);
+    test_clip_stack_culls_and_replays();
+    LOG_PERFORMANCE("test_clip_stack_culls_and_replays");
+
+    LOG_PERFORMANCE(NULL);
+    test_hash_tracks_content();
+    LOG_PERFORMANCE("test_hash_tracks_content");
+
+    LOG_PERFORMANCE(NULL);
+    test_record_flush_benchmark();
+    LOG_PERFORMANCE("test_record_flush_benchmark");
+
+    printf("\nDraw List: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_DRAWLIST_H
+#define TEST_AROMA_DRAWLIST_H
+
+void run_drawlist_tests(int* passed, int* failed);
+
+#endif
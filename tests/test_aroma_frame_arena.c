@@ -0,0 +1,165 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_frame_arena.h"
+#include "aroma_frame_arena.h"
+#include "aroma_drawlist.h"
+#include "aroma_string.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+static void test_alloc_alignment_and_reset(void) {
+    AromaFrameArena* arena = aroma_frame_arena_create();
+    assert(arena);
+
+    void* a = aroma_frame_arena_alloc(arena, 3);
+    void* b = aroma_frame_arena_alloc(arena, 40);
+    assert(a && b && a != b);
+    assert(((uintptr_t)a % AROMA_FRAME_ARENA_ALIGNMENT) == 0);
+    assert(((uintptr_t)b % AROMA_FRAME_ARENA_ALIGNMENT) == 0);
+
+    char* text = aroma_frame_arena_strdup(arena, "Settings");
+    assert(text && strcmp(text, "Settings") == 0);
+
+    aroma_frame_arena_reset(arena);
+    AromaFrameArenaStats stats = aroma_frame_arena_get_stats(arena);
+    assert(stats.used == 0);
+    assert(stats.chunk_allocs == 1);
+    void* reused = aroma_frame_arena_alloc(arena, 3);
+    assert(reused == a);
+
+    /* Larger than a chunk: gets a dedicated chunk that is kept for reuse. */
+    void* big = aroma_frame_arena_alloc(arena, AROMA_FRAME_ARENA_CHUNK_SIZE * 2);
+    assert(big);
+    assert(aroma_frame_arena_get_stats(arena).chunk_allocs == 2);
+    aroma_frame_arena_reset(arena);
+    big = aroma_frame_arena_alloc(arena, AROMA_FRAME_ARENA_CHUNK_SIZE * 2);
+    assert(big);
+    assert(aroma_frame_arena_get_stats(arena).chunk_allocs == 2);
+
+    aroma_frame_arena_destroy(arena);
+    tests_passed++;
+}
+
+static void test_mark_rewind(void) {
+    AromaFrameArena* arena = aroma_frame_arena_create();
+
+    aroma_frame_arena_alloc(arena, 64);
+    AromaFrameArenaMark mark = aroma_frame_arena_mark(arena);
+    size_t used = aroma_frame_arena_get_stats(arena).used;
+
+    char* scratch = aroma_frame_arena_strndup(arena, "Hello, world", 5);
+    assert(scratch && strcmp(scratch, "Hello") == 0);
+    for (int i = 0; i < 100; i++) aroma_frame_arena_alloc(arena, 512);
+    assert(aroma_frame_arena_get_stats(arena).chunk_allocs > 1);
+
+    aroma_frame_arena_rewind(arena, mark);
+    assert(aroma_frame_arena_get_stats(arena).used == used);
+    char* again = aroma_frame_arena_strndup(arena, "Hello", 5);
+    assert(again == scratch);
+
+    aroma_frame_arena_destroy(arena);
+    tests_passed++;
+}
+
+static void record_frame(AromaDrawList* list, int frame) {
+    char label[32];
+    aroma_drawlist_cmd_clear(list, 0xFFFFFF);
+    for (int i = 0; i < 96; i++) {
+        aroma_drawlist_cmd_fill_rect(list, i * 4, i * 2, 80, 24, 0x336699, (i & 1) != 0, 4.0f);
+        aroma_drawlist_cmd_hollow_rect(list, i * 4, i * 2, 80, 24, 0x000000, 1, false, 0.0f);
+        snprintf(label, sizeof(label), "Item %d / frame %d", i, frame % 10);
+        aroma_drawlist_cmd_text(list, NULL, label, i * 4 + 8, i * 2 + 16, 0x000000, 1.0f);
+    }
+    aroma_drawlist_cmd_arc(list, 100, 100, 20, 0.0f, 3.14f, 0xFF0000, 2);
+    aroma_drawlist_cmd_image(list, 0, 0, 32, 32, 1);
+}
+
+static void test_list_without_arena_owns_text_bytes(void) {
+    AromaDrawList* list = aroma_drawlist_create();
+
+    record_frame(list, 0);
+    aroma_drawlist_reset(list);
+    size_t warm = aroma_drawlist_get_stats(list).heap_allocs;
+    for (int frame = 1; frame < 8; frame++) {
+        record_frame(list, frame);
+        aroma_drawlist_reset(list);
+    }
+    assert(aroma_drawlist_get_stats(list).heap_allocs == warm);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+static void test_text_str_pins_interned_text(void) {
+    const char* long_text = "A label long enough to be interned";
+    AromaDrawList* list = aroma_drawlist_create();
+    AromaStr text;
+    memset(&text, 0, sizeof(text));
+    aroma_str_set(&text, long_text);
+    size_t entries = aroma_string_pool_get_stats().entries;
+
+    aroma_drawlist_cmd_text_str(list, NULL, &text, 0, 0, 0x000000, 1.0f);
+    /* The widget drops its text mid-frame; the recorded command keeps it alive. */
+    aroma_str_release(&text);
+    assert(aroma_string_pool_get_stats().entries == entries);
+
+    aroma_drawlist_reset(list);
+    assert(aroma_string_pool_get_stats().entries == entries - 1);
+
+    aroma_drawlist_destroy(list);
+    tests_passed++;
+}
+
+void run_frame_arena_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Frame Arena Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_alloc_alignment_and_reset();
+    LOG_PERFORMANCE("test_alloc_alignment_and_reset");
+
+    LOG_PERFORMANCE(NULL);
+    test_mark_rewind();
+    LOG_PERFORMANCE("test_mark_rewind");
+
+    LOG_PERFORMANCE(NULL);
+    test_list_without_arena_owns_text_bytes();
+    LOG_PERFORMANCE("test_list_without_arena_owns_text_bytes");
+
+    LOG_PERFORMANCE(NULL);
+    test_text_str_pins_interned_text();
+    LOG_PERFORMANCE("test_text_str_pins_interned_text");
+
+    printf("\nFrame Arena: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_FRAME_ARENA_H
+#define TEST_AROMA_FRAME_ARENA_H
+
+void run_frame_arena_tests(int* passed, int* failed);
+
+#endif
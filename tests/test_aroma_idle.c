@@ -0,0 +1,221 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_idle.h"
+#include "aroma_idle.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+static uint64_t g_fake_now = 0;
+
+static uint64_t fake_clock(void) {
+    return g_fake_now;
+}
+
+typedef struct {
+    int runs;
+    int steps_left;
+    uint32_t cost_ms;
+    uint32_t last_remaining;
+    bool last_forced;
+} MockIdleJob;
+
+static AromaIdleResult mock_job(void* ctx, const AromaIdleDeadline* deadline) {
+    MockIdleJob* job = (MockIdleJob*)ctx;
+    job->runs++;
+    job->last_remaining = aroma_idle_time_remaining(deadline);
+    job->last_forced = deadline->forced;
+    g_fake_now += job->cost_ms;
+    if (--job->steps_left > 0) return AROMA_IDLE_YIELD;
+    return AROMA_IDLE_DONE;
+}
+
+static void init_test_environment(void) {
+    aroma_idle_init();
+    aroma_idle_set_clock(fake_clock);
+    g_fake_now = 1000;
+}
+
+static void cleanup_test_environment(void) {
+    aroma_idle_shutdown();
+}
+
+static void test_runs_within_budget(void) {
+    init_test_environment();
+
+    MockIdleJob a = { .steps_left = 1, .cost_ms = 4 };
+    MockIdleJob b = { .steps_left = 1, .cost_ms = 4 };
+    MockIdleJob c = { .steps_left = 1, .cost_ms = 4 };
+    bool posted = aroma_idle_post(mock_job, &a);
+    assert(posted);
+    posted = aroma_idle_post(mock_job, &b);
+    assert(posted);
+    posted = aroma_idle_post(mock_job, &c);
+    assert(posted);
+
+    size_t ran = aroma_idle_run(1008);
+    assert(ran == 2);
+    assert(a.runs == 1 && b.runs == 1 && c.runs == 0);
+    assert(a.last_remaining == 8);
+    assert(aroma_idle_pending() == 1);
+
+    AromaIdleStats stats = aroma_idle_get_stats();
+    assert(stats.posted == 3);
+    assert(stats.completed == 2);
+    assert(stats.deferred == 1);
+    assert(stats.pending == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_yield_resumes_later(void) {
+    init_test_environment();
+
+    MockIdleJob job = { .steps_left = 3, .cost_ms = 1 };
+    aroma_idle_post(mock_job, &job);
+
+    size_t ran = aroma_idle_run(g_fake_now + 16);
+    assert(ran == 1);
+    assert(aroma_idle_pending() == 1);
+    ran = aroma_idle_run(g_fake_now + 16);
+    assert(ran == 1);
+    ran = aroma_idle_run(g_fake_now + 16);
+    assert(ran == 1);
+    assert(aroma_idle_pending() == 0);
+    assert(job.runs == 3);
+
+    AromaIdleStats stats = aroma_idle_get_stats();
+    assert(stats.yielded == 2);
+    assert(stats.completed == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_starved_task_is_forced(void) {
+    init_test_environment();
+
+    MockIdleJob job = { .steps_left = 1, .cost_ms = 0 };
+    aroma_idle_post(mock_job, &job);
+
+    for (int i = 0; i < AROMA_IDLE_STARVATION_RUNS; i++) {
+        size_t ran = aroma_idle_run(g_fake_now);
+        assert(ran == 0);
+    }
+    AromaIdleStats stats = aroma_idle_get_stats();
+    assert(stats.starved == 1);
+    assert(stats.deferred == AROMA_IDLE_STARVATION_RUNS);
+
+    size_t ran = aroma_idle_run(g_fake_now);
+    assert(ran == 1);
+    assert(job.runs == 1);
+    assert(job.last_forced);
+    assert(job.last_remaining == 0);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_queue_full(void) {
+    init_test_environment();
+
+    MockIdleJob job = { .steps_left = 1 };
+    for (int i = 0; i < AROMA_MAX_IDLE_TASKS; i++) {
+        bool posted = aroma_idle_post(mock_job, &job);
+        assert(posted);
+    }
+    bool posted = aroma_idle_post(mock_job, &job);
+    assert(!posted);
+    posted = aroma_idle_post(NULL, NULL);
+    assert(!posted);
+    assert(aroma_idle_get_stats().dropped == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static MockIdleJob g_filler_job = { .steps_left = 1 };
+
+/* Floods the queue from inside its own slice, then asks to run again. */
+static AromaIdleResult flooding_job(void* ctx, const AromaIdleDeadline* deadline) {
+    (void)deadline;
+    int* accepted = (int*)ctx;
+    while (aroma_idle_post(mock_job, &g_filler_job)) (*accepted)++;
+    return AROMA_IDLE_YIELD;
+}
+
+static void test_yielded_task_keeps_its_slot(void) {
+    init_test_environment();
+
+    int accepted = 0;
+    bool posted = aroma_idle_post(flooding_job, &accepted);
+    assert(posted);
+    size_t ran = aroma_idle_run(g_fake_now + 16);
+    assert(ran == 1);
+
+    /* The running task's slot stays reserved, so the flood stops one short. */
+    assert(accepted == AROMA_MAX_IDLE_TASKS - 1);
+    assert(aroma_idle_pending() == AROMA_MAX_IDLE_TASKS);
+    AromaIdleStats stats = aroma_idle_get_stats();
+    assert(stats.yielded == 1);
+    assert(stats.dropped == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+void run_idle_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Idle Scheduler Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_runs_within_budget();
+    LOG_PERFORMANCE("test_runs_within_budget");
+
+    LOG_PERFORMANCE(NULL);
+    test_yield_resumes_later();
+    LOG_PERFORMANCE("test_yield_resumes_later");
+
+    LOG_PERFORMANCE(NULL);
+    test_starved_task_is_forced();
+    LOG_PERFORMANCE("test_starved_task_is_forced");
+
+    LOG_PERFORMANCE(NULL);
+    test_queue_full();
+    LOG_PERFORMANCE("test_queue_full");
+
+    LOG_PERFORMANCE(NULL);
+    test_yielded_task_keeps_its_slot();
+    LOG_PERFORMANCE("test_yielded_task_keeps_its_slot");
+
+    printf("\nIdle Scheduler: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
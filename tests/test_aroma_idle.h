@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_IDLE_H
+#define TEST_AROMA_IDLE_H
+
+void run_idle_tests(int* passed, int* failed);
+
+#endif
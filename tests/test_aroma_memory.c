@@ -0,0 +1,154 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_memory.h"
+#include "aroma_memory.h"
+#include "aroma_drawlist.h"
+#include "aroma_frame_arena.h"
+#include "aroma_string.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+static void test_report_tracks_subsystems(void) {
+    aroma_memory_system_init();
+    AromaMemoryReport before = aroma_memory_report();
+
+    AromaDrawList* list = aroma_drawlist_create();
+    aroma_drawlist_cmd_text(list, NULL, "Heap-copied text", 0, 0, 0, 1.0f);
+    AromaFrameArena* arena = aroma_frame_arena_create();
+    void* scratch = aroma_frame_arena_alloc(arena, 64);
+    assert(scratch);
+    AromaStr str = {0};
+    aroma_str_set(&str, "a long enough string to be interned");
+    void* widget = aroma_widget_alloc(5000);
+    assert(widget);
+
+    AromaMemoryReport report = aroma_memory_report();
+    assert(report.subsystems[AROMA_MEMORY_DRAWLIST].cpu_bytes > before.subsystems[AROMA_MEMORY_DRAWLIST].cpu_bytes);
+    assert(report.subsystems[AROMA_MEMORY_FRAME_ARENA].cpu_bytes >=
+           before.subsystems[AROMA_MEMORY_FRAME_ARENA].cpu_bytes + AROMA_FRAME_ARENA_CHUNK_SIZE);
+    assert(report.subsystems[AROMA_MEMORY_STRINGS].cpu_bytes > before.subsystems[AROMA_MEMORY_STRINGS].cpu_bytes);
+    assert(report.subsystems[AROMA_MEMORY_SLAB].cpu_bytes >= before.subsystems[AROMA_MEMORY_SLAB].cpu_bytes + 5000);
+    assert(report.total_cpu_bytes > before.total_cpu_bytes);
+
+    aroma_widget_free(widget);
+    aroma_str_release(&str);
+    aroma_frame_arena_destroy(arena);
+    aroma_drawlist_destroy(list);
+
+    report = aroma_memory_report();
+    for (int i = AROMA_MEMORY_DRAWLIST; i <= AROMA_MEMORY_STRINGS; i++) {
+        assert(report.subsystems[i].cpu_bytes == before.subsystems[i].cpu_bytes);
+        assert(report.subsystems[i].peak_cpu_bytes > report.subsystems[i].cpu_bytes);
+    }
+    assert(report.subsystems[AROMA_MEMORY_SLAB].cpu_bytes == before.subsystems[AROMA_MEMORY_SLAB].cpu_bytes);
+
+    aroma_memory_system_destroy();
+    tests_passed++;
+}
+
+typedef struct {
+    int calls;
+    AromaMemorySubsystem subsystem;
+    AromaMemoryDomain domain;
+    size_t usage;
+} BudgetHits;
+
+static void __on_budget(AromaMemorySubsystem subsystem, AromaMemoryDomain domain,
+                        size_t usage, size_t budget, void* user_data) {
+    BudgetHits* hits = (BudgetHits*)user_data;
+    assert(usage > budget);
+    hits->calls++;
+    hits->subsystem = subsystem;
+    hits->domain = domain;
+    hits->usage = usage;
+}
+
+static void test_budget_callback_fires_once_per_crossing(void) {
+    BudgetHits hits = {0};
+    aroma_memory_set_budget_callback(__on_budget, &hits);
+
+    size_t base = aroma_memory_report().subsystems[AROMA_MEMORY_TEXTURES].gpu_bytes;
+    aroma_memory_set_budget(AROMA_MEMORY_TEXTURES, AROMA_MEMORY_DOMAIN_GPU, base + 1000);
+
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, 800);
+    assert(hits.calls == 0);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, 400);
+    assert(hits.calls == 1);
+    assert(hits.subsystem == AROMA_MEMORY_TEXTURES && hits.domain == AROMA_MEMORY_DOMAIN_GPU);
+    assert(hits.usage == base + 1200);
+
+    /* Still over: no repeat until usage drops back under the budget. */
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, 100);
+    size_t over = aroma_memory_check_budgets();
+    assert(over == 1);
+    assert(hits.calls == 1);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, -1300);
+    over = aroma_memory_check_budgets();
+    assert(over == 0);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, 1500);
+    assert(hits.calls == 2);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, -1500);
+
+    /* The total budget spans subsystems and domains independently. */
+    aroma_memory_set_budget(AROMA_MEMORY_TEXTURES, AROMA_MEMORY_DOMAIN_GPU, 0);
+    size_t total = aroma_memory_report().total_gpu_bytes;
+    aroma_memory_set_budget(AROMA_MEMORY_TOTAL, AROMA_MEMORY_DOMAIN_GPU, total + 100);
+    aroma_memory_track(AROMA_MEMORY_GLYPHS, 0, 60);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, 60);
+    assert(hits.calls == 3);
+    assert(hits.subsystem == (AromaMemorySubsystem)AROMA_MEMORY_TOTAL);
+    aroma_memory_track(AROMA_MEMORY_GLYPHS, 0, -60);
+    aroma_memory_track(AROMA_MEMORY_TEXTURES, 0, -60);
+
+    aroma_memory_set_budget(AROMA_MEMORY_TOTAL, AROMA_MEMORY_DOMAIN_GPU, 0);
+    aroma_memory_set_budget_callback(NULL, NULL);
+    over = aroma_memory_check_budgets();
+    assert(over == 0);
+    tests_passed++;
+}
+
+void run_memory_report_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Memory Report Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_report_tracks_subsystems();
+    LOG_PERFORMANCE("test_report_tracks_subsystems");
+
+    LOG_PERFORMANCE(NULL);
+    test_budget_callback_fires_once_per_crossing();
+    LOG_PERFORMANCE("test_budget_callback_fires_once_per_crossing");
+
+    printf("\nMemory Report: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_MEMORY_H
+#define TEST_AROMA_MEMORY_H
+
+void run_memory_report_tests(int* passed, int* failed);
+
+#endif
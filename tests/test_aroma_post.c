@@ -0,0 +1,203 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_post.h"
+#include "aroma_post.h"
+#include "aroma_node.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#define POST_PRODUCER_THREADS 4
+#define POST_UPDATES_PER_THREAD 10000
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+static AromaNode* g_test_root = NULL;
+static int g_text_applies = 0;
+static int g_float_applies = 0;
+static char g_last_text[AROMA_POST_TEXT_MAX];
+static float g_last_float = 0.0f;
+
+static void apply_text(AromaNode* node, const AromaPostValue* value) {
+    (void)node;
+    g_text_applies++;
+    strcpy(g_last_text, value->text);
+}
+
+static void apply_float(AromaNode* node, const AromaPostValue* value) {
+    (void)node;
+    g_float_applies++;
+    g_last_float = value->f;
+}
+
+static AromaNode* resolve_test_node(uint64_t node_id) {
+    return __find_node_by_id(g_test_root, node_id);
+}
+
+static void init_test_environment(void) {
+    __node_system_init();
+    aroma_post_init();
+    g_test_root = __create_node(NODE_TYPE_ROOT, NULL, aroma_widget_alloc(32));
+    g_text_applies = 0;
+    g_float_applies = 0;
+    g_last_text[0] = '\0';
+    g_last_float = 0.0f;
+}
+
+static void cleanup_test_environment(void) {
+    aroma_post_shutdown();
+    __node_system_destroy();
+    g_test_root = NULL;
+}
+
+static void test_updates_coalesce_per_property(void) {
+    init_test_environment();
+
+    char text[32];
+    for (int i = 0; i < 100; i++) {
+        snprintf(text, sizeof(text), "reading %d", i);
+        bool posted = aroma_post_text(g_test_root->node_id, apply_text, text);
+        assert(posted);
+        posted = aroma_post_float(g_test_root->node_id, apply_float, (float)i / 100.0f);
+        assert(posted);
+    }
+    assert(aroma_post_pending() == 2);
+
+    size_t applied = aroma_post_flush(resolve_test_node);
+    assert(applied == 2);
+    assert(g_text_applies == 1 && g_float_applies == 1);
+    assert(strcmp(g_last_text, "reading 99") == 0);
+    assert(g_last_float == 0.99f);
+    assert(aroma_post_pending() == 0);
+
+    AromaPostStats stats = aroma_post_get_stats();
+    assert(stats.posted == 200);
+    assert(stats.coalesced == 198);
+    assert(stats.applied == 2);
+
+    applied = aroma_post_flush(resolve_test_node);
+    assert(applied == 0);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_stale_and_full_queue(void) {
+    init_test_environment();
+
+    /* A child destroyed before its producer posts only leaves an id behind. */
+    AromaNode* child = __add_child_node(NODE_TYPE_WIDGET, g_test_root, aroma_widget_alloc(32));
+    uint64_t child_id = child->node_id;
+    __remove_child_node(g_test_root, child_id);
+    __destroy_node(child);
+
+    bool posted = aroma_post_float(child_id, apply_float, 0.5f);
+    assert(posted);
+    size_t applied = aroma_post_flush(resolve_test_node);
+    assert(applied == 0);
+    assert(aroma_post_get_stats().stale == 1);
+    posted = aroma_post_float(AROMA_NODE_ID_INVALID, apply_float, 0.5f);
+    assert(!posted);
+
+    uint64_t first_id = g_test_root->node_id + 1000;
+    for (int i = 0; i < AROMA_MAX_POSTED_UPDATES; i++) {
+        posted = aroma_post_float(first_id + i, apply_float, 1.0f);
+        assert(posted);
+    }
+    posted = aroma_post_float(first_id + AROMA_MAX_POSTED_UPDATES, apply_float, 1.0f);
+    assert(!posted);
+    posted = aroma_post_float(first_id, apply_float, 0.25f);
+    assert(posted);
+    assert(aroma_post_get_stats().dropped == 1);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void* producer_thread(void* arg) {
+    uint64_t node_id = *(const uint64_t*)arg;
+    for (int i = 1; i <= POST_UPDATES_PER_THREAD; i++) {
+        aroma_post_float(node_id, apply_float, (float)i);
+    }
+    return NULL;
+}
+
+static void test_concurrent_producers(void) {
+    init_test_environment();
+
+    pthread_t threads[POST_PRODUCER_THREADS];
+    uint64_t node_id = g_test_root->node_id;
+    for (int i = 0; i < POST_PRODUCER_THREADS; i++) {
+        pthread_create(&threads[i], NULL, producer_thread, &node_id);
+    }
+
+    const uint64_t total = (uint64_t)POST_PRODUCER_THREADS * POST_UPDATES_PER_THREAD;
+    int frames = 0;
+    while (aroma_post_get_stats().posted < total) {
+        aroma_post_flush(resolve_test_node);
+        frames++;
+    }
+    for (int i = 0; i < POST_PRODUCER_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    aroma_post_flush(resolve_test_node);
+    frames++;
+
+    AromaPostStats stats = aroma_post_get_stats();
+    assert(stats.posted == total);
+    assert(stats.applied == stats.posted - stats.coalesced);
+    assert(g_float_applies <= frames);
+    assert(stats.dropped == 0);
+    assert(g_last_float == (float)POST_UPDATES_PER_THREAD);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+void run_post_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Post Queue Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_updates_coalesce_per_property();
+    LOG_PERFORMANCE("test_updates_coalesce_per_property");
+
+    LOG_PERFORMANCE(NULL);
+    test_stale_and_full_queue();
+    LOG_PERFORMANCE("test_stale_and_full_queue");
+
+    LOG_PERFORMANCE(NULL);
+    test_concurrent_producers();
+    LOG_PERFORMANCE("test_concurrent_producers");
+
+    printf("\nPost Queue: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
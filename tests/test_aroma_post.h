@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_POST_H
+#define TEST_AROMA_POST_H
+
+void run_post_tests(int* passed, int* failed);
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_string.h"
+#include "aroma_string.h"
+#include "aroma_node.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define STRING_CHURN_THREADS 4
+#define STRING_CHURN_ROUNDS 20000
+
+static void test_small_strings_stay_inline(void) {
+    AromaStringPoolStats before = aroma_string_pool_get_stats();
+    AromaStr ok = {0};
+    AromaStr full = {0};
+
+    assert(sizeof(AromaStr) == 16);
+    assert(strcmp(aroma_str_get(&ok), "") == 0);
+
+    aroma_str_set(&ok, "OK");
+    aroma_str_set(&full, "exactly fifteen");
+    assert(!aroma_str_is_interned(&ok));
+    assert(!aroma_str_is_interned(&full));
+    assert(aroma_str_equals(&ok, "OK"));
+    assert(aroma_str_length(&full) == AROMA_STR_INLINE_CAPACITY);
+    assert(aroma_str_equals(&full, "exactly fifteen"));
+    assert(aroma_string_pool_get_stats().entries == before.entries);
+
+    aroma_str_release(&ok);
+    aroma_str_release(&full);
+    assert(aroma_str_length(&ok) == 0);
+    tests_passed++;
+}
+
+static void test_long_strings_are_shared(void) {
+    const char* path = "/usr/share/aroma/icons/settings.png";
+    AromaStringPoolStats before = aroma_string_pool_get_stats();
+    AromaStr a = {0}, b = {0}, c = {0};
+
+    aroma_str_set(&a, path);
+    aroma_str_set(&b, path);
+    aroma_str_copy(&c, &a);
+    assert(aroma_str_is_interned(&a));
+    assert(aroma_str_get(&a) == aroma_str_get(&b));
+    assert(aroma_str_get(&a) == aroma_str_get(&c));
+
+    AromaStringPoolStats stats = aroma_string_pool_get_stats();
+    assert(stats.entries == before.entries + 1);
+    assert(stats.references == before.references + 3);
+    assert(stats.shared_bytes_saved == before.shared_bytes_saved + 2 * (strlen(path) + 1));
+
+    aroma_str_release(&a);
+    aroma_str_release(&b);
+    assert(aroma_str_equals(&c, path));
+    aroma_str_release(&c);
+
+    stats = aroma_string_pool_get_stats();
+    assert(stats.entries == before.entries);
+    assert(stats.references == before.references);
+    assert(stats.bytes == before.bytes);
+    tests_passed++;
+}
+
+static void test_set_from_own_text(void) {
+    AromaStringPoolStats before = aroma_string_pool_get_stats();
+    AromaStr str = {0};
+
+    aroma_str_set(&str, "a string long enough to be interned");
+    aroma_str_set(&str, aroma_str_get(&str));
+    assert(aroma_str_equals(&str, "a string long enough to be interned"));
+    aroma_str_set(&str, aroma_str_get(&str) + 24);
+    assert(aroma_str_equals(&str, "be interned"));
+    assert(!aroma_str_is_interned(&str));
+    aroma_str_copy(&str, &str);
+
+    aroma_str_release(&str);
+    assert(aroma_string_pool_get_stats().entries == before.entries);
+    tests_passed++;
+}
+
+typedef struct {
+    AromaStr title;
+} TestStringWidget;
+
+static int destroy_calls = 0;
+
+static void __test_widget_release(AromaNode* node) {
+    TestStringWidget* widget = (TestStringWidget*)node->node_widget_ptr;
+    aroma_str_release(&widget->title);
+    destroy_calls++;
+}
+
+static void test_tree_teardown_releases_widget_strings(void) {
+    aroma_memory_system_init();
+    __node_system_init();
+    AromaStringPoolStats before = aroma_string_pool_get_stats();
+
+    AromaNode* root = __create_node(NODE_TYPE_ROOT, NULL, NULL);
+    for (int i = 0; i < 3; i++) {
+        TestStringWidget* widget = (TestStringWidget*)aroma_widget_alloc(sizeof(TestStringWidget));
+        assert(widget);
+        memset(widget, 0, sizeof(*widget));
+        aroma_str_set(&widget->title, "Notification settings");
+        AromaNode* node = __add_child_node(NODE_TYPE_WIDGET, root, widget);
+        assert(node);
+        aroma_node_set_destroy_cb(node, __test_widget_release);
+    }
+    assert(aroma_string_pool_get_stats().entries == before.entries + 1);
+
+    destroy_calls = 0;
+    __destroy_node_tree(root);
+    assert(destroy_calls == 3);
+    assert(aroma_string_pool_get_stats().entries == before.entries);
+
+    __node_system_destroy();
+    aroma_memory_system_destroy();
+    tests_passed++;
+}
+
+/* Every thread keeps taking and dropping the last reference to the same
+   text, so lookups keep meeting entries that are being released. */
+static void* churn_shared_string(void* arg) {
+    (void)arg;
+    AromaStr str = {0};
+    for (int i = 0; i < STRING_CHURN_ROUNDS; i++) {
+        aroma_str_set(&str, "a label shared by every churning thread");
+        assert(aroma_str_equals(&str, "a label shared by every churning thread"));
+        aroma_str_release(&str);
+    }
+    return NULL;
+}
+
+static void test_concurrent_last_release(void) {
+    AromaStringPoolStats before = aroma_string_pool_get_stats();
+    pthread_t threads[STRING_CHURN_THREADS];
+    for (int i = 0; i < STRING_CHURN_THREADS; i++) {
+        int rc = pthread_create(&threads[i], NULL, churn_shared_string, NULL);
+        assert(rc == 0);
+    }
+    for (int i = 0; i < STRING_CHURN_THREADS; i++)
+        pthread_join(threads[i], NULL);
+
+    AromaStringPoolStats stats = aroma_string_pool_get_stats();
+    assert(stats.entries == before.entries);
+    assert(stats.bytes == before.bytes);
+    tests_passed++;
+}
+
+void run_string_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== String Pool Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_small_strings_stay_inline();
+    LOG_PERFORMANCE("test_small_strings_stay_inline");
+
+    LOG_PERFORMANCE(NULL);
+    test_long_strings_are_shared();
+    LOG_PERFORMANCE("test_long_strings_are_shared");
+
+    LOG_PERFORMANCE(NULL);
+    test_set_from_own_text();
+    LOG_PERFORMANCE("test_set_from_own_text");
+
+    LOG_PERFORMANCE(NULL);
+    test_tree_teardown_releases_widget_strings();
+    LOG_PERFORMANCE("test_tree_teardown_releases_widget_strings");
+
+    LOG_PERFORMANCE(NULL);
+    test_concurrent_last_release();
+    LOG_PERFORMANCE("test_concurrent_last_release");
+
+    printf("\nString Pool: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_STRING_H
+#define TEST_AROMA_STRING_H
+
+void run_string_tests(int* passed, int* failed);
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_task.h"
+#include "aroma_task.h"
+#include "aroma_idle.h"
+#include "aroma_node.h"
+#include "aroma_slab_alloc.h"
+#include "aroma_logger.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+typedef struct {
+    int step;
+    int frames;
+    uint64_t node_id;
+    AromaEventType woke_on;
+    AromaAsset* asset;
+    size_t asset_size;
+    bool done;
+} MockFlow;
+
+static void mark_done(AromaTask* task, void* ctx) {
+    (void)task;
+    ((MockFlow*)ctx)->done = true;
+}
+
+static AromaTaskStatus sleep_flow(AromaTask* task, void* ctx) {
+    MockFlow* flow = (MockFlow*)ctx;
+    AROMA_TASK_BEGIN(task);
+    flow->step = 1;
+    AROMA_TASK_SLEEP_MS(task, 100);
+    flow->step = 2;
+    for (flow->frames = 0; flow->frames < 3; flow->frames++) {
+        AROMA_TASK_NEXT_FRAME(task);
+    }
+    flow->step = 3;
+    AROMA_TASK_END(task);
+}
+
+static AromaTaskStatus event_flow(AromaTask* task, void* ctx) {
+    MockFlow* flow = (MockFlow*)ctx;
+    AROMA_TASK_BEGIN(task);
+    AROMA_TASK_AWAIT_EVENT(task, flow->node_id, EVENT_TYPE_MOUSE_CLICK);
+    flow->woke_on = task->event.event_type;
+    flow->step = 1;
+    AROMA_TASK_END(task);
+}
+
+static AromaTaskStatus asset_flow(AromaTask* task, void* ctx) {
+    MockFlow* flow = (MockFlow*)ctx;
+    AROMA_TASK_BEGIN(task);
+    AROMA_TASK_AWAIT_ASSET(task, flow->asset);
+    aroma_asset_data(flow->asset, &flow->asset_size);
+    flow->step = aroma_asset_state(flow->asset) == AROMA_ASSET_READY ? 1 : -1;
+    AROMA_TASK_END(task);
+}
+
+static void init_test_environment(void) {
+    __node_system_init();
+    aroma_event_system_init();
+    aroma_idle_init();
+    aroma_asset_init();
+    aroma_task_init();
+}
+
+static void cleanup_test_environment(void) {
+    aroma_task_shutdown();
+    aroma_asset_shutdown();
+    aroma_idle_shutdown();
+    aroma_event_system_shutdown();
+    __node_system_destroy();
+}
+
+static void test_sleep_and_frames(void) {
+    init_test_environment();
+
+    MockFlow flow = {0};
+    AromaTask* task = aroma_task_spawn(sleep_flow, &flow);
+    assert(task != NULL);
+    aroma_task_set_on_done(task, mark_done);
+    assert(flow.step == 0);
+
+    aroma_task_tick(1000);
+    assert(flow.step == 1);
+    uint64_t wake = 0;
+    assert(aroma_task_next_deadline(&wake) && wake == 1100);
+
+    aroma_task_tick(1050);
+    assert(flow.step == 1);
+    aroma_task_tick(1100);
+    assert(flow.step == 2 && flow.frames == 0);
+
+    aroma_task_tick(1116);
+    aroma_task_tick(1132);
+    assert(flow.frames == 2 && !flow.done);
+    aroma_task_tick(1148);
+    assert(flow.step == 3 && flow.done);
+    assert(!aroma_task_is_active(task));
+    assert(aroma_task_active_count() == 0);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_wait_for_event(void) {
+    init_test_environment();
+
+    AromaNode* root = __create_node(NODE_TYPE_ROOT, NULL, aroma_widget_alloc(32));
+    aroma_event_set_root(root);
+    MockFlow flow = { .node_id = root->node_id };
+    aroma_task_spawn(event_flow, &flow);
+
+    aroma_task_tick(0);
+    aroma_task_tick(16);
+    assert(flow.step == 0);
+
+    AromaEvent* ev = aroma_event_create(EVENT_TYPE_MOUSE_MOVE, root->node_id);
+    aroma_event_dispatch(ev);
+    aroma_event_destroy(ev);
+    aroma_task_tick(32);
+    assert(flow.step == 0);
+
+    ev = aroma_event_create_mouse(EVENT_TYPE_MOUSE_CLICK, root->node_id, 4, 4, 0);
+    aroma_event_dispatch(ev);
+    aroma_event_destroy(ev);
+    aroma_task_tick(48);
+    assert(flow.step == 1);
+    assert(flow.woke_on == EVENT_TYPE_MOUSE_CLICK);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static int g_app_observed = 0;
+
+static void app_observer(const AromaEvent* event) {
+    (void)event;
+    g_app_observed++;
+}
+
+/* The scheduler must neither replace nor clear an observer the app installed. */
+static void test_app_observer_survives_tasks(void) {
+    g_app_observed = 0;
+    __node_system_init();
+    aroma_event_system_init();
+    aroma_event_set_dispatch_observer(app_observer);
+    aroma_idle_init();
+    aroma_asset_init();
+    aroma_task_init();
+
+    AromaNode* root = __create_node(NODE_TYPE_ROOT, NULL, aroma_widget_alloc(32));
+    aroma_event_set_root(root);
+    MockFlow flow = { .node_id = root->node_id };
+    aroma_task_spawn(event_flow, &flow);
+    aroma_task_tick(0);
+
+    AromaEvent* ev = aroma_event_create_mouse(EVENT_TYPE_MOUSE_CLICK, root->node_id, 4, 4, 0);
+    aroma_event_dispatch(ev);
+    aroma_event_destroy(ev);
+    aroma_task_tick(16);
+    assert(flow.step == 1);
+    assert(g_app_observed == 1);
+
+    aroma_task_shutdown();
+    ev = aroma_event_create(EVENT_TYPE_MOUSE_MOVE, root->node_id);
+    aroma_event_dispatch(ev);
+    aroma_event_destroy(ev);
+    assert(g_app_observed == 2);
+
+    aroma_event_set_dispatch_observer(NULL);
+    aroma_asset_shutdown();
+    aroma_idle_shutdown();
+    aroma_event_system_shutdown();
+    __node_system_destroy();
+    tests_passed++;
+}
+
+static void test_async_asset_load(void) {
+    init_test_environment();
+
+    const char* path = "aroma_task_test_asset.bin";
+    FILE* f = fopen(path, "wb");
+    assert(f != NULL);
+    char block[AROMA_ASSET_CHUNK_SIZE];
+    memset(block, 'a', sizeof(block));
+    fwrite(block, 1, sizeof(block), f);
+    fwrite(block, 1, 100, f);
+    fclose(f);
+
+    MockFlow flow = {0};
+    flow.asset = aroma_asset_load_async(path);
+    assert(flow.asset != NULL);
+    assert(aroma_asset_is_pending(flow.asset));
+    aroma_task_spawn(asset_flow, &flow);
+
+    aroma_task_tick(0);
+    assert(flow.step == 0);
+
+    /* No slack: each forced run is a single chunk. */
+    for (int i = 0; i < 64 && aroma_asset_is_pending(flow.asset); i++) {
+        aroma_idle_run(0);
+    }
+    assert(aroma_asset_state(flow.asset) == AROMA_ASSET_READY);
+
+    aroma_task_tick(16);
+    assert(flow.step == 1);
+    assert(flow.asset_size == AROMA_ASSET_CHUNK_SIZE + 100);
+
+    aroma_asset_release(flow.asset);
+    remove(path);
+
+    AromaAsset* missing = aroma_asset_load_async("does/not/exist.bin");
+    assert(aroma_asset_state(missing) == AROMA_ASSET_FAILED);
+    aroma_asset_release(missing);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+static void test_cancel(void) {
+    init_test_environment();
+
+    MockFlow flow = {0};
+    AromaTask* task = aroma_task_spawn(sleep_flow, &flow);
+    aroma_task_set_on_done(task, mark_done);
+    aroma_task_tick(0);
+    aroma_task_cancel(task);
+    aroma_task_tick(1000);
+    assert(flow.step == 1);
+    assert(!flow.done);
+    assert(!aroma_task_next_deadline(NULL));
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+void run_task_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== Task Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_sleep_and_frames();
+    LOG_PERFORMANCE("test_sleep_and_frames");
+
+    LOG_PERFORMANCE(NULL);
+    test_wait_for_event();
+    LOG_PERFORMANCE("test_wait_for_event");
+
+    LOG_PERFORMANCE(NULL);
+    test_app_observer_survives_tasks();
+    LOG_PERFORMANCE("test_app_observer_survives_tasks");
+
+    LOG_PERFORMANCE(NULL);
+    test_async_asset_load();
+    LOG_PERFORMANCE("test_async_asset_load");
+
+    LOG_PERFORMANCE(NULL);
+    test_cancel();
+    LOG_PERFORMANCE("test_cancel");
+
+    printf("\nTask: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_TASK_H
+#define TEST_AROMA_TASK_H
+
+void run_task_tests(int* passed, int* failed);
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "test_aroma_ui.h"
+#include "aroma_ui.h"
+#include "widgets/aroma_divider.h"
+#include "widgets/aroma_textbox.h"
+#include "widgets/aroma_button.h"
+#include "core/aroma_timer.h"
+#include "backends/aroma_abi.h"
+#include "backends/platforms/aroma_platform_interface.h"
+#include <stdio.h>
+#include <assert.h>
+
+#define UI_TEST_WINDOW_ID 7
+#define UI_STEADY_FRAMES 200
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#ifdef AROMA_TEST_HEAP_HOOK
+/* The test build links with -Wl,--wrap for these, so a test can count the
+   heap calls a code path makes on its own thread. */
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static _Thread_local bool t_count_heap = false;
+static size_t g_heap_calls = 0;
+
+void* __wrap_malloc(size_t size) {
+    if (t_count_heap) g_heap_calls++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    if (t_count_heap) g_heap_calls++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    if (t_count_heap) g_heap_calls++;
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    if (t_count_heap && ptr) g_heap_calls++;
+    __real_free(ptr);
+}
+#endif
+
+/* The examples' fonts; without one the textbox skips its measured text. */
+static const char* const g_test_fonts[] = {
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+    "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+    "/usr/share/fonts/truetype/ubuntu/Ubuntu-R.ttf",
+};
+
+/* A headless platform: one fixed-size window whose updates the test drives. */
+static void (*g_update_callback)(size_t window_id, void* data) = NULL;
+
+static size_t fake_create_window(const char* title, int x, int y, int width, int height) {
+    (void)title; (void)x; (void)y; (void)width; (void)height;
+    return UI_TEST_WINDOW_ID;
+}
+
+static void fake_set_update_callback(void (*callback)(size_t window_id, void* data), void* data) {
+    (void)data;
+    g_update_callback = callback;
+}
+
+static void fake_get_window_size(size_t window_id, int* width, int* height) {
+    (void)window_id;
+    if (width) *width = 320;
+    if (height) *height = 240;
+}
+
+static AromaPlatformInterface g_fake_platform = {
+    .create_window = fake_create_window,
+    .set_window_update_callback = fake_set_update_callback,
+    .get_window_size = fake_get_window_size,
+};
+
+static AromaPlatformInterface* fake_platform(void) {
+    return &g_fake_platform;
+}
+
+static AromaPlatformInterface* (*g_saved_platform)(void) = NULL;
+static AromaWindow* g_window = NULL;
+
+static void init_test_environment(void) {
+    g_saved_platform = aroma_backend_abi.get_platform_interface;
+    aroma_backend_abi.get_platform_interface = fake_platform;
+    bool ready = aroma_ui_init();
+    assert(ready);
+    g_window = aroma_ui_create_window("test", 320, 240);
+    assert(g_window && g_update_callback);
+    aroma_divider_create((AromaNode*)g_window, 10, 100, 300, DIVIDER_ORIENTATION_HORIZONTAL);
+}
+
+static void cleanup_test_environment(void) {
+    aroma_ui_destroy_window(g_window);
+    aroma_ui_shutdown();
+    aroma_backend_abi.get_platform_interface = g_saved_platform;
+    g_window = NULL;
+    g_update_callback = NULL;
+}
+
+/* The platform callback opens the frame itself, as the TFT loop does. */
+static void test_unchanged_frame_is_skipped(void) {
+    init_test_environment();
+    g_update_callback(UI_TEST_WINDOW_ID, NULL);
+    AromaFrameStats before = aroma_ui_get_frame_stats();
+
+    for (int i = 0; i < 2; i++) {
+        aroma_node_invalidate((AromaNode*)g_window);
+        g_update_callback(UI_TEST_WINDOW_ID, NULL);
+    }
+
+    AromaFrameStats after = aroma_ui_get_frame_stats();
+    assert(after.frames_presented - before.frames_presented == 1);
+    assert(after.frames_skipped - before.frames_skipped == 1);
+    assert(aroma_ui_frame_was_skipped(UI_TEST_WINDOW_ID));
+
+    /* Only the end_frame that matches a begin_frame presents. */
+    bool presented = aroma_ui_end_frame(UI_TEST_WINDOW_ID);
+    assert(!presented);
+    assert(aroma_ui_get_frame_stats().frames_presented == after.frames_presented);
+
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+/* Focusing a textbox in a window without focus must not start the blink. */
+static void test_caret_sleeps_in_unfocused_window(void) {
+    init_test_environment();
+    AromaNode* textbox = aroma_textbox_create((AromaNode*)g_window, 10, 10, 200, 30);
+    assert(textbox);
+
+    aroma_ui_set_window_focused(UI_TEST_WINDOW_ID, false);
+    assert(!aroma_ui_is_node_window_focused(textbox));
+    aroma_textbox_set_focused(textbox, true);
+    aroma_timer_tick(1000);
+    assert(!aroma_timer_next_deadline(NULL));
+
+    aroma_ui_set_window_focused(UI_TEST_WINDOW_ID, true);
+    aroma_timer_tick(2000);
+    assert(aroma_timer_next_deadline(NULL));
+
+    aroma_textbox_set_focused(textbox, false);
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+/* Editing another textbox must not wake the focused caret once it has gone solid. */
+static void test_caret_ignores_other_textboxes(void) {
+    init_test_environment();
+    AromaNode* focused = aroma_textbox_create((AromaNode*)g_window, 10, 10, 200, 30);
+    AromaNode* other = aroma_textbox_create((AromaNode*)g_window, 10, 50, 200, 30);
+    assert(focused && other);
+
+    aroma_ui_set_window_focused(UI_TEST_WINDOW_ID, true);
+    aroma_textbox_set_focused(focused, true);
+    uint64_t now = 1000;
+    for (int i = 0; i < AROMA_TEXTBOX_CURSOR_BLINK_TIMEOUT / AROMA_TEXTBOX_CURSOR_BLINK_RATE + 2; i++) {
+        aroma_timer_tick(now);
+        now += AROMA_TEXTBOX_CURSOR_BLINK_RATE;
+    }
+    assert(!aroma_timer_next_deadline(NULL));
+
+    aroma_textbox_set_text(other, "updated elsewhere");
+    aroma_timer_tick(now);
+    assert(!aroma_timer_next_deadline(NULL));
+
+    aroma_textbox_set_text(focused, "typed here");
+    aroma_timer_tick(now);
+    assert(aroma_timer_next_deadline(NULL));
+
+    aroma_textbox_set_focused(focused, false);
+    cleanup_test_environment();
+    tests_passed++;
+}
+
+/* Once warm, a frame records into the window's list and arena and presents
+   without a single malloc or free, caret prefix measuring included. */
+static void test_steady_state_frame_has_no_heap_traffic(void) {
+    init_test_environment();
+    AromaFont* font = NULL;
+    for (size_t i = 0; i < sizeof(g_test_fonts) / sizeof(g_test_fonts[0]) && !font; i++) {
+        font = aroma_font_create(g_test_fonts[i], 14);
+    }
+    if (!font) printf("  no system font found; the textbox draws without text\n");
+
+    AromaNode* textbox = aroma_textbox_create((AromaNode*)g_window, 10, 10, 200, 30);
+    AromaNode* button = aroma_button_create((AromaNode*)g_window, "Apply", 10, 150, 100, 32);
+    assert(textbox && button);
+    aroma_textbox_set_font(textbox, font);
+    aroma_button_set_font(button, font);
+    aroma_textbox_set_text(textbox, "Steady state");
+    aroma_ui_set_window_focused(UI_TEST_WINDOW_ID, true);
+    aroma_textbox_set_focused(textbox, true);
+
+    AromaFrameStats before = aroma_ui_get_frame_stats();
+    for (int frame = 0; frame < 2 + UI_STEADY_FRAMES; frame++) {
+#ifdef AROMA_TEST_HEAP_HOOK
+        if (frame == 2) t_count_heap = true;
+#endif
+        aroma_ui_force_present(UI_TEST_WINDOW_ID);
+        aroma_node_invalidate(textbox);
+        aroma_node_invalidate(button);
+        AromaDrawList* list = aroma_ui_begin_frame(UI_TEST_WINDOW_ID);
+        assert(list);
+        aroma_ui_render_dirty_window(UI_TEST_WINDOW_ID, 0xFFFFFF);
+        bool presented = aroma_ui_end_frame(UI_TEST_WINDOW_ID);
+        assert(presented);
+    }
+#ifdef AROMA_TEST_HEAP_HOOK
+    t_count_heap = false;
+    assert(g_heap_calls == 0);
+#endif
+    AromaFrameStats after = aroma_ui_get_frame_stats();
+    assert(after.frames_presented - before.frames_presented == 2 + UI_STEADY_FRAMES);
+
+    aroma_textbox_set_focused(textbox, false);
+    cleanup_test_environment();
+    aroma_font_destroy(font);
+    tests_passed++;
+}
+
+void run_ui_tests(int* passed, int* failed) {
+    tests_passed = 0;
+    tests_failed = 0;
+    set_minimum_log_level(DEBUG_LEVEL_CRITICAL);
+
+    printf("=== UI Tests ===\n");
+
+    LOG_PERFORMANCE(NULL);
+    test_unchanged_frame_is_skipped();
+    LOG_PERFORMANCE("test_unchanged_frame_is_skipped");
+
+    LOG_PERFORMANCE(NULL);
+    test_caret_sleeps_in_unfocused_window();
+    LOG_PERFORMANCE("test_caret_sleeps_in_unfocused_window");
+
+    LOG_PERFORMANCE(NULL);
+    test_caret_ignores_other_textboxes();
+    LOG_PERFORMANCE("test_caret_ignores_other_textboxes");
+
+    LOG_PERFORMANCE(NULL);
+    test_steady_state_frame_has_no_heap_traffic();
+    LOG_PERFORMANCE("test_steady_state_frame_has_no_heap_traffic");
+
+    printf("\nUI: %d passed, %d failed\n\n", tests_passed, tests_failed);
+
+    if (passed) *passed = tests_passed;
+    if (failed) *failed = tests_failed;
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_AROMA_UI_H
+#define TEST_AROMA_UI_H
+
+void run_ui_tests(int* passed, int* failed);
+
+#endif
@@ -22,6 +22,16 @@
 #include "test_aroma_slab_alloc.h"
 #include "test_aroma_node.h"
 #include "test_aroma_event_system.h"
+#include "test_aroma_animation.h"
+#include "test_aroma_idle.h"
+#include "test_aroma_task.h"
+#include "test_aroma_post.h"
+#include "test_aroma_frame_arena.h"
+#include "test_aroma_alloc_profile.h"
+#include "test_aroma_string.h"
+#include "test_aroma_memory.h"
+#include "test_aroma_drawlist.h"
+#include "test_aroma_ui.h"
 #include <stdio.h>
 
 int main(void) {
@@ -29,6 +39,16 @@ int main(void) {
     int slab_passed, slab_failed;
     int node_passed, node_failed;
     int event_passed, event_failed;
+    int anim_passed, anim_failed;
+    int idle_passed, idle_failed;
+    int task_passed, task_failed;
+    int post_passed, post_failed;
+    int arena_passed, arena_failed;
+    int profile_passed, profile_failed;
+    int string_passed, string_failed;
+    int report_passed, report_failed;
+    int drawlist_passed, drawlist_failed;
+    int ui_passed, ui_failed;
     
     run_slab_allocator_tests(&slab_passed, &slab_failed);
     
@@ -36,13 +56,41 @@ int main(void) {
     
     run_event_tests(&event_passed, &event_failed);
     
-    int total_passed = slab_passed + node_passed + event_passed;
-    int total_failed = slab_failed + node_failed + event_failed;
+    run_animation_tests(&anim_passed, &anim_failed);
+    
+    run_idle_tests(&idle_passed, &idle_failed);
+    
+    run_task_tests(&task_passed, &task_failed);
+    
+    run_post_tests(&post_passed, &post_failed);
+    
+    run_frame_arena_tests(&arena_passed, &arena_failed);
+    
+    run_alloc_profile_tests(&profile_passed, &profile_failed);
+    
+    run_string_tests(&string_passed, &string_failed);
+    
+    run_memory_report_tests(&report_passed, &report_failed);
+    run_drawlist_tests(&drawlist_passed, &drawlist_failed);
+    run_ui_tests(&ui_passed, &ui_failed);
+    
+    int total_passed = slab_passed + node_passed + event_passed + anim_passed + idle_passed + task_passed + post_passed + arena_passed + profile_passed + string_passed + report_passed + drawlist_passed + ui_passed;
+    int total_failed = slab_failed + node_failed + event_failed + anim_failed + idle_failed + task_failed + post_failed + arena_failed + profile_failed + string_failed + report_failed + drawlist_failed + ui_failed;
     
     printf("\n=== Summary ===\n");
     printf("Slab Allocator: %d passed, %d failed\n", slab_passed, slab_failed);
     printf("Node System:    %d passed, %d failed\n", node_passed, node_failed);
     printf("Event System:   %d passed, %d failed\n", event_passed, event_failed);
+    printf("Animation:      %d passed, %d failed\n", anim_passed, anim_failed);
+    printf("Idle Scheduler: %d passed, %d failed\n", idle_passed, idle_failed);
+    printf("Task:           %d passed, %d failed\n", task_passed, task_failed);
+    printf("Post Queue:     %d passed, %d failed\n", post_passed, post_failed);
+    printf("Frame Arena:    %d passed, %d failed\n", arena_passed, arena_failed);
+    printf("Alloc Profiler: %d passed, %d failed\n", profile_passed, profile_failed);
+    printf("String Pool:    %d passed, %d failed\n", string_passed, string_failed);
+    printf("Memory Report:  %d passed, %d failed\n", report_passed, report_failed);
+    printf("Draw List:      %d passed, %d failed\n", drawlist_passed, drawlist_failed);
+    printf("UI:             %d passed, %d failed\n", ui_passed, ui_failed);
     printf("Total:          %d passed, %d failed\n", total_passed, total_failed);
     
     if (total_failed == 0) {
@@ -0,0 +1,344 @@
+/*
+ Copyright (c) 2026 BinaryInkTN
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of
+ this software and associated documentation files (the "Software"), to deal in
+ the Software without restriction, including without limitation the rights to
+ use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Replays a drawlist capture (see aroma_ui_capture_frames) against a
+ * graphics backend and reports where the time went per command type.
+ *
+ *   aroma_drawlist_replay <capture> [-n iterations] [--null] [--batch] [--cull]
+ *                         [--font path] [--font-size px] [--image path]
+ *
+ * --null replays into a backend that draws nothing, which isolates the
+ * drawlist's own decode and dispatch cost. Otherwise the capture is drawn
+ * into a GLES3 window of the captured size. Captured fonts and textures are
+ * replaced by --font and --image, since their handles died with the app.
+ * --cull runs the occlusion pass once before replaying, as the UI does.
+ */
+
+#include "aroma_ui.h"
+#include "aroma_drawlist.h"
+#include "aroma_font.h"
+#include "backends/aroma_abi.h"
+#include "backends/graphics/aroma_graphics_interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum ReplayBucket {
+    REPLAY_CLEAR,
+    REPLAY_FILL_RECT,
+    REPLAY_HOLLOW_RECT,
+    REPLAY_RECT_BATCH,
+    REPLAY_ARC,
+    REPLAY_TEXT,
+    REPLAY_IMAGE,
+    REPLAY_CLIP,
+    REPLAY_PRESENT,
+    REPLAY_BUCKET_COUNT
+} ReplayBucket;
+
+static const char* g_bucket_names[REPLAY_BUCKET_COUNT] = {
+    "clear", "fill_rect", "hollow_rect", "rect_batch", "arc", "text", "image", "clip", "present"
+};
+
+typedef struct ReplayTiming {
+    uint64_t calls;
+    uint64_t items;
+    uint64_t ns;
+} ReplayTiming;
+
+static AromaGraphicsInterface* g_target = NULL;
+static ReplayTiming g_timings[REPLAY_BUCKET_COUNT];
+static AromaFont* g_font = NULL;
+static unsigned int g_image = 0;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+#define TIMED(bucket, count, call)                  \
+    do {                                            \
+        uint64_t start_ = now_ns();                 \
+        call;                                       \
+        g_timings[bucket].ns += now_ns() - start_;  \
+        g_timings[bucket].calls++;                  \
+        g_timings[bucket].items += (count);         \
+    } while (0)
+
+static void timed_clear(size_t window_id, uint32_t color) {
+    if (g_target->clear) TIMED(REPLAY_CLEAR, 1, g_target->clear(window_id, color));
+}
+
+static void timed_fill(size_t window_id, int x, int y, int w, int h, uint32_t color, bool rounded, float radius) {
+    if (g_target->fill_rectangle) {
+        TIMED(REPLAY_FILL_RECT, 1, g_target->fill_rectangle(window_id, x, y, w, h, color, rounded, radius));
+    }
+}
+
+static void timed_hollow(size_t window_id, int x, int y, int w, int h, uint32_t color, int border,
+                         bool rounded, float radius) {
+    if (g_target->draw_hollow_rectangle) {
+        TIMED(REPLAY_HOLLOW_RECT, 1,
+              g_target->draw_hollow_rectangle(window_id, x, y, w, h, color, border, rounded, radius));
+    }
+}
+
+static void timed_rects(size_t window_id, const AromaRectBatchItem* rects, size_t count) {
+    if (g_target->draw_rectangles) {
+        TIMED(REPLAY_RECT_BATCH, count, g_target->draw_rectangles(window_id, rects, count));
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const AromaRectBatchItem* r = &rects[i];
+        if (r->border_width > 0) {
+            timed_hollow(window_id, r->x, r->y, r->width, r->height, r->color, r->border_width,
+                         r->is_rounded, r->corner_radius);
+        } else {
+            timed_fill(window_id, r->x, r->y, r->width, r->height, r->color, r->is_rounded, r->corner_radius);
+        }
+    }
+}
+
+static void timed_arc(size_t window_id, int cx, int cy, int radius, float start, float end, uint32_t color,
+                      int thickness) {
+    if (g_target->draw_arc) {
+        TIMED(REPLAY_ARC, 1, g_target->draw_arc(window_id, cx, cy, radius, start, end, color, thickness));
+    }
+}
+
+static void timed_text(size_t window_id, AromaFont* font, const char* text, int x, int y, uint32_t color,
+                       float scale) {
+    if (g_target->render_text) {
+        TIMED(REPLAY_TEXT, 1, g_target->render_text(window_id, font, text, x, y, color, scale));
+    }
+}
+
+static float timed_measure(size_t window_id, AromaFont* font, const char* text, float scale) {
+    return g_target->measure_text ? g_target->measure_text(window_id, font, text, scale) : 0.0f;
+}
+
+static void timed_image(size_t window_id, int x, int y, int w, int h, unsigned int texture_id) {
+    if (g_target->draw_image) TIMED(REPLAY_IMAGE, 1, g_target->draw_image(window_id, x, y, w, h, texture_id));
+}
+
+static void timed_set_clip(size_t window_id, int x, int y, int w, int h) {
+    if (g_target->set_draw_clip) TIMED(REPLAY_CLIP, 1, g_target->set_draw_clip(window_id, x, y, w, h));
+}
+
+static void timed_clear_clip(size_t window_id) {
+    if (g_target->clear_draw_clip) TIMED(REPLAY_CLIP, 1, g_target->clear_draw_clip(window_id));
+}
+
+static AromaGraphicsInterface g_timed = {
+    .clear = timed_clear,
+    .fill_rectangle = timed_fill,
+    .draw_hollow_rectangle = timed_hollow,
+    .draw_rectangles = timed_rects,
+    .draw_arc = timed_arc,
+    .render_text = timed_text,
+    .measure_text = timed_measure,
+    .draw_image = timed_image,
+    .set_draw_clip = timed_set_clip,
+    .clear_draw_clip = timed_clear_clip,
+};
+
+/* Draws nothing; text is measured at a fixed advance so culling still works. */
+static void null_clear(size_t window_id, uint32_t color) { (void)window_id; (void)color; }
+static void null_fill(size_t window_id, int x, int y, int w, int h, uint32_t color, bool rounded, float radius) {
+    (void)window_id; (void)x; (void)y; (void)w; (void)h; (void)color; (void)rounded; (void)radius;
+}
+static void null_hollow(size_t window_id, int x, int y, int w, int h, uint32_t color, int border, bool rounded,
+                        float radius) {
+    (void)window_id; (void)x; (void)y; (void)w; (void)h; (void)color; (void)border; (void)rounded; (void)radius;
+}
+static void null_arc(size_t window_id, int cx, int cy, int radius, float start, float end, uint32_t color,
+                     int thickness) {
+    (void)window_id; (void)cx; (void)cy; (void)radius; (void)start; (void)end; (void)color; (void)thickness;
+}
+static void null_text(size_t window_id, AromaFont* font, const char* text, int x, int y, uint32_t color,
+                      float scale) {
+    (void)window_id; (void)font; (void)text; (void)x; (void)y; (void)color; (void)scale;
+}
+static float null_measure(size_t window_id, AromaFont* font, const char* text, float scale) {
+    (void)window_id; (void)font;
+    return (float)strlen(text) * 8.0f * scale;
+}
+static void null_image(size_t window_id, int x, int y, int w, int h, unsigned int texture_id) {
+    (void)window_id; (void)x; (void)y; (void)w; (void)h; (void)texture_id;
+}
+
+static void null_set_clip(size_t window_id, int x, int y, int w, int h) {
+    (void)window_id; (void)x; (void)y; (void)w; (void)h;
+}
+static void null_clear_clip(size_t window_id) { (void)window_id; }
+
+static AromaGraphicsInterface g_null = {
+    .clear = null_clear,
+    .fill_rectangle = null_fill,
+    .draw_hollow_rectangle = null_hollow,
+    .draw_arc = null_arc,
+    .render_text = null_text,
+    .measure_text = null_measure,
+    .draw_image = null_image,
+    .set_draw_clip = null_set_clip,
+    .clear_draw_clip = null_clear_clip,
+};
+
+static AromaFont* map_font(const AromaDrawCaptureFont* font, void* user_data) {
+    (void)font; (void)user_data;
+    return g_font;
+}
+
+static unsigned int map_texture(const AromaDrawCaptureTexture* texture, void* user_data) {
+    (void)user_data;
+    return g_image ? g_image : texture->texture_id;
+}
+
+/* Cost of one TIMED wrapper around nothing, taken off every call. */
+static uint64_t timer_overhead_ns(void) {
+    enum { SAMPLES = 10000 };
+    uint64_t start = now_ns();
+    for (int i = 0; i < SAMPLES; i++) {
+        uint64_t inner = now_ns();
+        (void)(now_ns() - inner);
+    }
+    return (now_ns() - start) / SAMPLES;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s <capture> [-n iterations] [--null] [--batch] [--cull] [--font path] "
+                    "[--font-size px] [--image path]\n", program);
+}
+
+int main(int argc, char** argv) {
+    const char* capture = NULL;
+    const char* font_path = NULL;
+    const char* image_path = NULL;
+    int font_size = 14;
+    long iterations = 100;
+    bool null_backend = false;
+    bool batching = false;
+    bool culling = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) iterations = strtol(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--null") == 0) null_backend = true;
+        else if (strcmp(argv[i], "--batch") == 0) batching = true;
+        else if (strcmp(argv[i], "--cull") == 0) culling = true;
+        else if (strcmp(argv[i], "--font") == 0 && i + 1 < argc) font_path = argv[++i];
+        else if (strcmp(argv[i], "--font-size") == 0 && i + 1 < argc) font_size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--image") == 0 && i + 1 < argc) image_path = argv[++i];
+        else if (argv[i][0] != '-' && !capture) capture = argv[i];
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!capture || iterations <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    /* Peek at the header for the surface size before any window exists. */
+    AromaDrawCaptureInfo info;
+    AromaDrawCaptureOptions probe_options = { NULL, NULL, NULL, &g_null, 0 };
+    AromaDrawList* probe = aroma_drawlist_load(capture, &probe_options, &info);
+    if (!probe) return 1;
+    aroma_drawlist_destroy(probe);
+
+    AromaWindow* window = NULL;
+    size_t window_id = 0;
+    if (null_backend) {
+        g_target = &g_null;
+    } else {
+        if (!aroma_ui_init()) return 1;
+        window = aroma_ui_create_window("Drawlist replay", info.surface_width > 0 ? info.surface_width : 800,
+                                        info.surface_height > 0 ? info.surface_height : 600);
+        if (!window) {
+            aroma_ui_shutdown();
+            return 1;
+        }
+        for (int i = 0; i < g_window_count; i++) {
+            if (g_windows[i].window == window) window_id = g_windows[i].window_id;
+        }
+        g_target = aroma_backend_abi.get_graphics_interface();
+        if (font_path) {
+            g_font = aroma_font_create(font_path, font_size);
+            aroma_ui_prepare_font_for_window(window_id, g_font);
+        }
+        if (image_path && g_target->load_image) g_image = g_target->load_image(image_path);
+    }
+    if (info.font_count && !g_font && !null_backend) {
+        fprintf(stderr, "warning: capture uses %u font(s); pass --font to draw its text\n",
+                (unsigned)info.font_count);
+    }
+
+    /* Text bounds are measured while the capture is re-recorded, so the
+       measuring backend has to be known before loading. */
+    AromaDrawCaptureOptions options = { map_font, map_texture, NULL, g_target, window_id };
+    AromaDrawList* list = aroma_drawlist_load(capture, &options, NULL);
+    if (!list) return 1;
+    aroma_drawlist_set_batching(list, batching);
+    if (culling) aroma_drawlist_cull_occluded(list, info.surface_width, info.surface_height);
+
+    uint64_t start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        aroma_drawlist_replay(list, window_id, &g_timed);
+        if (window) TIMED(REPLAY_PRESENT, 1, aroma_graphics_swap_buffers(window_id));
+    }
+    uint64_t total = now_ns() - start;
+    uint64_t overhead = timer_overhead_ns();
+
+    printf("%s: v%u, %dx%d, %u commands, %u fonts, %u textures\n", capture, (unsigned)info.version,
+           info.surface_width, info.surface_height, (unsigned)info.command_count, (unsigned)info.font_count,
+           (unsigned)info.texture_count);
+    if (culling) {
+        AromaDrawListStats stats = aroma_drawlist_get_stats(list);
+        printf("occlusion dropped %zu commands, %zu of %zu px painted\n", stats.occluded,
+               stats.occluded_pixels, stats.occluded_pixels + stats.painted_pixels);
+    }
+    printf("%ld iterations on %s%s%s: %.3f ms/frame\n\n", iterations, null_backend ? "null backend" : "gles3",
+           batching ? " with batching" : "", culling ? " after culling" : "",
+           (double)total / (double)iterations / 1e6);
+    printf("%-12s %10s %10s %12s %10s\n", "type", "calls", "items", "us/frame", "ns/item");
+    for (int b = 0; b < REPLAY_BUCKET_COUNT; b++) {
+        const ReplayTiming* t = &g_timings[b];
+        if (t->calls == 0) continue;
+        uint64_t timer = t->calls * overhead;
+        double ns = t->ns > timer ? (double)(t->ns - timer) : 0.0;
+        printf("%-12s %10llu %10llu %12.2f %10.1f\n", g_bucket_names[b],
+               (unsigned long long)(t->calls / (uint64_t)iterations),
+               (unsigned long long)(t->items / (uint64_t)iterations),
+               ns / (double)iterations / 1e3, ns / (double)t->items);
+    }
+    printf("\n(timer overhead of %llu ns per call removed)\n", (unsigned long long)overhead);
+
+    aroma_drawlist_destroy(list);
+    if (window) {
+        aroma_ui_destroy_window(window);
+        if (g_font) aroma_ui_unload_font(g_font);
+        aroma_ui_shutdown();
+    }
+    return 0;
+}